@@ -2649,6 +2649,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 struct k_work;
 struct k_work_q;
+struct k_work_q_worker;
 struct k_work_queue_config;
 struct k_delayed_work;
 extern struct k_work_q k_sys_work_q;
@@ -2945,6 +2946,22 @@ __syscall int k_sem_take(struct k_sem *sem, k_timeout_t timeout);
  */
 __syscall void k_sem_give(struct k_sem *sem);
 
+/**
+ * @brief Give a semaphore multiple times.
+ *
+ * This routine is equivalent to calling k_sem_give() @a count times, but
+ * all threads it wakes are made ready in a single batch with at most one
+ * reschedule. Up to @a count waiting threads are woken in priority order;
+ * the remainder, if any, is added to the semaphore count, which is still
+ * capped at its maximum permitted count.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param sem Address of the semaphore.
+ * @param count Number of times to give the semaphore.
+ */
+__syscall void k_sem_give_n(struct k_sem *sem, unsigned int count);
+
 /**
  * @brief Resets a semaphore's count to zero.
  *
@@ -3214,6 +3231,42 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Add a worker thread to a work queue.
+ *
+ * This turns a started work queue into a pool: the new thread takes work
+ * items from the same pending list as the queue's own thread, so items
+ * submitted to the queue are processed by whichever thread is idle.  A work
+ * item is still never run by two threads at once: an item resubmitted while
+ * it is running is left pending until its handler returns.  Flushing a work
+ * item on a queue with added workers waits until the item is neither queued
+ * nor running.
+ *
+ * Workers cannot be removed once added.
+ *
+ * @note Requires CONFIG_WORKQUEUE_POOL.
+ *
+ * @param queue pointer to a started work queue.
+ *
+ * @param worker pointer to the worker state, which must persist for the
+ *        lifetime of the queue.
+ *
+ * @param stack pointer to the worker thread stack area.
+ *
+ * @param stack_size size of the the worker thread stack area, in bytes.
+ *
+ * @param prio initial thread priority
+ *
+ * @param cpu CPU the worker is pinned to, or -1 to let it run on any CPU.
+ *
+ * @retval 0 if the worker was added
+ * @retval -ENOTSUP if @p cpu is not -1 and CONFIG_SCHED_CPU_MASK is disabled
+ * @retval -EINVAL if @p cpu is not a valid CPU
+ */
+int k_work_queue_worker_add(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack, size_t stack_size,
+			    int prio, int cpu);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
@@ -3690,6 +3743,9 @@ struct k_work_delayable {
 struct z_work_flusher {
 	struct k_work work;
 	struct k_sem sem;
+#ifdef CONFIG_WORKQUEUE_POOL
+	struct k_work *target;
+#endif
 };
 
 /* Record used to wait for work to complete a cancellation.
@@ -3776,6 +3832,26 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Additional threads added with k_work_queue_worker_add(). */
+	sys_slist_t workers;
+
+	/* Number of work items being run by the queue's threads. */
+	uint32_t active;
+#endif
+};
+
+/** @brief An additional thread of a work queue pool.
+ *
+ * See k_work_queue_worker_add().
+ */
+struct k_work_q_worker {
+	/* The thread that animates the work. */
+	struct k_thread thread;
+
+	/* Node in the owning queue's list of workers. */
+	sys_snode_t node;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4293,6 +4369,19 @@ struct k_msgq {
 	/** Number of used messages */
 	uint32_t used_msgs;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	/** Per-slot sequence numbers, NULL if the queue uses the lock */
+	atomic_t *seq;
+	/** Ring position of the next message to write */
+	atomic_t tail;
+	/** Ring position of the next message to read */
+	atomic_t head;
+	/** Number of threads blocked on the queue */
+	atomic_t waiters;
+	/** Writers blocked on a full ring, readers use wait_q */
+	_wait_q_t put_wait_q;
+#endif
+
 	_POLL_EVENT;
 
 	/** Message queue */
@@ -4315,9 +4404,31 @@ struct k_msgq {
 	.read_ptr = q_buffer, \
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
+	Z_MSGQ_SEQ_INIT(obj, q_max_msgs) \
 	_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+/* The lockless ring indexes slots with a mask, so only power of two
+ * sized queues get one.  Sequence numbers are stored relative to the
+ * slot index, so a zeroed array is a valid empty ring.  Other queues
+ * use the lock and get an empty array.
+ */
+#define Z_MSGQ_LOCKLESS(q_max_msgs) \
+	(((q_max_msgs) != 0U) && (((q_max_msgs) & ((q_max_msgs) - 1U)) == 0U))
+
+#define Z_MSGQ_SEQ_DEFINE(q_name, q_max_msgs) \
+	static atomic_t _k_msgq_seq_##q_name[Z_MSGQ_LOCKLESS(q_max_msgs) ? \
+					     (q_max_msgs) : 0];
+
+#define Z_MSGQ_SEQ_INIT(q_name, q_max_msgs) \
+	.seq = Z_MSGQ_LOCKLESS(q_max_msgs) ? _k_msgq_seq_##q_name : NULL, \
+	.put_wait_q = Z_WAIT_Q_INIT(&q_name.put_wait_q),
+#else
+#define Z_MSGQ_SEQ_DEFINE(q_name, q_max_msgs)
+#define Z_MSGQ_SEQ_INIT(q_name, q_max_msgs)
+#endif
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -4361,6 +4472,7 @@ struct k_msgq_attrs {
 #define K_MSGQ_DEFINE(q_name, q_msg_size, q_max_msgs, q_align)		\
 	static char __noinit __aligned(q_align)				\
 		_k_fifo_buf_##q_name[(q_max_msgs) * (q_msg_size)];	\
+	Z_MSGQ_SEQ_DEFINE(q_name, q_max_msgs)				\
 	STRUCT_SECTION_ITERABLE(k_msgq, q_name) =			\
 	       Z_MSGQ_INITIALIZER(q_name, _k_fifo_buf_##q_name,	\
 				  q_msg_size, q_max_msgs)
@@ -4514,9 +4626,11 @@ __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 				 struct k_msgq_attrs *attrs);
 
 
+static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq);
+
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - z_impl_k_msgq_num_used_get(msgq);
 }
 
 /**
@@ -4532,6 +4646,15 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (msgq->seq != NULL) {
+		/* Snapshot only: read head first so tail can't be behind */
+		atomic_val_t head = atomic_get(&msgq->head);
+		uint32_t used = (uint32_t)(atomic_get(&msgq->tail) - head);
+
+		return MIN(used, msgq->max_msgs);
+	}
+#endif
 	return msgq->used_msgs;
 }
 
@@ -4902,6 +5025,16 @@ __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+struct k_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	void *blocks[CONFIG_MEM_SLAB_CPU_CACHE_SIZE];
+	uint32_t count;
+	uint32_t hits;
+	uint32_t misses;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4909,10 +5042,14 @@ struct k_mem_slab {
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+	/* blocks not on free_list, including those in CPU caches */
 	uint32_t num_used;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct k_mem_slab_cpu_cache cpu_cache[CONFIG_MP_NUM_CPUS];
+#endif
 
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mem_slab)
 };
@@ -5053,6 +5190,22 @@ extern int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
 
+/** @cond INTERNAL_HIDDEN */
+static inline uint32_t z_mem_slab_num_cached(struct k_mem_slab *slab)
+{
+	uint32_t cached = 0U;
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cached += slab->cpu_cache[i].count;
+	}
+#else
+	ARG_UNUSED(slab);
+#endif
+	return cached;
+}
+/** @endcond */
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5065,7 +5218,7 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
-	return slab->num_used;
+	return slab->num_used - z_mem_slab_num_cached(slab);
 }
 
 /**
@@ -5100,9 +5253,33 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
+#if defined(CONFIG_MEM_SLAB_CPU_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Memory slab per-CPU cache statistics
+ */
+struct k_mem_slab_cache_stats {
+	/** Allocations and frees served by a CPU cache alone */
+	uint32_t hits;
+	/** Allocations and frees that went to the shared free list */
+	uint32_t misses;
+};
+
+/**
+ * @brief Get the per-CPU cache statistics of a memory slab.
+ *
+ * Sums up the cache hit and miss counts of all CPUs for @a slab.
+ * Only available with CONFIG_MEM_SLAB_CPU_CACHE.
+ *
+ * @param slab Address of the memory slab.
+ * @param stats Structure to fill in.
+ */
+extern void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				       struct k_mem_slab_cache_stats *stats);
+#endif
+
 /** @} */
 
 /**
@@ -5629,6 +5806,155 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* One registration slot of a poll set */
+struct z_poll_set_entry {
+	struct k_poll_event event;
+	sys_dnode_t ready_node;
+	bool edge;
+};
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Persistent set of poll events
+ *
+ * Unlike the event array passed to k_poll(), objects added to a poll set
+ * stay registered across waits, and a wait only looks at the objects that
+ * were signaled since the previous one.  See k_poll_set_add() and
+ * k_poll_set_wait().
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poll_set_entry *entries;
+
+	/** PRIVATE - DO NOT TOUCH */
+	uint16_t num_entries;
+
+	/** PRIVATE - DO NOT TOUCH */
+	uint16_t num_used;
+};
+
+/**
+ * @brief Edge triggered poll set registration.
+ *
+ * OR'ed into the type passed to k_poll_set_add() to report the object once
+ * per signal instead of for as long as it is available.
+ */
+#define K_POLL_SET_EDGE BIT(31)
+
+/**
+ * @brief Statically define and initialize a poll set.
+ *
+ * The poll set can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_poll_set <name>; @endcode
+ *
+ * @param name Name of the poll set.
+ * @param max_events Maximum number of objects in the set.
+ */
+#define K_POLL_SET_DEFINE(name, max_events) \
+	static struct z_poll_set_entry _k_poll_set_entries_##name[max_events]; \
+	STRUCT_SECTION_ITERABLE(k_poll_set, name) = { \
+		.wait_q = Z_WAIT_Q_INIT(&name.wait_q), \
+		.ready = SYS_DLIST_STATIC_INIT(&name.ready), \
+		.entries = _k_poll_set_entries_##name, \
+		.num_entries = max_events, \
+	}
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @note Requires CONFIG_POLL_SET.  Poll sets used from user mode must be
+ * defined with K_POLL_SET_DEFINE().
+ *
+ * @param set The poll set.
+ * @param entries Storage for the set's registrations, which must persist for
+ *        the lifetime of the set.
+ * @param max_events Number of elements in @a entries.
+ */
+void k_poll_set_init(struct k_poll_set *set,
+		     struct z_poll_set_entry *entries, uint16_t max_events);
+
+/**
+ * @brief Add an object to a poll set.
+ *
+ * The object stays registered until it is removed with k_poll_set_remove().
+ * An object must not be added to a set twice, and must be removed from all
+ * sets before it is destroyed.
+ *
+ * @note Requires CONFIG_POLL_SET.
+ *
+ * @param set The poll set.
+ * @param type One of the K_POLL_TYPE_xxx values, except K_POLL_TYPE_IGNORE,
+ *        optionally OR'ed with K_POLL_SET_EDGE.
+ * @param obj Kernel object or poll signal.
+ * @param tag User tag, reported back by k_poll_set_wait().
+ *
+ * @retval 0 The object was added.
+ * @retval -ENOMEM The set is full.
+ * @retval -EINVAL Bad parameters.
+ */
+__syscall int k_poll_set_add(struct k_poll_set *set, uint32_t type,
+			     void *obj, uint8_t tag);
+
+/**
+ * @brief Remove an object from a poll set.
+ *
+ * @note Requires CONFIG_POLL_SET.
+ *
+ * @param set The poll set.
+ * @param obj Object previously added with k_poll_set_add().
+ *
+ * @retval 0 The object was removed.
+ * @retval -ENOENT The object is not in the set.
+ */
+__syscall int k_poll_set_remove(struct k_poll_set *set, void *obj);
+
+/**
+ * @brief Wait for objects in a poll set to become ready.
+ *
+ * Copies up to @a max events describing ready objects to @a ready, each with
+ * its type, object, tag and state fields set.  Readiness is level triggered:
+ * an object keeps being reported by each call for as long as it is
+ * available.  Objects added with K_POLL_SET_EDGE are instead reported once
+ * after each time they are signaled.  Only the objects signaled since they
+ * were last found not ready are looked at, so the cost does not depend on
+ * the size of the set.
+ *
+ * As with k_poll(), the object is not "given" to the caller, and threads
+ * pending on the object directly have precedence.
+ *
+ * @note Requires CONFIG_POLL_SET.
+ *
+ * @param set The poll set.
+ * @param ready Array receiving the ready events.
+ * @param max Number of elements in @a ready.
+ * @param timeout Waiting period for an object to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events stored in @a ready, greater than zero.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL Bad parameters.
+ */
+__syscall int k_poll_set_wait(struct k_poll_set *set,
+			      struct k_poll_event *ready, int max,
+			      k_timeout_t timeout);
+
 /**
  * @internal
  */
@@ -48,13 +48,19 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq);
  * to the original Zephyr scheduler.  RAM requirements are
  * comparatively high, but performance is very fast.  Won't work with
  * features like deadline scheduling which need large priority spaces
- * to represent their requirements.
+ * to represent their requirements.  Can back the ready queue
+ * (SCHED_MULTIQ) and/or wait queues (WAITQ_MULTIQ).
  */
+/* One list per priority from K_HIGHEST_THREAD_PRIO to K_LOWEST_THREAD_PRIO */
+#define Z_PRIQ_MQ_QUEUES \
+	MIN(32, CONFIG_NUM_COOP_PRIORITIES + CONFIG_NUM_PREEMPT_PRIORITIES + 1)
+
 struct _priq_mq {
-	sys_dlist_t queues[32];
+	sys_dlist_t queues[Z_PRIQ_MQ_QUEUES];
 	unsigned int bitmask; /* bit 1<<i set if queues[i] is non-empty */
 };
 
 struct k_thread *z_priq_mq_best(struct _priq_mq *pq);
+struct k_thread *z_priq_mq_next(struct _priq_mq *pq, struct k_thread *thread);
 
 #endif /* ZEPHYR_INCLUDE_SCHED_PRIQ_H_ */
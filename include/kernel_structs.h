@@ -217,6 +217,15 @@ extern bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 
 #define Z_WAIT_Q_INIT(wait_q) { { { .lessthan_fn = z_priq_rb_lessthan } } }
 
+#elif defined(CONFIG_WAITQ_MULTIQ)
+
+typedef struct {
+	struct _priq_mq waitq;
+} _wait_q_t;
+
+/* Lists are initialized as their priority bit gets set */
+#define Z_WAIT_Q_INIT(wait_q) { { .bitmask = 0 } }
+
 #else
 
 typedef struct {
@@ -236,7 +245,10 @@ struct _timeout {
 	sys_dnode_t node;
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  With
+	 * CONFIG_TIMEOUT_QUEUE_WHEEL this holds the absolute expiry
+	 * tick instead of the delta to the previous timeout.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
@@ -1188,6 +1188,144 @@ extern const struct net_buf_data_cb net_buf_var_cb;
 					 _net_buf_##_name, _count, _ud_size,   \
 					 _destroy)
 
+/**
+ * @brief Heap shared by elastic buffer pools.
+ *
+ * Elastic pools borrow from this heap when their own data reservation is
+ * used up. The heap is under pressure from the moment the borrowed amount
+ * reaches the high watermark until it drops to the low watermark again,
+ * users of the pools should hold back new allocations meanwhile.
+ */
+struct net_buf_shared_heap {
+	/** Heap the data is borrowed from */
+	struct k_heap *heap;
+
+	/* to prevent concurrent access/modifications */
+	struct k_spinlock lock;
+
+	/** Borrowed bytes above which the heap is under pressure */
+	const size_t high_wm;
+
+	/** Borrowed bytes below which the pressure is released */
+	const size_t low_wm;
+
+	/** Bytes currently borrowed */
+	size_t used;
+
+	/** Largest amount of bytes borrowed at the same time */
+	size_t max_used;
+
+	/** Number of successful borrows */
+	uint32_t borrows;
+
+	/** Number of borrows that failed because the heap was full */
+	uint32_t failures;
+
+	/** Number of times the high watermark was reached */
+	uint32_t pressure_count;
+
+	/** Is the heap under pressure or not */
+	bool pressure;
+};
+
+/**
+ * @def NET_BUF_SHARED_HEAP_DEFINE
+ * @brief Define a heap to be shared by elastic buffer pools
+ *
+ * The heap is not static, so pools in other files can use it after
+ * declaring it with an extern declaration.
+ *
+ * @param _name      Name of the shared heap variable.
+ * @param _size      Size of the heap in bytes.
+ * @param _high_wm   Borrowed bytes above which the heap is under pressure.
+ * @param _low_wm    Borrowed bytes below which the pressure is released.
+ */
+#define NET_BUF_SHARED_HEAP_DEFINE(_name, _size, _high_wm, _low_wm)         \
+	K_HEAP_DEFINE(net_buf_shared_mem_##_name, _size);                      \
+	BUILD_ASSERT((_low_wm) <= (_high_wm), "Invalid watermarks");           \
+	struct net_buf_shared_heap _name = {                                   \
+		.heap = &net_buf_shared_mem_##_name,                           \
+		.high_wm = _high_wm,                                           \
+		.low_wm = _low_wm,                                             \
+	}
+
+struct net_buf_pool_elastic {
+	/** Data reservation of the pool */
+	struct k_heap *base;
+
+	/** Heap to borrow from when the reservation is used up */
+	struct net_buf_shared_heap *shared;
+
+	/** Bytes currently borrowed by this pool */
+	atomic_t borrowed;
+};
+
+/** @cond INTERNAL_HIDDEN */
+extern const struct net_buf_data_cb net_buf_elastic_cb;
+/** @endcond */
+
+/**
+ * @def NET_BUF_POOL_ELASTIC_DEFINE
+ * @brief Define a new pool for buffers with variable size payloads that can
+ * borrow from a shared heap
+ *
+ * Like NET_BUF_POOL_VAR_DEFINE, but when the memory reserved for the data
+ * payloads of this pool runs out, the payloads are borrowed from a heap
+ * shared with other elastic pools. A burst on one pool can then use the
+ * memory other pools do not need at that moment. Borrowing never blocks,
+ * only an allocation that can neither be served from the reservation nor
+ * from the shared heap waits for the reservation.
+ *
+ * The number of buffers is still fixed, so it must cover the bursts.
+ *
+ * @param _name      Name of the pool variable.
+ * @param _count     Number of buffers in the pool.
+ * @param _data_size Amount of memory reserved for data payloads.
+ * @param _shared    Shared heap defined with NET_BUF_SHARED_HEAP_DEFINE.
+ * @param _ud_size   User data space to reserve per buffer.
+ * @param _destroy   Optional destroy callback when buffer is freed.
+ */
+#define NET_BUF_POOL_ELASTIC_DEFINE(_name, _count, _data_size, _shared,      \
+				    _ud_size, _destroy)                        \
+	_NET_BUF_ARRAY_DEFINE(_name, _count, _ud_size);                        \
+	K_HEAP_DEFINE(net_buf_mem_pool_##_name, _data_size);                   \
+	static struct net_buf_pool_elastic net_buf_elastic_##_name = {         \
+		.base = &net_buf_mem_pool_##_name,                             \
+		.shared = &_shared,                                            \
+	};                                                                     \
+	static const struct net_buf_data_alloc net_buf_data_alloc_##_name = {  \
+		.cb = &net_buf_elastic_cb,                                     \
+		.alloc_data = &net_buf_elastic_##_name,                        \
+	};                                                                     \
+	static STRUCT_SECTION_ITERABLE(net_buf_pool, _name) =                  \
+		NET_BUF_POOL_INITIALIZER(_name, &net_buf_data_alloc_##_name,   \
+					 _net_buf_##_name, _count, _ud_size,   \
+					 _destroy)
+
+/**
+ * @brief Check if a shared heap is under pressure.
+ *
+ * @param shared Shared heap.
+ *
+ * @return True between the borrowed amount reaching the high watermark and
+ * dropping to the low watermark again.
+ */
+static inline bool
+net_buf_shared_heap_pressure(struct net_buf_shared_heap *shared)
+{
+	return shared->pressure;
+}
+
+/**
+ * @brief Get the amount of data an elastic pool has borrowed.
+ *
+ * @param pool Pool defined with NET_BUF_POOL_ELASTIC_DEFINE.
+ *
+ * @return Bytes currently borrowed from the shared heap, 0 if the pool is
+ * not an elastic pool.
+ */
+size_t net_buf_pool_borrowed(struct net_buf_pool *pool);
+
 /**
  * @def NET_BUF_POOL_DEFINE
  * @brief Define a new pool for buffers
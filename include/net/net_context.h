@@ -965,6 +965,34 @@ int net_context_sendto(struct net_context *context,
 		       k_timeout_t timeout,
 		       void *user_data);
 
+/**
+ * @brief Send network buffers to a peer without copying the data.
+ *
+ * @details This function is like net_context_sendto() but the data is
+ * given as a chain of network buffers that is attached as is to the
+ * outgoing packet. Only IPv4 and IPv6 UDP and TCP contexts are supported.
+ * If the destination address is NULL, the connected peer is used.
+ *
+ * @param context The network context to use.
+ * @param frags The network buffers to send. On success the ownership of
+ *        the buffers is transferred to the network stack, on failure the
+ *        caller still owns them.
+ * @param dst_addr Destination address or NULL.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *frags,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data);
+
 /**
  * @brief Send data in iovec to a peer specified in msghdr struct.
  *
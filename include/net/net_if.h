@@ -1972,6 +1972,17 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if TCP packets larger than the MSS need to be split into
+ * segments by the IP stack before they are given to the driver, or if the
+ * device can segment them in hardware.
+ *
+ * @param iface Network interface
+ *
+ * @return True if the IP stack needs to segment the packet, false otherwise.
+ */
+bool net_if_need_tcp_segmentation(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
@@ -577,6 +577,9 @@ union net_proto_header {
 
 #define NET_IPV6_FRAGH_OFFSET_MASK	0xfff8	/* Mask for the 13-bit Fragment Offset field */
 
+#define NET_IPV4_FRAGH_OFFSET_MASK	0x1fff	/* Mask for the 13-bit Fragment Offset field */
+#define NET_IPV4_FRAGH_MF_MASK		0x2000	/* Mask for the More Fragments flag */
+
 /** @endcond */
 
 /**
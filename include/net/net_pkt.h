@@ -50,6 +50,42 @@ struct net_pkt_cursor {
 	uint8_t *pos;
 };
 
+/**
+ * @brief Points in the stack where a packet is timestamped when
+ * CONFIG_NET_PKT_LATENCY_TRACE is enabled.
+ *
+ * RX and TX packets use the same slots, a packet only ever travels
+ * in one direction.
+ */
+enum net_pkt_trace_stage {
+	/** Driver handed the packet to the stack */
+	NET_PKT_TRACE_RX_DRIVER = 0,
+	/** RX thread started L2 processing */
+	NET_PKT_TRACE_RX_L2,
+	/** IPv4 or IPv6 input */
+	NET_PKT_TRACE_RX_IP,
+	/** TCP, UDP or raw connection demultiplexing */
+	NET_PKT_TRACE_RX_TRANSPORT,
+	/** Queued to the socket */
+	NET_PKT_TRACE_RX_SOCKET,
+	/** Read by the application */
+	NET_PKT_TRACE_RX_APP,
+
+	/** Packet allocated for sending */
+	NET_PKT_TRACE_TX_APP = 0,
+	/** TCP or UDP header finalized */
+	NET_PKT_TRACE_TX_TRANSPORT,
+	/** Given to the IP layer for sending */
+	NET_PKT_TRACE_TX_IP,
+	/** TX thread started L2 processing */
+	NET_PKT_TRACE_TX_L2,
+	/** L2 and driver returned from sending */
+	NET_PKT_TRACE_TX_DRIVER,
+};
+
+/** Number of trace stages, RX has the most */
+#define NET_PKT_TRACE_STAGES (NET_PKT_TRACE_RX_APP + 1)
+
 /**
  * @brief Network packet.
  *
@@ -113,6 +149,13 @@ struct net_pkt {
 	};
 #endif /* CONFIG_NET_PKT_RXTIME_STATS || CONFIG_NET_PKT_TXTIME_STATS */
 
+#if defined(CONFIG_NET_PKT_LATENCY_TRACE)
+	/** Cycle count when the packet reached each trace stage,
+	 * zero if the stage was not passed.
+	 */
+	uint32_t trace[NET_PKT_TRACE_STAGES];
+#endif
+
 #if defined(CONFIG_NET_PKT_TXTIME)
 	/** Network packet TX time in the future (in nanoseconds) */
 	uint64_t txtime;
@@ -189,6 +232,12 @@ struct net_pkt {
 				 * defined(CONFIG_NET_ETHERNET_BRIDGE).
 				 */
 
+	uint8_t chksum_ready : 1; /* Set to 1 if the upper layer checksum
+				   * was already updated incrementally, so
+				   * finalizing the packet does not need to
+				   * calculate it again.
+				   */
+
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
 		 * The value is shared between IPv6 and IPv4.
@@ -238,6 +287,18 @@ struct net_pkt {
 	uint8_t ipv6_next_hdr;	/* What is the very first next header */
 #endif /* CONFIG_NET_IPV6 */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	uint16_t ipv4_fragment_flags;	/* Fragment offset and MF (More Fragments) flag */
+	uint16_t ipv4_fragment_id;	/* Fragment id */
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
+#if defined(CONFIG_NET_TCP_GSO)
+	/* TCP payload of each segment the packet is split into, or 0 if
+	 * the packet is sent as is.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 #if defined(CONFIG_IEEE802154)
 	uint8_t ieee802154_rssi; /* Received Signal Strength Indication */
 	uint8_t ieee802154_lqi;  /* Link Quality Indicator */
@@ -359,6 +420,16 @@ static inline void net_pkt_set_l2_bridged(struct net_pkt *pkt, bool is_l2_bridge
 	}
 }
 
+static inline bool net_pkt_is_chksum_ready(struct net_pkt *pkt)
+{
+	return !!(pkt->chksum_ready);
+}
+
+static inline void net_pkt_set_chksum_ready(struct net_pkt *pkt, bool is_ready)
+{
+	pkt->chksum_ready = is_ready;
+}
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 	return pkt->ip_hdr_len;
@@ -714,6 +785,97 @@ static inline void net_pkt_set_ipv6_fragment_id(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IPV6_FRAGMENT */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
+{
+	return (pkt->ipv4_fragment_flags & NET_IPV4_FRAGH_OFFSET_MASK) * 8U;
+}
+
+static inline bool net_pkt_ipv4_fragment_more(struct net_pkt *pkt)
+{
+	return (pkt->ipv4_fragment_flags & NET_IPV4_FRAGH_MF_MASK) != 0;
+}
+
+static inline void net_pkt_set_ipv4_fragment_flags(struct net_pkt *pkt,
+						   uint16_t flags)
+{
+	pkt->ipv4_fragment_flags = flags;
+}
+
+static inline uint16_t net_pkt_ipv4_fragment_id(struct net_pkt *pkt)
+{
+	return pkt->ipv4_fragment_id;
+}
+
+static inline void net_pkt_set_ipv4_fragment_id(struct net_pkt *pkt,
+						uint16_t id)
+{
+	pkt->ipv4_fragment_id = id;
+}
+#else /* CONFIG_NET_IPV4_FRAGMENT */
+static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline bool net_pkt_ipv4_fragment_more(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_ipv4_fragment_flags(struct net_pkt *pkt,
+						   uint16_t flags)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(flags);
+}
+
+static inline uint16_t net_pkt_ipv4_fragment_id(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_ipv4_fragment_id(struct net_pkt *pkt,
+						uint16_t id)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(id);
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt,
+					uint16_t gso_size)
+{
+	pkt->gso_size = gso_size;
+}
+#else /* CONFIG_NET_TCP_GSO */
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt,
+					uint16_t gso_size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(gso_size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
@@ -949,6 +1111,135 @@ static inline void net_pkt_set_stats_tick(struct net_pkt *pkt, uint32_t tick)
 #endif /* CONFIG_NET_PKT_TXTIME_STATS_DETAIL ||
 	  CONFIG_NET_PKT_RXTIME_STATS_DETAIL */
 
+/** Number of log2 buckets in a latency trace histogram */
+#define NET_PKT_TRACE_HIST_BUCKETS 16
+
+/**
+ * @brief Latency breakdown of one traced packet.
+ */
+struct net_pkt_trace_record {
+	/** Address of the packet, only for telling records apart */
+	uintptr_t pkt;
+
+	/** Nanoseconds spent getting from the previous stage that was
+	 * passed to this one. Zero for the first stage and for the stages
+	 * the packet did not pass.
+	 */
+	uint32_t stage_ns[NET_PKT_TRACE_STAGES];
+
+	/** Nanoseconds from the first to the last stage */
+	uint32_t total_ns;
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP)
+	/** Hardware timestamp of the packet, valid if has_timestamp is set.
+	 * It is in the clock of the device, so it is recorded as is
+	 * instead of being compared to the stage times.
+	 */
+	struct net_ptp_time timestamp;
+#endif
+
+	/** TX packet, stage_ns is indexed with the TX stages */
+	bool tx;
+
+	/** The driver gave the packet a hardware timestamp */
+	bool has_timestamp;
+};
+
+/**
+ * @typedef net_pkt_trace_cb_t
+ * @brief Callback used while iterating over the latency trace records.
+ *
+ * @param rec A copy of the trace record
+ * @param user_data A valid pointer to user data or NULL
+ */
+typedef void (*net_pkt_trace_cb_t)(const struct net_pkt_trace_record *rec,
+				   void *user_data);
+
+#if defined(CONFIG_NET_PKT_LATENCY_TRACE)
+/**
+ * @brief Timestamp a packet at a stage of the stack.
+ *
+ * @param pkt Network packet
+ * @param stage Stage the packet has reached
+ */
+static inline void net_pkt_trace_set(struct net_pkt *pkt,
+				     enum net_pkt_trace_stage stage)
+{
+	pkt->trace[stage] = k_cycle_get_32();
+}
+
+/**
+ * @brief Forget the trace stages of a packet.
+ *
+ * This is used when a packet changes direction, e.g. when it is looped
+ * back to us.
+ *
+ * @param pkt Network packet
+ */
+static inline void net_pkt_trace_reset(struct net_pkt *pkt)
+{
+	memset(pkt->trace, 0, sizeof(pkt->trace));
+}
+
+/**
+ * @brief Timestamp the last stage of a packet and record its latency.
+ *
+ * The record is stored in the trace ring, added to the histograms and
+ * given to the tracing subsystem. The trace stages of the packet are
+ * reset after this.
+ *
+ * @param pkt Network packet that was read by the application, or sent
+ * by the driver
+ * @param tx Is this a TX packet
+ */
+void net_pkt_trace_done(struct net_pkt *pkt, bool tx);
+
+/**
+ * @brief Go through the latency records in the trace ring.
+ *
+ * The records are visited from the oldest to the newest. Records that are
+ * being overwritten while they are read are skipped.
+ *
+ * @param cb User supplied callback function to call
+ * @param user_data User specified data
+ *
+ * @return Number of records visited
+ */
+int net_pkt_trace_foreach(net_pkt_trace_cb_t cb, void *user_data);
+
+/**
+ * @brief Get a latency histogram.
+ *
+ * Bucket 0 counts latencies below 1 us, bucket n latencies below
+ * 2^n us, and the last bucket all the rest.
+ *
+ * @param tx TX histogram instead of RX one
+ * @param stage Stage the latencies are measured to. The first stage has
+ * no latency of its own, so it gives the total latency instead.
+ * @param buckets Where to copy the histogram to
+ */
+void net_pkt_trace_hist_get(bool tx, enum net_pkt_trace_stage stage,
+			    uint32_t buckets[NET_PKT_TRACE_HIST_BUCKETS]);
+#else
+static inline void net_pkt_trace_set(struct net_pkt *pkt,
+				     enum net_pkt_trace_stage stage)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(stage);
+}
+
+static inline void net_pkt_trace_reset(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+}
+
+static inline void net_pkt_trace_done(struct net_pkt *pkt, bool tx)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(tx);
+}
+#endif /* CONFIG_NET_PKT_LATENCY_TRACE */
+
 static inline size_t net_pkt_get_len(struct net_pkt *pkt)
 {
 	return net_buf_frags_len(pkt->frags);
@@ -1509,6 +1800,15 @@ void net_pkt_get_info(struct k_mem_slab **rx,
 		      struct net_buf_pool **rx_data,
 		      struct net_buf_pool **tx_data);
 
+/**
+ * @brief Get the heap the RX and TX DATA pools borrow from.
+ *
+ * Only available with CONFIG_NET_BUF_ELASTIC_DATA_SIZE.
+ *
+ * @return Shared heap of the predefined DATA pools.
+ */
+struct net_buf_shared_heap *net_pkt_get_shared_data(void);
+
 /** @cond INTERNAL_HIDDEN */
 
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
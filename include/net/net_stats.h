@@ -219,6 +219,40 @@ struct net_stats_ipv4_igmp {
 	net_stats_t drop;
 };
 
+/**
+ * @brief IPv4 fragmentation and reassembly statistics
+ */
+struct net_stats_ipv4_frag {
+	/** Number of received IPv4 fragments */
+	net_stats_t recv;
+
+	/** Number of sent IPv4 fragments */
+	net_stats_t sent;
+
+	/** Number of successfully reassembled IPv4 packets */
+	net_stats_t reassembled;
+
+	/** Number of reassemblies that timed out */
+	net_stats_t timeout;
+
+	/** Number of dropped IPv4 fragments */
+	net_stats_t drop;
+};
+
+/**
+ * @brief Connection handler lookup statistics
+ */
+struct net_stats_conn_demux {
+	/** Time spent looking up connection handlers, in nanoseconds */
+	uint64_t sum;
+
+	/** Number of lookups */
+	net_stats_t count;
+
+	/** Number of connection handlers compared */
+	net_stats_t visited;
+};
+
 /**
  * @brief Network packet transfer times for calculating average TX time
  */
@@ -275,6 +309,23 @@ struct net_stats_tc {
 };
 
 
+/**
+ * @brief Flow hashed queue statistics
+ */
+struct net_stats_flow_queues {
+	/** Packets and bytes sent by each TX queue */
+	struct {
+		net_stats_t pkts;
+		net_stats_t bytes;
+	} sent[NET_TC_TX_STATS_COUNT];
+
+	/** Packets and bytes received by each RX queue */
+	struct {
+		net_stats_t pkts;
+		net_stats_t bytes;
+	} recv[NET_TC_RX_STATS_COUNT];
+};
+
 /**
  * @brief Power management statistics
  */
@@ -342,11 +393,26 @@ struct net_stats {
 	struct net_stats_ipv4_igmp ipv4_igmp;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_IPV4_FRAGMENT)
+	/** IPv4 fragmentation statistics */
+	struct net_stats_ipv4_frag ipv4_frag;
+#endif
+
 #if NET_TC_COUNT > 1
 	/** Traffic class statistics */
 	struct net_stats_tc tc;
 #endif
 
+#if defined(CONFIG_NET_STATISTICS_FLOW_QUEUES)
+	/** Flow hashed queue statistics */
+	struct net_stats_flow_queues flow_queues;
+#endif
+
+#if defined(CONFIG_NET_STATISTICS_CONN_DEMUX)
+	/** Connection handler lookup statistics */
+	struct net_stats_conn_demux conn_demux;
+#endif
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS)
 	/** Network packet TX time statistics */
 	struct net_stats_tx_time tx_time;
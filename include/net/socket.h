@@ -39,6 +39,12 @@ struct zsock_pollfd {
 	short revents;
 };
 
+/** Message of zsock_recvmmsg() and zsock_sendmmsg() */
+struct zsock_mmsghdr {
+	struct msghdr msg_hdr; /**< Message header */
+	unsigned int msg_len;  /**< Number of bytes transferred */
+};
+
 /* ZSOCK_POLL* values are compatible with Linux */
 /** zsock_poll: Poll for readability */
 #define ZSOCK_POLLIN 1
@@ -55,6 +61,10 @@ struct zsock_pollfd {
 
 /** zsock_recv: Read data without removing it from socket input queue */
 #define ZSOCK_MSG_PEEK 0x02
+/** zsock_recvmsg: Control data was discarded as the buffer was too small
+ *  (output value only)
+ */
+#define ZSOCK_MSG_CTRUNC 0x08
 /** zsock_recv: return the real length of the datagram, even when it was longer
  *  than the passed buffer
  */
@@ -414,6 +424,108 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Receive data without copying it to an application buffer
+ *
+ * @details
+ * Returns the network buffers holding the data of one received packet.
+ * The buffers must be released with zsock_recv_zc_release() once the data
+ * is consumed. Only sockets of the native IP stack are supported, and
+ * the ZSOCK_MSG_PEEK flag is not. This function can be used from kernel
+ * threads only.
+ *
+ * @param sock Socket to receive from
+ * @param frags Filled with the received network buffers
+ * @param flags Receive flags
+ * @param src_addr Filled with the sender address, can be NULL
+ * @param addrlen Length of the sender address, can be NULL
+ *
+ * @return Number of bytes received, 0 at the end of stream, -1 with
+ * errno set on error.
+ */
+ssize_t zsock_recvfrom_zc(int sock, struct net_buf **frags, int flags,
+			  struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Release network buffers returned by zsock_recvfrom_zc()
+ *
+ * @param frags Network buffers to release
+ */
+void zsock_recv_zc_release(struct net_buf *frags);
+
+/**
+ * @brief Send network buffers without copying the data
+ *
+ * @details
+ * Sends a chain of network buffers allocated by the caller. On success
+ * the buffers are owned by the network stack, on error the caller still
+ * owns them. Only UDP and TCP sockets of the native IP stack are
+ * supported. This function can be used from kernel threads only.
+ *
+ * @param sock Socket to send to
+ * @param frags Network buffers to send
+ * @param flags Send flags
+ * @param dest_addr Destination address, NULL for a connected socket
+ * @param addrlen Length of the destination address
+ *
+ * @return Number of bytes sent, -1 with errno set on error.
+ */
+ssize_t zsock_sendto_zc(int sock, struct net_buf *frags, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen);
+
+/**
+ * @brief Receive a message from an arbitrary network address
+ *
+ * @details
+ * @rst
+ * See `POSIX.1-2017 article
+ * <http://pubs.opengroup.org/onlinepubs/9699919799/functions/recvmsg.html>`__
+ * for normative description.
+ * Datagram sockets can return the ``IP_PKTINFO``, ``IPV6_PKTINFO`` and
+ * ``SCM_TIMESTAMP`` ancillary data, if enabled with the matching socket
+ * options.
+ * This function is also exposed as ``recvmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ */
+__syscall ssize_t zsock_recvmsg(int sock, struct msghdr *msg, int flags);
+
+/**
+ * @brief Receive multiple messages with one call
+ *
+ * @details
+ * @rst
+ * Like ``recvmmsg()`` of Linux, but without the timeout argument. The
+ * call blocks only until the first message is received, as with the
+ * ``MSG_WAITFORONE`` flag of Linux, then returns the messages that are
+ * already queued.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages received, -1 with errno set on error.
+ */
+__syscall int zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Send multiple messages with one call
+ *
+ * @details
+ * @rst
+ * Like ``sendmmsg()`` of Linux. The messages are sent in order until
+ * the first one that fails.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, -1 with errno set on error.
+ */
+__syscall int zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -444,6 +556,108 @@ __syscall int zsock_fcntl(int sock, int cmd, int flags);
  */
 __syscall int zsock_poll(struct zsock_pollfd *fds, int nfds, int timeout);
 
+/** zsock_epoll_event: Available for reading, as ZSOCK_POLLIN */
+#define ZSOCK_EPOLLIN ZSOCK_POLLIN
+/** zsock_epoll_event: Available for writing, as ZSOCK_POLLOUT */
+#define ZSOCK_EPOLLOUT ZSOCK_POLLOUT
+/** zsock_epoll_event: Error condition (output value only) */
+#define ZSOCK_EPOLLERR ZSOCK_POLLERR
+/** zsock_epoll_event: Closed connection (output value only) */
+#define ZSOCK_EPOLLHUP ZSOCK_POLLHUP
+/** zsock_epoll_event: Edge triggered notification */
+#define ZSOCK_EPOLLET BIT(31)
+
+/** zsock_epoll_ctl: Add a file descriptor to the epoll instance */
+#define ZSOCK_EPOLL_CTL_ADD 1
+/** zsock_epoll_ctl: Remove a file descriptor from the epoll instance */
+#define ZSOCK_EPOLL_CTL_DEL 2
+/** zsock_epoll_ctl: Change the events of a file descriptor */
+#define ZSOCK_EPOLL_CTL_MOD 3
+
+/** User data of a file descriptor in an epoll instance */
+typedef union zsock_epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} zsock_epoll_data_t;
+
+/** Events of a file descriptor in an epoll instance */
+struct zsock_epoll_event {
+	uint32_t events;         /* ZSOCK_EPOLL* flags */
+	zsock_epoll_data_t data; /* Returned as is by zsock_epoll_wait() */
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux epoll_create1(2) <https://man7.org/linux/man-pages/man2/epoll_create1.2.html>`__
+ * for a description. Unlike with poll(), the file descriptors of an epoll
+ * instance stay registered with the kernel between waits, and a wait only
+ * looks at the ones that were signaled, so its cost does not grow with the
+ * number of file descriptors. Sockets of the native IP stack, TLS sockets,
+ * socketpairs and eventfds are supported, offloaded sockets are not.
+ * This function is also exposed as ``epoll_create1()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * Requires :kconfig:option:`CONFIG_NET_SOCKETS_EPOLL`.
+ * @endrst
+ *
+ * @param flags Must be 0
+ *
+ * @return File descriptor of the epoll instance, -1 with errno set on
+ * error.
+ */
+__syscall int zsock_epoll_create(int flags);
+
+/**
+ * @brief Add, modify or remove a file descriptor of an epoll instance
+ *
+ * @details
+ * @rst
+ * See `Linux epoll_ctl(2) <https://man7.org/linux/man-pages/man2/epoll_ctl.2.html>`__
+ * for a description. ``EPOLLONESHOT``, ``EPOLLRDHUP`` and nested epoll
+ * instances are not supported. File descriptors are removed from the epoll
+ * instances when they are closed.
+ * This function is also exposed as ``epoll_ctl()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param epfd File descriptor of the epoll instance
+ * @param op One of the ZSOCK_EPOLL_CTL_* values
+ * @param fd File descriptor to add, modify or remove
+ * @param event Events to wait for, ignored for ZSOCK_EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 with errno set on error.
+ */
+__syscall int zsock_epoll_ctl(int epfd, int op, int fd,
+			      struct zsock_epoll_event *event);
+
+/**
+ * @brief Wait for file descriptors of an epoll instance to be ready
+ *
+ * @details
+ * @rst
+ * See `Linux epoll_wait(2) <https://man7.org/linux/man-pages/man2/epoll_wait.2.html>`__
+ * for a description. With ``EPOLLET`` a file descriptor is reported once
+ * each time new data or space becomes available, otherwise it is reported
+ * by each call for as long as it is ready.
+ * This function is also exposed as ``epoll_wait()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @param epfd File descriptor of the epoll instance
+ * @param events Filled with the ready file descriptors
+ * @param maxevents Number of elements in @a events
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of ready file descriptors, 0 on timeout, -1 with errno
+ * set on error.
+ */
+__syscall int zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			       int maxevents, int timeout);
+
 /**
  * @brief Get various socket options
  *
@@ -646,6 +860,10 @@ int zsock_getnameinfo(const struct sockaddr *addr, socklen_t addrlen,
 #if defined(CONFIG_NET_SOCKETS_POSIX_NAMES)
 
 #define pollfd zsock_pollfd
+#define mmsghdr zsock_mmsghdr
+#define epoll_event zsock_epoll_event
+#define epoll_data zsock_epoll_data
+#define epoll_data_t zsock_epoll_data_t
 
 static inline int socket(int family, int type, int proto)
 {
@@ -734,11 +952,45 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
 }
 
+static inline int epoll_create1(int flags)
+{
+	return zsock_epoll_create(flags);
+}
+
+static inline int epoll_ctl(int epfd, int op, int fd,
+			    struct zsock_epoll_event *event)
+{
+	return zsock_epoll_ctl(epfd, op, fd, event);
+}
+
+static inline int epoll_wait(int epfd, struct zsock_epoll_event *events,
+			     int maxevents, int timeout)
+{
+	return zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+
 static inline int getsockopt(int sock, int level, int optname,
 			     void *optval, socklen_t *optlen)
 {
@@ -806,7 +1058,18 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define POLLHUP ZSOCK_POLLHUP
 #define POLLNVAL ZSOCK_POLLNVAL
 
+#define EPOLLIN ZSOCK_EPOLLIN
+#define EPOLLOUT ZSOCK_EPOLLOUT
+#define EPOLLERR ZSOCK_EPOLLERR
+#define EPOLLHUP ZSOCK_EPOLLHUP
+#define EPOLLET ZSOCK_EPOLLET
+
+#define EPOLL_CTL_ADD ZSOCK_EPOLL_CTL_ADD
+#define EPOLL_CTL_DEL ZSOCK_EPOLL_CTL_DEL
+#define EPOLL_CTL_MOD ZSOCK_EPOLL_CTL_MOD
+
 #define MSG_PEEK ZSOCK_MSG_PEEK
+#define MSG_CTRUNC ZSOCK_MSG_CTRUNC
 #define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
@@ -876,6 +1139,12 @@ struct ifreq {
 /** sockopt: Socket accepts incoming connections (ignored, for compatibility) */
 #define SO_ACCEPTCONN 30
 
+/** sockopt: Return the RX timestamp of datagrams as SCM_TIMESTAMP
+ *  ancillary data (struct net_ptp_time)
+ */
+#define SO_TIMESTAMP 29
+#define SCM_TIMESTAMP SO_TIMESTAMP
+
 /** sockopt: Timestamp TX packets */
 #define SO_TIMESTAMPING 37
 /** sockopt: Protocol used with the socket */
@@ -890,10 +1159,36 @@ struct ifreq {
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
 
+/* Socket options for IPPROTO_IP level */
+/** sockopt: Return the destination address of datagrams as IP_PKTINFO
+ *  ancillary data
+ */
+#define IP_PKTINFO 8
+
+/** Ancillary data of IP_PKTINFO */
+struct in_pktinfo {
+	unsigned int   ipi_ifindex;  /**< Interface index */
+	struct in_addr ipi_spec_dst; /**< Local address */
+	struct in_addr ipi_addr;     /**< Destination address */
+};
+
 /* Socket options for IPPROTO_IPV6 level */
 /** sockopt: Don't support IPv4 access (ignored, for compatibility) */
 #define IPV6_V6ONLY 26
 
+/** sockopt: Return the destination address of datagrams as IPV6_PKTINFO
+ *  ancillary data
+ */
+#define IPV6_RECVPKTINFO 49
+/** Type of the IPV6_RECVPKTINFO ancillary data */
+#define IPV6_PKTINFO 50
+
+/** Ancillary data of IPV6_PKTINFO */
+struct in6_pktinfo {
+	struct in6_addr ipi6_addr;    /**< Destination address */
+	unsigned int    ipi6_ifindex; /**< Interface index */
+};
+
 /** sockopt: Socket priority */
 #define SO_PRIORITY 12
 
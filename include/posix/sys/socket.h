@@ -13,6 +13,8 @@
 extern "C" {
 #endif
 
+#define mmsghdr zsock_mmsghdr
+
 static inline int socket(int family, int type, int proto)
 {
 	return zsock_socket(family, type, proto);
@@ -28,6 +30,7 @@ static inline int socketpair(int family, int type, int proto, int sv[2])
 #define SHUT_RDWR ZSOCK_SHUT_RDWR
 
 #define MSG_PEEK ZSOCK_MSG_PEEK
+#define MSG_CTRUNC ZSOCK_MSG_CTRUNC
 #define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
@@ -87,6 +90,23 @@ static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline ssize_t recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg(sock, msg, flags);
+}
+
+static inline int recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
+static inline int sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline int getsockopt(int sock, int level, int optname,
 			     void *optval, socklen_t *optlen)
 {
@@ -106,6 +106,24 @@ void *z_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err);
 void *z_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable,
 			      struct k_mutex **lock);
 
+#ifdef CONFIG_NET_SOCKETS_EPOLL
+/**
+ * @brief Remove a file descriptor from the epoll instances watching it.
+ *
+ * Called when a file descriptor is closed, before its close vmethod, as
+ * the epoll instances stay registered on kernel objects of the underlying
+ * I/O object.
+ *
+ * @param fd File descriptor being closed
+ */
+void z_epoll_fd_close(int fd);
+#else
+static inline void z_epoll_fd_close(int fd)
+{
+	(void)fd;
+}
+#endif
+
 /**
  * @brief Call ioctl vmethod on an object using varargs.
  *
@@ -33,6 +33,7 @@ enum heap_event_types {
 	HEAP_ALLOC,
 	HEAP_FREE,
 	HEAP_REALLOC,
+	HEAP_SIZE_CLASS,
 
 	HEAP_MAX_EVENTS
 };
@@ -89,6 +90,21 @@ typedef void (*heap_listener_alloc_cb_t)(uintptr_t heap_id,
 typedef void (*heap_listener_free_cb_t)(uintptr_t heap_id,
 					void *mem, size_t bytes);
 
+/**
+ * @typedef heap_listener_size_class_cb_t
+ * @brief Callback used when a small allocation is looked up in the
+ *        size class front end
+ *
+ * @note Only emitted by sys_heap with CONFIG_SYS_HEAP_SIZE_CLASSES.
+ *
+ * @param heap_id Heap identifier
+ * @param hits Total allocations served from the size class lists
+ * @param misses Total small allocations that fell back to the heap
+ */
+typedef void (*heap_listener_size_class_cb_t)(uintptr_t heap_id,
+					      uint32_t hits,
+					      uint32_t misses);
+
 struct heap_listener {
 	/** Singly linked list node */
 	sys_snode_t node;
@@ -110,6 +126,7 @@ struct heap_listener {
 		heap_listener_alloc_cb_t alloc_cb;
 		heap_listener_free_cb_t free_cb;
 		heap_listener_resize_cb_t resize_cb;
+		heap_listener_size_class_cb_t size_class_cb;
 	};
 };
 
@@ -170,6 +187,19 @@ void heap_listener_notify_free(uintptr_t heap_id, void *mem, size_t bytes);
  */
 void heap_listener_notify_resize(uintptr_t heap_id, void *old_heap_end, void *new_heap_end);
 
+/**
+ * @brief Notify listeners of heap size class lookup event
+ *
+ * Notify registered heap event listeners with matching heap identifier of
+ * the current size class hit and miss counts.
+ *
+ * @param heap_id Heap identifier
+ * @param hits Total allocations served from the size class lists
+ * @param misses Total small allocations that fell back to the heap
+ */
+void heap_listener_notify_size_class(uintptr_t heap_id, uint32_t hits,
+				     uint32_t misses);
+
 /**
  * @brief Construct heap identifier from heap pointer
  *
@@ -265,6 +295,34 @@ void heap_listener_notify_resize(uintptr_t heap_id, void *old_heap_end, void *ne
 		}, \
 	}
 
+/**
+ * @brief Define heap event listener node for size class event
+ *
+ * Sample usage:
+ * @code
+ * void on_heap_size_class(uintptr_t heap_id, uint32_t hits, uint32_t misses)
+ * {
+ *   LOG_INF("Heap %p size class hit rate %u%%", (void *)heap_id,
+ *           100 * hits / (hits + misses));
+ * }
+ *
+ * HEAP_LISTENER_SIZE_CLASS_DEFINE(my_listener, HEAP_ID_FROM_POINTER(&my_heap),
+ *                                 on_heap_size_class);
+ * @endcode
+ *
+ * @param name		Name of the heap event listener object
+ * @param _heap_id	Identifier of the heap to be listened
+ * @param _size_class_cb	Function to be called for size class event
+ */
+#define HEAP_LISTENER_SIZE_CLASS_DEFINE(name, _heap_id, _size_class_cb) \
+	struct heap_listener name = { \
+		.heap_id = _heap_id, \
+		.event = HEAP_SIZE_CLASS, \
+		{ \
+			.size_class_cb = _size_class_cb \
+		}, \
+	}
+
 /** @} */
 
 #else /* CONFIG_HEAP_LISTENER */
@@ -293,6 +351,15 @@ static inline void heap_listener_notify_resize(uintptr_t heap_id, void *old_heap
 	ARG_UNUSED(new_heap_end);
 }
 
+static inline void heap_listener_notify_size_class(uintptr_t heap_id,
+						   uint32_t hits,
+						   uint32_t misses)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(hits);
+	ARG_UNUSED(misses);
+}
+
 #endif /* CONFIG_HEAP_LISTENER */
 
 #ifdef __cplusplus
@@ -2004,6 +2004,20 @@
 
 /** @} */ /* end of subsys_tracing_apis_pm_device_runtime */
 
+/**
+ * @brief Network Packet Tracing APIs
+ * @defgroup subsys_tracing_apis_net_pkt Network Packet Tracing APIs
+ * @{
+ */
+
+/**
+ * @brief Trace the latency of a packet through the network stack.
+ * @param rec Latency record, struct net_pkt_trace_record.
+ */
+#define sys_port_trace_net_pkt_latency(rec)
+
+/** @} */ /* end of subsys_tracing_apis_net_pkt */
+
 #if defined(CONFIG_PERCEPIO_TRACERECORDER)
 #include "tracing_tracerecorder.h"
 #else
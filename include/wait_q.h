@@ -38,7 +38,23 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 	return (struct k_thread *)rb_get_min(&w->waitq.tree);
 }
 
-#else /* !CONFIG_WAITQ_SCALABLE: */
+#elif defined(CONFIG_WAITQ_MULTIQ)
+
+#define _WAIT_Q_FOR_EACH(wq, thread_ptr) \
+	for (thread_ptr = z_priq_mq_best(&(wq)->waitq); thread_ptr != NULL; \
+	     thread_ptr = z_priq_mq_next(&(wq)->waitq, thread_ptr))
+
+static inline void z_waitq_init(_wait_q_t *w)
+{
+	w->waitq.bitmask = 0U;
+}
+
+static inline struct k_thread *z_waitq_head(_wait_q_t *w)
+{
+	return z_priq_mq_best(&w->waitq);
+}
+
+#else /* !CONFIG_WAITQ_SCALABLE && !CONFIG_WAITQ_MULTIQ: */
 
 #define _WAIT_Q_FOR_EACH(wq, thread_ptr) \
 	SYS_DLIST_FOR_EACH_CONTAINER(&((wq)->waitq), thread_ptr, \
@@ -54,7 +70,7 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 	return (struct k_thread *)sys_dlist_peek_head(&w->waitq);
 }
 
-#endif /* !CONFIG_WAITQ_SCALABLE */
+#endif /* !CONFIG_WAITQ_SCALABLE && !CONFIG_WAITQ_MULTIQ */
 
 #ifdef __cplusplus
 }
@@ -66,21 +66,15 @@ int z_vrfy_k_condvar_signal(struct k_condvar *condvar)
 
 int z_impl_k_condvar_broadcast(struct k_condvar *condvar)
 {
-	struct k_thread *pending_thread;
 	k_spinlock_key_t key;
-	int woken = 0;
+	int woken;
 
 	key = k_spin_lock(&lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_condvar, broadcast, condvar);
 
 	/* wake up any threads that are waiting to write */
-	while ((pending_thread = z_unpend_first_thread(&condvar->wait_q)) !=
-	       NULL) {
-		woken++;
-		arch_thread_return_value_set(pending_thread, 0);
-		z_ready_thread(pending_thread);
-	}
+	woken = (int)z_sched_wake_n(&condvar->wait_q, 0, NULL, UINT_MAX);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_condvar, broadcast, condvar, woken);
 
@@ -315,11 +315,30 @@ static ALWAYS_INLINE bool z_is_thread_timeout_expired(struct k_thread *thread)
  */
 bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
 
+/**
+ * Wake up to n threads pending on the provided wait queue
+ *
+ * Equivalent to calling z_sched_wake() up to n times, but all threads are
+ * made ready under a single scheduler lock acquisition and the ready queue
+ * cache update and IPI happen once for the whole batch rather than once
+ * per thread. Threads are woken in wait queue order.
+ *
+ * The same locking requirements as z_sched_wake() apply.
+ *
+ * @param wait_q Wait queue to wake up threads from
+ * @param swap_retval Swap return value for the woken threads
+ * @param swap_data Data return value to supplement swap_retval. May be NULL.
+ * @param n Maximum number of threads to wake up
+ * @return Number of threads actually woken up
+ */
+unsigned int z_sched_wake_n(_wait_q_t *wait_q, int swap_retval,
+			    void *swap_data, unsigned int n);
+
 /**
  * Wake up all threads pending on the provided wait queue
  *
- * Convenience function to invoke z_sched_wake() on all threads in the queue
- * until there are no more to wake up.
+ * Convenience function to invoke z_sched_wake_n() on all threads in the
+ * queue.
  *
  * @param wait_q Wait queue to wake up the highest prio thread
  * @param swap_retval Swap return value for woken thread
@@ -330,14 +349,8 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data);
 static inline bool z_sched_wake_all(_wait_q_t *wait_q, int swap_retval,
 				    void *swap_data)
 {
-	bool woken = false;
-
-	while (z_sched_wake(wait_q, swap_retval, swap_data)) {
-		woken = true;
-	}
-
 	/* True if we woke at least one thread up */
-	return woken;
+	return z_sched_wake_n(wait_q, swap_retval, swap_data, UINT_MAX) != 0U;
 }
 
 /**
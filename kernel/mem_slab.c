@@ -14,6 +14,7 @@
 #include <ksched.h>
 #include <init.h>
 #include <sys/check.h>
+#include <string.h>
 
 /**
  * @brief Initialize kernel memory slab subsystem.
@@ -73,6 +74,155 @@ out:
 SYS_INIT(init_mem_slab_module, PRE_KERNEL_1,
 	 CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Blocks moved between a CPU cache and the shared free list at once */
+#define CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_SIZE / 2)
+
+/* The cache of a CPU is used by that CPU, and by other CPUs only when
+ * they steal from it before running out of blocks, so its lock is
+ * almost never contended.  The slab spinlock is taken only to refill
+ * or drain a cache in batches, always after the cache lock.
+ */
+static bool cache_alloc(struct k_mem_slab *slab, void **mem)
+{
+	unsigned int key = arch_irq_lock();
+	struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t ckey = k_spin_lock(&cache->lock);
+	bool ret = false;
+
+	if (cache->count > 0U) {
+		cache->hits++;
+	} else {
+		k_spinlock_key_t lkey = k_spin_lock(&slab->lock);
+
+		while (cache->count < CACHE_BATCH && slab->free_list != NULL) {
+			cache->blocks[cache->count++] = slab->free_list;
+			slab->free_list = *(char **)(slab->free_list);
+			slab->num_used++;
+		}
+
+		k_spin_unlock(&slab->lock, lkey);
+		cache->misses++;
+	}
+
+	if (cache->count > 0U) {
+		*mem = cache->blocks[--cache->count];
+		ret = true;
+	}
+
+	k_spin_unlock(&cache->lock, ckey);
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+/* Take a block cached by another CPU.  This is the last resort before
+ * an allocation fails or pends, so a slab does not run out while free
+ * blocks sit in the caches of other CPUs.
+ */
+static bool cache_steal(struct k_mem_slab *slab, void **mem)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[i];
+		k_spinlock_key_t key;
+		bool found = false;
+
+		if (cache->count == 0U) {
+			continue;
+		}
+
+		key = k_spin_lock(&cache->lock);
+
+		if (cache->count > 0U) {
+			*mem = cache->blocks[--cache->count];
+			found = true;
+		}
+
+		k_spin_unlock(&cache->lock, key);
+
+		if (found) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+/* Cache hits do not take the slab lock, which is only needed when the
+ * maximum actually grows.
+ */
+static void cache_update_max_used(struct k_mem_slab *slab)
+{
+	k_spinlock_key_t key;
+
+	if (k_mem_slab_num_used_get(slab) <= slab->max_used) {
+		return;
+	}
+
+	key = k_spin_lock(&slab->lock);
+	slab->max_used = MAX(k_mem_slab_num_used_get(slab), slab->max_used);
+	k_spin_unlock(&slab->lock, key);
+}
+#else
+#define cache_update_max_used(slab)
+#endif
+
+static bool cache_free(struct k_mem_slab *slab, void *block)
+{
+	unsigned int key = arch_irq_lock();
+	struct k_mem_slab_cpu_cache *cache = &slab->cpu_cache[_current_cpu->id];
+	k_spinlock_key_t ckey;
+
+	/* Blocked allocators must get the block directly.  This is
+	 * checked without the lock, a thread starting to wait right
+	 * now will be served by the next free taking the slow path.
+	 */
+	if (z_waitq_head(&slab->wait_q) != NULL) {
+		arch_irq_unlock(key);
+		return false;
+	}
+
+	ckey = k_spin_lock(&cache->lock);
+
+	if (cache->count < CONFIG_MEM_SLAB_CPU_CACHE_SIZE) {
+		cache->hits++;
+	} else {
+		k_spinlock_key_t lkey = k_spin_lock(&slab->lock);
+
+		while (cache->count > CONFIG_MEM_SLAB_CPU_CACHE_SIZE - CACHE_BATCH) {
+			char *p = cache->blocks[--cache->count];
+
+			*(char **)p = slab->free_list;
+			slab->free_list = p;
+			slab->num_used--;
+		}
+
+		k_spin_unlock(&slab->lock, lkey);
+		cache->misses++;
+	}
+
+	cache->blocks[cache->count++] = block;
+
+	k_spin_unlock(&cache->lock, ckey);
+	arch_irq_unlock(key);
+
+	return true;
+}
+
+void k_mem_slab_cache_stats_get(struct k_mem_slab *slab,
+				struct k_mem_slab_cache_stats *stats)
+{
+	stats->hits = 0U;
+	stats->misses = 0U;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		stats->hits += slab->cpu_cache[i].hits;
+		stats->misses += slab->cpu_cache[i].misses;
+	}
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
 int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 		    size_t block_size, uint32_t num_blocks)
 {
@@ -88,6 +238,10 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->max_used = 0U;
 #endif
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	(void)memset(slab->cpu_cache, 0, sizeof(slab->cpu_cache));
+#endif
+
 	rc = create_free_list(slab);
 	if (rc < 0) {
 		goto out;
@@ -103,6 +257,18 @@ out:
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* The cache was refilled from the free list if it could be, so
+	 * only stealing is left before the slow path.
+	 */
+	if (cache_alloc(slab, mem) || cache_steal(slab, mem)) {
+		cache_update_max_used(slab);
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 	int result;
 
@@ -115,7 +281,8 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 		slab->num_used++;
 
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->max_used = MAX(slab->num_used, slab->max_used);
+		slab->max_used = MAX(k_mem_slab_num_used_get(slab),
+				     slab->max_used);
 #endif
 
 		result = 0;
@@ -147,6 +314,14 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_free(slab, *mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
@@ -45,6 +45,14 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
 	msgq->lock = (struct k_spinlock) {};
+#ifdef CONFIG_MSGQ_LOCKLESS
+	/* No room for sequence numbers in a caller supplied buffer */
+	msgq->seq = NULL;
+	atomic_clear(&msgq->tail);
+	atomic_clear(&msgq->head);
+	atomic_clear(&msgq->waiters);
+	z_waitq_init(&msgq->put_wait_q);
+#endif
 #ifdef CONFIG_POLL
 	sys_dlist_init(&msgq->poll_events);
 #endif	/* CONFIG_POLL */
@@ -66,10 +74,24 @@ int z_impl_k_msgq_alloc_init(struct k_msgq *msgq, size_t msg_size,
 	if (size_mul_overflow(msg_size, max_msgs, &total_size)) {
 		ret = -EINVAL;
 	} else {
+#ifdef CONFIG_MSGQ_LOCKLESS
+		size_t seq_off = ROUND_UP(total_size, sizeof(atomic_t));
+
+		if (Z_MSGQ_LOCKLESS(max_msgs)) {
+			total_size = seq_off + max_msgs * sizeof(atomic_t);
+		}
+#endif
 		buffer = z_thread_malloc(total_size);
 		if (buffer != NULL) {
 			k_msgq_init(msgq, buffer, msg_size, max_msgs);
 			msgq->flags = K_MSGQ_FLAG_ALLOC;
+#ifdef CONFIG_MSGQ_LOCKLESS
+			if (Z_MSGQ_LOCKLESS(max_msgs)) {
+				msgq->seq = (atomic_t *)((char *)buffer + seq_off);
+				(void)memset(msgq->seq, 0,
+					     max_msgs * sizeof(atomic_t));
+			}
+#endif
 			ret = 0;
 		} else {
 			ret = -ENOMEM;
@@ -92,11 +114,21 @@ int z_vrfy_k_msgq_alloc_init(struct k_msgq *msgq, size_t msg_size,
 #include <syscalls/k_msgq_alloc_init_mrsh.c>
 #endif
 
+static inline bool has_waiters(struct k_msgq *msgq)
+{
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (z_waitq_head(&msgq->put_wait_q) != NULL) {
+		return true;
+	}
+#endif
+	return z_waitq_head(&msgq->wait_q) != NULL;
+}
+
 int k_msgq_cleanup(struct k_msgq *msgq)
 {
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, cleanup, msgq);
 
-	CHECKIF(z_waitq_head(&msgq->wait_q) != NULL) {
+	CHECKIF(has_waiters(msgq)) {
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
 
 		return -EBUSY;
@@ -113,6 +145,242 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 }
 
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+/* Lockless ring, a bounded MPMC queue in the style of Dmitry Vyukov's.
+ * Every slot carries a sequence number telling which lap of the ring
+ * it is ready for: a producer may fill slot (pos & mask) once its
+ * sequence equals pos, a consumer may drain it once it equals pos + 1.
+ * Producers and consumers claim positions with a CAS on tail/head,
+ * copy the message without any lock held and then publish the slot
+ * by advancing its sequence.
+ *
+ * The spinlock and wait queues are only used to block.  A thread that
+ * finds the ring full (or empty) bumps "waiters" and retries under
+ * the lock before pending, writers on put_wait_q and readers on
+ * wait_q.  Every successful put wakes one reader and every successful
+ * get wakes one writer if "waiters" is non-zero.  Both sides use
+ * sequentially consistent atomics, so either the blocking thread sees
+ * the new state or the other side sees it waiting.  Woken threads
+ * retry the ring rather than being handed a message; if the retry
+ * fails, whoever got there first did its own wake.  A single queue
+ * for both sides would lose wakeups: a put could wake a reader that
+ * then wakes a second, still starved reader instead of a writer.
+ *
+ * Sequence numbers are stored minus the slot index so that an all
+ * zero array (as K_MSGQ_DEFINE() provides) is an empty ring.
+ */
+static inline unsigned long slot_seq(struct k_msgq *msgq, uint32_t slot)
+{
+	return (unsigned long)atomic_get(&msgq->seq[slot]) + slot;
+}
+
+static inline void slot_seq_set(struct k_msgq *msgq, uint32_t slot,
+				unsigned long seq)
+{
+	(void)atomic_set(&msgq->seq[slot], (atomic_val_t)(seq - slot));
+}
+
+static bool ring_put(struct k_msgq *msgq, const void *data)
+{
+	uint32_t mask = msgq->max_msgs - 1U;
+	unsigned long pos = (unsigned long)atomic_get(&msgq->tail);
+	uint32_t slot;
+
+	for (;;) {
+		slot = pos & mask;
+
+		long diff = (long)(slot_seq(msgq, slot) - pos);
+
+		if (diff == 0) {
+			if (atomic_cas(&msgq->tail, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1U))) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* slot still holds last lap's message: full */
+			return false;
+		} else {
+			;
+		}
+		pos = (unsigned long)atomic_get(&msgq->tail);
+	}
+
+	(void)memcpy(msgq->buffer_start + slot * msgq->msg_size, data,
+		     msgq->msg_size);
+	slot_seq_set(msgq, slot, pos + 1U);
+
+	return true;
+}
+
+/* A NULL data pointer discards the message */
+static bool ring_get(struct k_msgq *msgq, void *data)
+{
+	uint32_t mask = msgq->max_msgs - 1U;
+	unsigned long pos = (unsigned long)atomic_get(&msgq->head);
+	uint32_t slot;
+
+	for (;;) {
+		slot = pos & mask;
+
+		long diff = (long)(slot_seq(msgq, slot) - (pos + 1U));
+
+		if (diff == 0) {
+			if (atomic_cas(&msgq->head, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1U))) {
+				break;
+			}
+		} else if (diff < 0) {
+			/* slot not published yet: empty */
+			return false;
+		} else {
+			;
+		}
+		pos = (unsigned long)atomic_get(&msgq->head);
+	}
+
+	if (data != NULL) {
+		(void)memcpy(data, msgq->buffer_start + slot * msgq->msg_size,
+			     msgq->msg_size);
+	}
+	slot_seq_set(msgq, slot, pos + msgq->max_msgs);
+
+	return true;
+}
+
+static bool ring_peek(struct k_msgq *msgq, void *data)
+{
+	uint32_t mask = msgq->max_msgs - 1U;
+
+	for (;;) {
+		unsigned long pos = (unsigned long)atomic_get(&msgq->head);
+		uint32_t slot = pos & mask;
+
+		if (slot_seq(msgq, slot) != pos + 1U) {
+			return false;
+		}
+
+		(void)memcpy(data, msgq->buffer_start + slot * msgq->msg_size,
+			     msgq->msg_size);
+
+		/* The slot can't be rewritten before head moves past it */
+		if ((unsigned long)atomic_get(&msgq->head) == pos) {
+			return true;
+		}
+	}
+}
+
+static void lockless_wake(struct k_msgq *msgq, _wait_q_t *wait_q)
+{
+	if (atomic_get(&msgq->waiters) == 0) {
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+	struct k_thread *thread = z_unpend_first_thread(wait_q);
+
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+/* Blocks until the ring operation succeeds, the timeout expires or
+ * the queue is purged.  Returns with the operation done on success.
+ */
+static int lockless_wait(struct k_msgq *msgq, void *data, bool put,
+			 k_timeout_t timeout)
+{
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	int result;
+
+	for (;;) {
+		k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+
+		atomic_inc(&msgq->waiters);
+
+		if (put ? ring_put(msgq, data) : ring_get(msgq, data)) {
+			atomic_dec(&msgq->waiters);
+			k_spin_unlock(&msgq->lock, key);
+			return 0;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t left = (int64_t)(end - sys_clock_tick_get());
+
+			if (left <= 0) {
+				atomic_dec(&msgq->waiters);
+				k_spin_unlock(&msgq->lock, key);
+				return -EAGAIN;
+			}
+			timeout = K_TICKS(left);
+		}
+
+		result = z_pend_curr(&msgq->lock, key,
+				     put ? &msgq->put_wait_q : &msgq->wait_q,
+				     timeout);
+		atomic_dec(&msgq->waiters);
+
+		if (result != 0) {
+			return result;
+		}
+	}
+}
+
+static int lockless_put(struct k_msgq *msgq, const void *data,
+			k_timeout_t timeout)
+{
+	int result = 0;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+	if (!ring_put(msgq, data)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = -ENOMSG;
+		} else {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put, msgq, timeout);
+
+			result = lockless_wait(msgq, (void *)data, true, timeout);
+		}
+	}
+
+	if (result == 0) {
+		lockless_wake(msgq, &msgq->wait_q);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+	return result;
+}
+
+static int lockless_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
+{
+	int result = 0;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+	if (!ring_get(msgq, data)) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			result = -ENOMSG;
+		} else {
+			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
+
+			result = lockless_wait(msgq, data, false, timeout);
+		}
+	}
+
+	if (result == 0) {
+		lockless_wake(msgq, &msgq->put_wait_q);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+	return result;
+}
+#endif /* CONFIG_MSGQ_LOCKLESS */
+
 int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
@@ -121,6 +389,12 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (msgq->seq != NULL) {
+		return lockless_put(msgq, data, timeout);
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
@@ -189,7 +463,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_impl_k_msgq_num_used_get(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -211,6 +485,12 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	struct k_thread *pending_thread;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (msgq->seq != NULL) {
+		return lockless_get(msgq, data, timeout);
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
@@ -286,6 +566,16 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 	k_spinlock_key_t key;
 	int result;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (msgq->seq != NULL) {
+		result = ring_peek(msgq, data) ? 0 : -ENOMSG;
+
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, peek, msgq, result);
+
+		return result;
+	}
+#endif
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > 0U) {
@@ -333,6 +623,19 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	msgq->used_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	while ((pending_thread =
+		z_unpend_first_thread(&msgq->put_wait_q)) != NULL) {
+		arch_thread_return_value_set(pending_thread, -ENOMSG);
+		z_ready_thread(pending_thread);
+	}
+
+	if (msgq->seq != NULL) {
+		while (ring_get(msgq, NULL)) {
+		}
+	}
+#endif
+
 	z_reschedule(&msgq->lock, key);
 }
 
@@ -92,6 +92,60 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/* True if the thread is the current thread of some other CPU.  Only
+ * compares pointers, so it is safe on an owner that is concurrently
+ * releasing the mutex or exiting.
+ */
+static bool owner_running(struct k_thread *owner)
+{
+	unsigned int key = arch_irq_lock();
+	int currcpu = _current_cpu->id;
+	bool ret = false;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if ((i != currcpu) && (_kernel.cpus[i].current == owner)) {
+			ret = true;
+			break;
+		}
+	}
+
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+/* Busy waits, without holding the mutex lock, while the mutex is
+ * owned by a thread running on another CPU, up to
+ * CONFIG_MUTEX_SPIN_CYCLES.  This is only a hint: the caller takes
+ * the lock afterwards and pends as usual if the mutex is still held.
+ * The owner's priority is not boosted while spinning, which is fine
+ * as it is running anyway; inheritance kicks in once we pend.
+ */
+static void spin_on_owner(struct k_mutex *mutex)
+{
+	volatile struct k_mutex *m = mutex;
+	struct k_thread *self = _current;
+	uint32_t start = k_cycle_get_32();
+	struct k_thread *owner;
+
+	while (true) {
+		owner = m->owner;
+
+		if ((m->lock_count == 0U) || (owner == self) ||
+		    (owner == NULL) || !owner_running(owner)) {
+			break;
+		}
+
+		if ((k_cycle_get_32() - start) >= CONFIG_MUTEX_SPIN_CYCLES) {
+			break;
+		}
+
+		arch_nop();
+	}
+}
+#endif
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -102,6 +156,12 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		spin_on_owner(mutex);
+	}
+#endif
+
 	key = k_spin_lock(&lock);
 
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
@@ -34,7 +34,7 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
@@ -101,13 +101,27 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* True for a registration belonging to a poll set, which has no
+ * poller thread and is not consumed when signaled.  These are kept at
+ * the head of an object's list, ahead of the priority ordered ones.
+ */
+static inline bool is_set_event(struct k_poll_event *event)
+{
+#ifdef CONFIG_POLL_SET
+	return (event->poller != NULL) && (event->poller->mode == MODE_SET);
+#else
+	ARG_UNUSED(event);
+	return false;
+#endif
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
+	if ((pending == NULL) || is_set_event(pending) ||
 		(z_sched_prio_cmp(poller_thread(pending->poller),
 							   poller_thread(poller)) > 0)) {
 		sys_dlist_append(events, &event->_node);
@@ -115,7 +129,8 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
+		if (!is_set_event(pending) &&
+		    z_sched_prio_cmp(poller_thread(poller),
 					poller_thread(pending->poller)) > 0) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
@@ -443,11 +458,62 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	return retcode;
 }
 
+#ifdef CONFIG_POLL_SET
+/* Flag a poll set registration ready and wake a thread waiting on
+ * the set.  The registration stays on the object's list.
+ *
+ * Invoked with lock held.
+ */
+static void signal_set_event_locked(struct k_poll_event *event,
+				    uint32_t state)
+{
+	struct z_poll_set_entry *entry =
+		CONTAINER_OF(event, struct z_poll_set_entry, event);
+	struct k_poll_set *set =
+		CONTAINER_OF(event->poller, struct k_poll_set, poller);
+
+	event->state |= state;
+	if (!sys_dnode_is_linked(&entry->ready_node)) {
+		sys_dlist_append(&set->ready, &entry->ready_node);
+	}
+
+	(void)z_sched_wake(&set->wait_q, 0, NULL);
+}
+
+/* Remove and return the first one-shot registration on an object's
+ * list, after flagging the poll set registrations ahead of it ready.
+ *
+ * Invoked with lock held.
+ */
+static struct k_poll_event *get_poll_event_locked(sys_dlist_t *events,
+						  uint32_t state)
+{
+	struct k_poll_event *poll_event;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(events, poll_event, _node) {
+		if (!is_set_event(poll_event)) {
+			sys_dlist_remove(&poll_event->_node);
+			return poll_event;
+		}
+		signal_set_event_locked(poll_event, state);
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_POLL_SET */
+
 void z_handle_obj_poll_events(sys_dlist_t *events, uint32_t state)
 {
 	struct k_poll_event *poll_event;
 
+#ifdef CONFIG_POLL_SET
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	poll_event = get_poll_event_locked(events, state);
+	k_spin_unlock(&lock, key);
+#else
 	poll_event = (struct k_poll_event *)sys_dlist_get(events);
+#endif
 	if (poll_event != NULL) {
 		(void) signal_poll_event(poll_event, state);
 	}
@@ -508,9 +574,19 @@ int z_impl_k_poll_signal_raise(struct k_poll_signal *sig, int result)
 	sig->result = result;
 	sig->signaled = 1U;
 
+#ifdef CONFIG_POLL_SET
+	poll_event = get_poll_event_locked(&sig->poll_events,
+					   K_POLL_STATE_SIGNALED);
+#else
 	poll_event = (struct k_poll_event *)sys_dlist_get(&sig->poll_events);
+#endif
 	if (poll_event == NULL) {
+#ifdef CONFIG_POLL_SET
+		/* A thread waiting on a poll set may have been woken */
+		z_reschedule(&lock, key);
+#else
 		k_spin_unlock(&lock, key);
+#endif
 
 		SYS_PORT_TRACING_FUNC(k_poll_api, signal_raise, sig, 0);
 
@@ -786,3 +862,282 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+#ifdef CONFIG_POLL_SET
+
+/* The list of registrations of the object an event refers to, or NULL
+ * if the event type is not one that can be added to a poll set.
+ */
+static sys_dlist_t *set_event_list(struct k_poll_event *event)
+{
+	switch (event->type) {
+	case K_POLL_TYPE_SEM_AVAILABLE:
+		return &event->sem->poll_events;
+	case K_POLL_TYPE_DATA_AVAILABLE:
+		return &event->queue->poll_events;
+	case K_POLL_TYPE_SIGNAL:
+		return &event->signal->poll_events;
+	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
+		return &event->msgq->poll_events;
+	default:
+		return NULL;
+	}
+}
+
+void k_poll_set_init(struct k_poll_set *set,
+		     struct z_poll_set_entry *entries, uint16_t max_events)
+{
+	__ASSERT(entries != NULL || max_events == 0U, "NULL entries\n");
+
+	set->poller.is_polling = false;
+	set->poller.mode = MODE_SET;
+	z_waitq_init(&set->wait_q);
+	sys_dlist_init(&set->ready);
+	(void)memset(entries, 0, max_events * sizeof(*entries));
+	set->entries = entries;
+	set->num_entries = max_events;
+	set->num_used = 0U;
+
+	z_object_init(set);
+}
+
+int z_impl_k_poll_set_add(struct k_poll_set *set, uint32_t type,
+			  void *obj, uint8_t tag)
+{
+	struct z_poll_set_entry *entry = NULL;
+	bool edge = (type & K_POLL_SET_EDGE) != 0U;
+	sys_dlist_t *list;
+	k_spinlock_key_t key;
+	uint32_t state;
+
+	type &= ~K_POLL_SET_EDGE;
+
+	if ((obj == NULL) || (type == K_POLL_TYPE_IGNORE) ||
+	    (type >= BIT(_POLL_NUM_TYPES))) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	for (int i = 0; i < set->num_entries; i++) {
+		if (set->entries[i].event.obj == NULL) {
+			entry = &set->entries[i];
+			break;
+		}
+	}
+
+	if (entry == NULL) {
+		k_spin_unlock(&lock, key);
+		return -ENOMEM;
+	}
+
+	k_poll_event_init(&entry->event, type, K_POLL_MODE_NOTIFY_ONLY, obj);
+
+	list = set_event_list(&entry->event);
+	if (list == NULL) {
+		entry->event.obj = NULL;
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	/* Statically defined sets get their mode on first use */
+	set->poller.mode = MODE_SET;
+	entry->event.tag = tag;
+	entry->event.poller = &set->poller;
+	entry->edge = edge;
+	sys_dlist_prepend(list, &entry->event._node);
+	set->num_used++;
+
+	if (is_condition_met(&entry->event, &state)) {
+		signal_set_event_locked(&entry->event, state);
+	}
+
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_poll_set_add(struct k_poll_set *set,
+					uint32_t type, void *obj, uint8_t tag)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(set, K_OBJ_POLL_SET));
+
+	switch (type & ~K_POLL_SET_EDGE) {
+	case K_POLL_TYPE_SIGNAL:
+		Z_OOPS(Z_SYSCALL_OBJ(obj, K_OBJ_POLL_SIGNAL));
+		break;
+	case K_POLL_TYPE_SEM_AVAILABLE:
+		Z_OOPS(Z_SYSCALL_OBJ(obj, K_OBJ_SEM));
+		break;
+	case K_POLL_TYPE_DATA_AVAILABLE:
+		Z_OOPS(Z_SYSCALL_OBJ(obj, K_OBJ_QUEUE));
+		break;
+	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
+		Z_OOPS(Z_SYSCALL_OBJ(obj, K_OBJ_MSGQ));
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return z_impl_k_poll_set_add(set, type, obj, tag);
+}
+#include <syscalls/k_poll_set_add_mrsh.c>
+#endif
+
+int z_impl_k_poll_set_remove(struct k_poll_set *set, void *obj)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	for (int i = 0; i < set->num_entries; i++) {
+		struct z_poll_set_entry *entry = &set->entries[i];
+
+		if ((obj == NULL) || (entry->event.obj != obj)) {
+			continue;
+		}
+
+		sys_dlist_remove(&entry->event._node);
+		if (sys_dnode_is_linked(&entry->ready_node)) {
+			sys_dlist_remove(&entry->ready_node);
+		}
+		entry->event.poller = NULL;
+		entry->event.obj = NULL;
+		set->num_used--;
+
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return -ENOENT;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_poll_set_remove(struct k_poll_set *set, void *obj)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(set, K_OBJ_POLL_SET));
+	return z_impl_k_poll_set_remove(set, obj);
+}
+#include <syscalls/k_poll_set_remove_mrsh.c>
+#endif
+
+/* Copy out up to max ready registrations.  Entries whose object is no
+ * longer available are dropped from the ready list; the ones reported
+ * are moved to its tail so a small @a max doesn't starve the others.
+ * Edge triggered entries are only reported if signaled since the last
+ * time, and leave the ready list once reported.
+ *
+ * Invoked with lock held.
+ */
+static int collect_ready_locked(struct k_poll_set *set,
+				struct k_poll_event *ready, int max)
+{
+	sys_dlist_t reported;
+	sys_dnode_t *node, *next;
+	int count = 0;
+
+	sys_dlist_init(&reported);
+
+	SYS_DLIST_FOR_EACH_NODE_SAFE(&set->ready, node, next) {
+		struct z_poll_set_entry *entry =
+			CONTAINER_OF(node, struct z_poll_set_entry, ready_node);
+		struct k_poll_event *event = &entry->event;
+		bool signaled = event->state != K_POLL_STATE_NOT_READY;
+		uint32_t state = 0U;
+		bool met;
+
+		if (count == max) {
+			break;
+		}
+
+		met = is_condition_met(event, &state);
+
+		/* Cancellation is not a level, report it once */
+		if ((event->state & K_POLL_STATE_CANCELLED) != 0U) {
+			state |= K_POLL_STATE_CANCELLED;
+			met = true;
+		}
+		event->state = K_POLL_STATE_NOT_READY;
+
+		sys_dlist_remove(node);
+
+		if (!met || (entry->edge && !signaled)) {
+			continue;
+		}
+
+		ready[count] = *event;
+		sys_dnode_init(&ready[count]._node);
+		ready[count].poller = NULL;
+		ready[count].state = state;
+		count++;
+
+		if (!entry->edge) {
+			sys_dlist_append(&reported, node);
+		}
+	}
+
+	while ((node = sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&set->ready, node);
+	}
+
+	return count;
+}
+
+int z_impl_k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event *ready, int max,
+			   k_timeout_t timeout)
+{
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "");
+
+	if ((ready == NULL) || (max <= 0)) {
+		return -EINVAL;
+	}
+
+	for (;;) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		ret = collect_ready_locked(set, ready, max);
+		if (ret > 0) {
+			k_spin_unlock(&lock, key);
+			return ret;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t left = (int64_t)(end - sys_clock_tick_get());
+
+			if (left <= 0) {
+				k_spin_unlock(&lock, key);
+				return -EAGAIN;
+			}
+			timeout = K_TICKS(left);
+		}
+
+		ret = z_pend_curr(&lock, key, &set->wait_q, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_poll_set_wait(struct k_poll_set *set,
+					 struct k_poll_event *ready, int max,
+					 k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(set, K_OBJ_POLL_SET));
+	if (Z_SYSCALL_VERIFY(max > 0)) {
+		return -EINVAL;
+	}
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(ready, max,
+					    sizeof(struct k_poll_event)));
+
+	return z_impl_k_poll_set_wait(set, ready, max, timeout);
+}
+#include <syscalls/k_poll_set_wait_mrsh.c>
+#endif
+
+#endif /* CONFIG_POLL_SET */
@@ -37,22 +37,29 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 #define _priq_run_add		z_priq_mq_add
 #define _priq_run_remove	z_priq_mq_remove
 #define _priq_run_best		z_priq_mq_best
-static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
-					struct k_thread *thread);
-static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
-					   struct k_thread *thread);
 #endif
 
 #if defined(CONFIG_WAITQ_SCALABLE)
 #define z_priq_wait_add		z_priq_rb_add
 #define _priq_wait_remove	z_priq_rb_remove
 #define _priq_wait_best		z_priq_rb_best
+#elif defined(CONFIG_WAITQ_MULTIQ)
+#define z_priq_wait_add		z_priq_mq_add
+#define _priq_wait_remove	z_priq_mq_remove
+#define _priq_wait_best		z_priq_mq_best
 #elif defined(CONFIG_WAITQ_DUMB)
 #define z_priq_wait_add		z_priq_dumb_add
 #define _priq_wait_remove	z_priq_dumb_remove
 #define _priq_wait_best		z_priq_dumb_best
 #endif
 
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_WAITQ_MULTIQ)
+static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
+					struct k_thread *thread);
+static ALWAYS_INLINE void z_priq_mq_remove(struct _priq_mq *pq,
+					   struct k_thread *thread);
+#endif
+
 struct k_spinlock sched_spinlock;
 
 static void update_cache(int preempt_ok);
@@ -583,7 +590,11 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
-static void ready_thread(struct k_thread *thread)
+/* Adds a thread to the run queue without refreshing the cache or
+ * notifying other CPUs, so callers readying several threads at once
+ * only need to do that once.  Returns true if the thread was queued.
+ */
+static bool queue_ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
 	__ASSERT_NO_MSG(arch_mem_coherent(thread));
@@ -596,6 +607,15 @@ static void ready_thread(struct k_thread *thread)
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
 		queue_thread(thread);
+		return true;
+	}
+
+	return false;
+}
+
+static void ready_thread(struct k_thread *thread)
+{
+	if (queue_ready_thread(thread)) {
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
 		arch_sched_ipi();
@@ -872,6 +892,17 @@ bool z_set_prio(struct k_thread *thread, int prio)
 				thread->base.prio = prio;
 			}
 			update_cache(1);
+#ifdef CONFIG_WAITQ_MULTIQ
+		} else if (thread->base.pended_on != NULL) {
+			/* Wait queue lists are per priority, so a pended
+			 * thread has to move to its new list
+			 */
+			_wait_q_t *wait_q = pended_on_thread(thread);
+
+			_priq_wait_remove(&wait_q->waitq, thread);
+			thread->base.prio = prio;
+			z_priq_wait_add(&wait_q->waitq, thread);
+#endif
 		} else {
 			thread->base.prio = prio;
 		}
@@ -1132,7 +1163,7 @@ struct k_thread *z_priq_rb_best(struct _priq_rb *pq)
 	return thread;
 }
 
-#ifdef CONFIG_SCHED_MULTIQ
+#if defined(CONFIG_SCHED_MULTIQ) || defined(CONFIG_WAITQ_MULTIQ)
 # if (K_LOWEST_THREAD_PRIO - K_HIGHEST_THREAD_PRIO) > 31
 # error Too many priorities for multiqueue scheduler (max 32)
 # endif
@@ -1142,6 +1173,13 @@ static ALWAYS_INLINE void z_priq_mq_add(struct _priq_mq *pq,
 {
 	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
 
+	/* Lists are only valid while their bit is set, which lets a
+	 * zeroed struct (e.g. Z_WAIT_Q_INIT()) be an empty queue
+	 */
+	if ((pq->bitmask & BIT(priority_bit)) == 0U) {
+		sys_dlist_init(&pq->queues[priority_bit]);
+	}
+
 	sys_dlist_append(&pq->queues[priority_bit], &thread->base.qnode_dlist);
 	pq->bitmask |= BIT(priority_bit);
 }
@@ -1174,15 +1212,47 @@ struct k_thread *z_priq_mq_best(struct _priq_mq *pq)
 	return thread;
 }
 
+struct k_thread *z_priq_mq_next(struct _priq_mq *pq, struct k_thread *thread)
+{
+	int priority_bit = thread->base.prio - K_HIGHEST_THREAD_PRIO;
+	sys_dnode_t *n = sys_dlist_peek_next(&pq->queues[priority_bit],
+					     &thread->base.qnode_dlist);
+
+	if (n == NULL) {
+		unsigned int rest = pq->bitmask &
+			~(BIT(priority_bit) | (BIT(priority_bit) - 1U));
+
+		if (rest == 0U) {
+			return NULL;
+		}
+		n = sys_dlist_peek_head(&pq->queues[__builtin_ctz(rest)]);
+	}
+
+	return CONTAINER_OF(n, struct k_thread, base.qnode_dlist);
+}
+
 int z_unpend_all(_wait_q_t *wait_q)
 {
 	int need_sched = 0;
+	bool queued = false;
 	struct k_thread *thread;
 
-	while ((thread = z_waitq_head(wait_q)) != NULL) {
-		z_unpend_thread(thread);
-		z_ready_thread(thread);
-		need_sched = 1;
+	LOCKED(&sched_spinlock) {
+		while ((thread = _priq_wait_best(&wait_q->waitq)) != NULL) {
+			unpend_thread_no_timeout(thread);
+			(void)z_abort_thread_timeout(thread);
+			if (!thread_active_elsewhere(thread)) {
+				queued |= queue_ready_thread(thread);
+			}
+			need_sched = 1;
+		}
+
+		if (queued) {
+			update_cache(0);
+#if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
+			arch_sched_ipi();
+#endif
+		}
 	}
 
 	return need_sched;
@@ -1789,6 +1859,41 @@ bool z_sched_wake(_wait_q_t *wait_q, int swap_retval, void *swap_data)
 	return ret;
 }
 
+unsigned int z_sched_wake_n(_wait_q_t *wait_q, int swap_retval,
+			    void *swap_data, unsigned int n)
+{
+	struct k_thread *thread;
+	unsigned int woken = 0U;
+	bool queued = false;
+
+	LOCKED(&sched_spinlock) {
+		while (woken < n) {
+			thread = _priq_wait_best(&wait_q->waitq);
+			if (thread == NULL) {
+				break;
+			}
+
+			z_thread_return_value_set_with_data(thread,
+							    swap_retval,
+							    swap_data);
+			unpend_thread_no_timeout(thread);
+			(void)z_abort_thread_timeout(thread);
+			queued |= queue_ready_thread(thread);
+			woken++;
+		}
+
+		/* One cache update and one IPI for the whole batch */
+		if (queued) {
+			update_cache(0);
+#if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
+			arch_sched_ipi();
+#endif
+		}
+	}
+
+	return woken;
+}
+
 int z_sched_wait(struct k_spinlock *lock, k_spinlock_key_t key,
 		 _wait_q_t *wait_q, k_timeout_t timeout, void **data)
 {
@@ -114,6 +114,30 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 #include <syscalls/k_sem_give_mrsh.c>
 #endif
 
+void z_impl_k_sem_give_n(struct k_sem *sem, unsigned int count)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	unsigned int woken;
+
+	woken = z_sched_wake_n(&sem->wait_q, 0, NULL, count);
+
+	if (woken < count) {
+		sem->count += MIN(sem->limit - sem->count, count - woken);
+		handle_poll_events(sem);
+	}
+
+	z_reschedule(&lock, key);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline void z_vrfy_k_sem_give_n(struct k_sem *sem, unsigned int count)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(sem, K_OBJ_SEM));
+	z_impl_k_sem_give_n(sem, count);
+}
+#include <syscalls/k_sem_give_n_mrsh.c>
+#endif
+
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
 	int ret = 0;
@@ -150,17 +174,9 @@ out:
 
 void z_impl_k_sem_reset(struct k_sem *sem)
 {
-	struct k_thread *thread;
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	while (true) {
-		thread = z_unpend_first_thread(&sem->wait_q);
-		if (thread == NULL) {
-			break;
-		}
-		arch_thread_return_value_set(thread, -EAGAIN);
-		z_ready_thread(thread);
-	}
+	(void)z_sched_wake_all(&sem->wait_q, -EAGAIN, NULL);
 	sem->count = 0;
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, reset, sem);
@@ -11,11 +11,10 @@
 #include <syscall_handler.h>
 #include <drivers/timer/system_timer.h>
 #include <sys_clock.h>
+#include <sys/math_extras.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -36,6 +35,196 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/* Hierarchical timing wheel.  In this mode the dticks field of a
+ * queued timeout holds its absolute expiry tick instead of a delta
+ * from its predecessor.
+ *
+ * Level L covers expiries that share all bits above bit
+ * WHEEL_SHIFT(L + 1) with curr_tick, indexed by the WHEEL_BITS wide
+ * field at WHEEL_SHIFT(L).  So level 0 is a ring of single-tick
+ * buckets for the current block, and every entry on level L expires
+ * after every entry on the levels below it.  Anything further out
+ * than the top level goes onto the unsorted overflow list.  When
+ * curr_tick moves into a new slot of a higher level, that slot is
+ * "cascaded" down by re-inserting its entries.
+ *
+ * Entries with the same expiry stay in insertion order, matching the
+ * FIFO behavior of the list backend.  A bit in wheel.pending marks a
+ * non-empty slot; the list heads of clear slots are not valid and get
+ * initialized on first use, so no init hook is needed.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SHIFT(l) ((l) * WHEEL_BITS)
+#define WHEEL_IDX(t, l) (((t) >> WHEEL_SHIFT(l)) & (WHEEL_SLOTS - 1))
+
+static struct {
+	sys_dlist_t slots[WHEEL_LEVELS][WHEEL_SLOTS];
+	uint64_t pending[WHEEL_LEVELS];
+	sys_dlist_t overflow;
+
+	/* Cached result of first(), NULL when unknown */
+	struct _timeout *first;
+} wheel = {
+	.overflow = SYS_DLIST_STATIC_INIT(&wheel.overflow),
+};
+
+/* Returns the level whose window holds the expiry relative to
+ * curr_tick, or WHEEL_LEVELS for the overflow list.
+ */
+static int wheel_level(uint64_t expiry)
+{
+	int l;
+
+	for (l = 0; l < WHEEL_LEVELS; l++) {
+		if ((expiry >> WHEEL_SHIFT(l + 1)) ==
+		    (curr_tick >> WHEEL_SHIFT(l + 1))) {
+			break;
+		}
+	}
+
+	return l;
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	uint64_t expiry = to->dticks;
+	int l = wheel_level(expiry);
+
+	if (l == WHEEL_LEVELS) {
+		sys_dlist_append(&wheel.overflow, &to->node);
+	} else {
+		int idx = WHEEL_IDX(expiry, l);
+
+		if ((wheel.pending[l] & BIT64(idx)) == 0U) {
+			sys_dlist_init(&wheel.slots[l][idx]);
+			wheel.pending[l] |= BIT64(idx);
+		}
+		sys_dlist_append(&wheel.slots[l][idx], &to->node);
+	}
+}
+
+static struct _timeout *earliest(sys_dlist_t *list)
+{
+	struct _timeout *t, *ret = NULL;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(list, t, node) {
+		if (ret == NULL || t->dticks < ret->dticks) {
+			ret = t;
+		}
+	}
+
+	return ret;
+}
+
+static struct _timeout *first(void)
+{
+	if (wheel.first != NULL) {
+		return wheel.first;
+	}
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		if (wheel.pending[l] != 0U) {
+			int idx = u64_count_trailing_zeros(wheel.pending[l]);
+			sys_dlist_t *slot = &wheel.slots[l][idx];
+
+			/* Level 0 slots hold a single expiry value */
+			if (l == 0) {
+				wheel.first = CONTAINER_OF(sys_dlist_peek_head(slot),
+							   struct _timeout, node);
+			} else {
+				wheel.first = earliest(slot);
+			}
+			return wheel.first;
+		}
+	}
+
+	wheel.first = earliest(&wheel.overflow);
+	return wheel.first;
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	uint64_t expiry = t->dticks;
+	int l = wheel_level(expiry);
+
+	if (t == wheel.first) {
+		wheel.first = NULL;
+	}
+
+	sys_dlist_remove(&t->node);
+
+	if (l < WHEEL_LEVELS) {
+		int idx = WHEEL_IDX(expiry, l);
+
+		if (sys_dlist_is_empty(&wheel.slots[l][idx])) {
+			wheel.pending[l] &= ~BIT64(idx);
+		}
+	}
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t ticks)
+{
+	to->dticks = curr_tick + MAX(1, ticks);
+	wheel_insert(to);
+
+	if (wheel.first != NULL && to->dticks < wheel.first->dticks) {
+		wheel.first = to;
+	}
+}
+
+static void wheel_cascade(sys_dlist_t *list)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+	}
+}
+
+/* Moves curr_tick forward.  Must never step past the first expiry. */
+static void advance(k_ticks_t ticks)
+{
+	uint64_t prev = curr_tick;
+
+	curr_tick += ticks;
+
+	if ((prev >> WHEEL_SHIFT(WHEEL_LEVELS)) !=
+	    (curr_tick >> WHEEL_SHIFT(WHEEL_LEVELS))) {
+		struct _timeout *t, *tmp;
+
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&wheel.overflow, t, tmp, node) {
+			if (wheel_level(t->dticks) < WHEEL_LEVELS) {
+				sys_dlist_remove(&t->node);
+				wheel_insert(t);
+			}
+		}
+	}
+
+	for (int l = WHEEL_LEVELS - 1; l > 0; l--) {
+		int idx = WHEEL_IDX(curr_tick, l);
+
+		if ((prev >> WHEEL_SHIFT(l)) != (curr_tick >> WHEEL_SHIFT(l)) &&
+		    (wheel.pending[l] & BIT64(idx)) != 0U) {
+			wheel.pending[l] &= ~BIT64(idx);
+			wheel_cascade(&wheel.slots[l][idx]);
+		}
+	}
+}
+
+/* Ticks from curr_tick until the timeout expires, must be locked */
+static k_ticks_t timeout_ticks(const struct _timeout *timeout)
+{
+	return timeout->dticks - curr_tick;
+}
+
+#else /* !CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,6 +248,52 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static void insert_timeout(struct _timeout *to, k_ticks_t ticks)
+{
+	struct _timeout *t;
+
+	to->dticks = ticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
+static void advance(k_ticks_t ticks)
+{
+	if (first() != NULL) {
+		first()->dticks -= ticks;
+	}
+
+	curr_tick += ticks;
+}
+
+/* Ticks from curr_tick until the timeout expires, must be locked */
+static k_ticks_t timeout_ticks(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
@@ -71,10 +306,10 @@ static int32_t next_timeout(void)
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_ticks(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_ticks(to) - ticks_elapsed);
 	}
 
 #ifdef CONFIG_TIMESLICING
@@ -100,29 +335,17 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t ticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
-			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
-
-			to->dticks = MAX(1, ticks);
+			ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
+			ticks = MAX(1, ticks);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
+			ticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to, ticks);
 
 		if (to == first()) {
 #if CONFIG_TIMESLICING
@@ -164,20 +387,11 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
-
 	if (z_is_inactive_timeout(timeout)) {
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
+	return timeout_ticks(timeout) - elapsed();
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -246,13 +460,13 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
+	while (first() != NULL &&
+	       timeout_ticks(first()) <= announce_remaining) {
 		struct _timeout *t = first();
-		int dt = t->dticks;
+		int dt = timeout_ticks(t);
 
-		curr_tick += dt;
+		advance(dt);
 		announce_remaining -= dt;
-		t->dticks = 0;
 		remove_timeout(t);
 
 		k_spin_unlock(&timeout_lock, key);
@@ -260,11 +474,7 @@ void sys_clock_announce(int32_t ticks)
 		key = k_spin_lock(&timeout_lock);
 	}
 
-	if (first() != NULL) {
-		first()->dticks -= announce_remaining;
-	}
-
-	curr_tick += announce_remaining;
+	advance(announce_remaining);
 	announce_remaining = 0;
 
 	sys_clock_set_timeout(next_timeout(), false);
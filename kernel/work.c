@@ -131,6 +131,122 @@ static void finalize_cancel_locked(struct k_work *work)
 	}
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* List of pending flushes of work items on queues with more than one
+ * thread.
+ */
+static sys_slist_t pending_flushes;
+
+/* Release everything waiting for a work item to go idle.
+ *
+ * On a queue with more than one thread a flusher can't simply be
+ * queued behind the work item, as another thread could run it while
+ * the item is still running.  Flushers for those queues wait on this
+ * list instead, until the item is neither queued nor running.
+ *
+ * Invoked with work lock held.
+ *
+ * @param work the work structure that has become idle
+ */
+static void finalize_flush_locked(struct k_work *work)
+{
+	struct z_work_flusher *wf, *tmp;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&pending_flushes, wf, tmp, work.node) {
+		if (wf->target == work) {
+			sys_slist_remove(&pending_flushes, prev, &wf->work.node);
+			k_sem_give(&wf->sem);
+		} else {
+			prev = &wf->work.node;
+		}
+	}
+}
+
+/* Test whether the current thread is one of a queue's threads.
+ *
+ * Invoked with work lock held.
+ */
+static bool queue_is_worker_locked(struct k_work_q *queue)
+{
+	struct k_work_q_worker *worker;
+
+	if (_current == &queue->thread) {
+		return true;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&queue->workers, worker, node) {
+		if (_current == &worker->thread) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Remove the first pending work item that is not running.
+ *
+ * An item resubmitted while its handler runs on one thread of a pool
+ * must not be started by another, so it is skipped and left for the
+ * thread that is running it to pick up when the handler returns.
+ *
+ * Invoked with work lock held.
+ */
+static sys_snode_t *queue_get_locked(struct k_work_q *queue)
+{
+	sys_snode_t *node, *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_NODE(&queue->pending, node) {
+		struct k_work *work = CONTAINER_OF(node, struct k_work, node);
+
+		if (!flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+			sys_slist_remove(&queue->pending, prev, node);
+			return node;
+		}
+		prev = node;
+	}
+
+	return NULL;
+}
+#else
+static inline bool queue_is_worker_locked(struct k_work_q *queue)
+{
+	return _current == &queue->thread;
+}
+
+static inline sys_snode_t *queue_get_locked(struct k_work_q *queue)
+{
+	return sys_slist_get(&queue->pending);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
+/* Account for a work item starting to run on one of a queue's threads.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_active_inc_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	queue->active++;
+#endif
+	flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
+/* Account for a work item that finished running on one of a queue's
+ * threads.  The queue stays busy until all of its threads are done.
+ *
+ * Invoked with work lock held.
+ */
+static inline void queue_active_dec_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (--queue->active != 0U) {
+		return;
+	}
+#endif
+	flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+}
+
 void k_work_init(struct k_work *work,
 		  k_work_handler_t handler)
 {
@@ -204,6 +320,11 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (!flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+			finalize_flush_locked(work);
+		}
+#endif
 	}
 }
 
@@ -256,7 +377,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = !k_is_in_isr() && queue_is_worker_locked(queue);
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -419,6 +540,15 @@ static bool work_flush_locked(struct k_work *work,
 
 		__ASSERT_NO_MSG(queue != NULL);
 
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (!sys_slist_is_empty(&queue->workers)) {
+			init_flusher(flusher);
+			flusher->target = work;
+			sys_slist_append(&pending_flushes, &flusher->work.node);
+			return need_flush;
+		}
+#endif
+
 		queue_flusher_locked(queue, work, flusher);
 		notify_queue_locked(queue);
 	}
@@ -589,12 +719,12 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		bool yield;
 
 		/* Check for and prepare any new work. */
-		node = sys_slist_get(&queue->pending);
+		node = queue_get_locked(queue);
 		if (node != NULL) {
 			/* Mark that there's some work active that's
 			 * not on the pending list.
 			 */
-			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			queue_active_inc_locked(queue);
 			work = CONTAINER_OF(node, struct k_work, node);
 			flag_set(&work->flags, K_WORK_RUNNING_BIT);
 			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
@@ -612,8 +742,10 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * This means that if node is not NULL, then work will not be NULL.
 			 */
 			handler = work->handler;
-		} else if (flag_test_and_clear(&queue->flags,
-					       K_WORK_QUEUE_DRAIN_BIT)) {
+		} else if (!flag_test(&queue->flags, K_WORK_QUEUE_BUSY_BIT)
+			   && sys_slist_is_empty(&queue->pending)
+			   && flag_test_and_clear(&queue->flags,
+						  K_WORK_QUEUE_DRAIN_BIT)) {
 			/* Not busy and draining: move threads waiting for
 			 * drain to ready state.  The held spinlock inhibits
 			 * immediate reschedule; released threads get their
@@ -659,8 +791,13 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
 			finalize_cancel_locked(work);
 		}
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (!flag_test(&work->flags, K_WORK_QUEUED_BIT)) {
+			finalize_flush_locked(work);
+		}
+#endif
 
-		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		queue_active_dec_locked(queue);
 		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
 		k_spin_unlock(&lock, key);
 
@@ -700,6 +837,10 @@ void k_work_queue_start(struct k_work_q *queue,
 	sys_slist_init(&queue->pending);
 	z_waitq_init(&queue->notifyq);
 	z_waitq_init(&queue->drainq);
+#ifdef CONFIG_WORKQUEUE_POOL
+	sys_slist_init(&queue->workers);
+	queue->active = 0U;
+#endif
 
 	if ((cfg != NULL) && cfg->no_yield) {
 		flags |= K_WORK_QUEUE_NO_YIELD;
@@ -724,6 +865,55 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+int k_work_queue_worker_add(struct k_work_q *queue,
+			    struct k_work_q_worker *worker,
+			    k_thread_stack_t *stack,
+			    size_t stack_size,
+			    int prio,
+			    int cpu)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(worker);
+	__ASSERT_NO_MSG(stack);
+	__ASSERT_NO_MSG(flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+
+	if (cpu >= CONFIG_MP_NUM_CPUS) {
+		return -EINVAL;
+	}
+
+	if ((cpu >= 0) && !IS_ENABLED(CONFIG_SCHED_CPU_MASK)) {
+		return -ENOTSUP;
+	}
+
+	(void)k_thread_create(&worker->thread, stack, stack_size,
+			      work_queue_main, queue, NULL, NULL,
+			      prio, 0, K_FOREVER);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+	if (cpu >= 0) {
+		(void)k_thread_cpu_mask_clear(&worker->thread);
+		(void)k_thread_cpu_mask_enable(&worker->thread, cpu);
+	}
+#endif
+
+#ifdef CONFIG_THREAD_NAME
+	k_thread_name_set(&worker->thread,
+			  k_thread_name_get(&queue->thread));
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	sys_slist_append(&queue->workers, &worker->node);
+
+	k_spin_unlock(&lock, key);
+
+	k_thread_start(&worker->thread);
+
+	return 0;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
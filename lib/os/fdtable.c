@@ -266,6 +266,8 @@ int close(int fd)
 		return -1;
 	}
 
+	z_epoll_fd_close(fd);
+
 	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
 
 	res = fdtable[fd].vtable->close(fdtable[fd].obj);
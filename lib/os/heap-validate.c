@@ -83,7 +83,42 @@ static void get_alloc_info(struct z_heap *h, size_t *alloc_bytes,
 			*free_bytes += chunksz_to_bytes(h, chunk_size(h, c));
 		}
 	}
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	/* Chunks parked in the size classes are marked used but are
+	 * available memory
+	 */
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		size_t parked = h->size_classes[i].count *
+				chunksz_to_bytes(h, i + 1);
+
+		*alloc_bytes -= parked;
+		*free_bytes += parked;
+	}
+#endif
+}
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+static bool valid_size_classes(struct z_heap *h)
+{
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		struct z_heap_size_class *sc = &h->size_classes[i];
+		uint32_t n = 0;
+
+		VALIDATE(sc->count <= CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH);
+
+		for (chunkid_t c = sc->next; c != 0; c = next_free_chunk(h, c)) {
+			VALIDATE(n++ < sc->count);
+			VALIDATE(valid_chunk(h, c));
+			VALIDATE(chunk_used(h, c));
+			VALIDATE(chunk_size(h, c) == i + 1);
+		}
+
+		VALIDATE(n == sc->count);
+	}
+	return true;
 }
+#endif
 
 bool sys_heap_validate(struct sys_heap *heap)
 {
@@ -102,6 +137,12 @@ bool sys_heap_validate(struct sys_heap *heap)
 		return false;  /* Should have exactly consumed the buffer */
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (!valid_size_classes(h)) {
+		return false;
+	}
+#endif
+
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	/*
 	 * Validate sys_heap_runtime_stats_get API.
@@ -379,6 +420,17 @@ void heap_print_info(struct z_heap *h, bool dump_chunks)
 		}
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	printk("\nSize classes: %u hits, %u misses\n",
+	       h->size_class_hits, h->size_class_misses);
+	for (i = 0; i < SIZE_CLASS_COUNT; i++) {
+		if (h->size_classes[i].count) {
+			printk("%9d units %12u parked\n",
+			       i + 1, h->size_classes[i].count);
+		}
+	}
+#endif
+
 	if (dump_chunks) {
 		printk("\nChunk dump:\n");
 		for (chunkid_t c = 0; ; c = right_chunk(h, c)) {
@@ -137,6 +137,92 @@ static void free_chunk(struct z_heap *h, chunkid_t c)
 	free_list_add(h, c);
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Size class front end.  Small chunks are parked on an exact-size
+ * LIFO when freed instead of being merged back into the buckets, so
+ * a later request for the same size is a single pop with no bucket
+ * search and no split.  The parked chunks stay marked used, which
+ * keeps free_chunk() from merging into them.  Each class is bounded
+ * to CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH entries, and everything parked
+ * is returned to the buckets if the main allocator ever runs dry, so
+ * the front end never makes an allocation fail that would otherwise
+ * have succeeded.
+ */
+static bool size_class_push(struct z_heap *h, chunkid_t c)
+{
+	chunksz_t sz = chunk_size(h, c);
+
+	if (sz > size_class_max_chunks(h)) {
+		return false;
+	}
+
+	struct z_heap_size_class *sc = &h->size_classes[sz - 1];
+
+	if (sc->count >= CONFIG_SYS_HEAP_SIZE_CLASS_DEPTH) {
+		return false;
+	}
+
+	set_next_free_chunk(h, c, sc->next);
+	sc->next = c;
+	sc->count++;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes += chunksz_to_bytes(h, sz);
+#endif
+	return true;
+}
+
+static chunkid_t size_class_pop(struct z_heap *h, chunksz_t sz)
+{
+	struct z_heap_size_class *sc = &h->size_classes[sz - 1];
+	chunkid_t c = sc->next;
+
+	if (c == 0U) {
+		h->size_class_misses++;
+		return 0;
+	}
+
+	CHECK(chunk_used(h, c) && chunk_size(h, c) == sz);
+
+	sc->next = next_free_chunk(h, c);
+	sc->count--;
+	h->size_class_hits++;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	h->free_bytes -= chunksz_to_bytes(h, sz);
+#endif
+	return c;
+}
+
+/* Hands every parked chunk back to the main allocator.  Returns
+ * false if there was nothing to release.
+ */
+static bool size_class_flush(struct z_heap *h)
+{
+	bool flushed = false;
+
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		struct z_heap_size_class *sc = &h->size_classes[i];
+
+		while (sc->next != 0U) {
+			chunkid_t c = sc->next;
+
+			sc->next = next_free_chunk(h, c);
+			sc->count--;
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+			h->free_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
+#endif
+			set_chunk_used(h, c, false);
+			free_chunk(h, c);
+			flushed = true;
+		}
+	}
+
+	return flushed;
+}
+#endif
+
 /*
  * Return the closest chunk ID corresponding to given memory pointer.
  * Here "closest" is only meaningful in the context of sys_heap_aligned_alloc()
@@ -173,7 +259,6 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 		 "corrupted heap bounds (buffer overflow?) for memory at %p",
 		 mem);
 
-	set_chunk_used(h, c, false);
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->allocated_bytes -= chunksz_to_bytes(h, chunk_size(h, c));
 #endif
@@ -183,6 +268,13 @@ void sys_heap_free(struct sys_heap *heap, void *mem)
 				  chunksz_to_bytes(h, chunk_size(h, c)));
 #endif
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (size_class_push(h, c)) {
+		return;
+	}
+#endif
+
+	set_chunk_used(h, c, false);
 	free_chunk(h, c);
 }
 
@@ -259,7 +351,32 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 	}
 
 	chunksz_t chunk_sz = bytes_to_chunksz(h, bytes);
-	chunkid_t c = alloc_chunk(h, chunk_sz);
+	chunkid_t c;
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (chunk_sz <= size_class_max_chunks(h)) {
+		c = size_class_pop(h, chunk_sz);
+
+#ifdef CONFIG_SYS_HEAP_LISTENER
+		heap_listener_notify_size_class(HEAP_ID_FROM_POINTER(heap),
+						h->size_class_hits,
+						h->size_class_misses);
+#endif
+
+		if (c != 0U) {
+			goto out;
+		}
+	}
+#endif
+
+	c = alloc_chunk(h, chunk_sz);
+
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (c == 0U && size_class_flush(h)) {
+		c = alloc_chunk(h, chunk_sz);
+	}
+#endif
+
 	if (c == 0U) {
 		return NULL;
 	}
@@ -272,6 +389,9 @@ void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 
 	set_chunk_used(h, c, true);
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+out:
+#endif
 	mem = chunk_mem(h, c);
 
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
@@ -323,6 +443,12 @@ void *sys_heap_aligned_alloc(struct sys_heap *heap, size_t align, size_t bytes)
 	chunksz_t padded_sz = bytes_to_chunksz(h, bytes + align - gap);
 	chunkid_t c0 = alloc_chunk(h, padded_sz);
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	if (c0 == 0 && size_class_flush(h)) {
+		c0 = alloc_chunk(h, padded_sz);
+	}
+#endif
+
 	if (c0 == 0) {
 		return NULL;
 	}
@@ -510,6 +636,15 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 		h->buckets[i].next = 0;
 	}
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	h->size_class_hits = 0;
+	h->size_class_misses = 0;
+	for (int i = 0; i < SIZE_CLASS_COUNT; i++) {
+		h->size_classes[i].next = 0;
+		h->size_classes[i].count = 0;
+	}
+#endif
+
 	/* chunk containing our struct z_heap */
 	set_chunk_size(h, 0, chunk0_size);
 	set_left_chunk_size(h, 0, 0);
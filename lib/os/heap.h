@@ -65,6 +65,24 @@ struct z_heap_bucket {
 	chunkid_t next;
 };
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Enough classes to cover CONFIG_SYS_HEAP_SIZE_CLASS_MAX bytes plus
+ * the biggest (8 byte) chunk header.  Class N holds chunks of exactly
+ * N + 1 units.
+ */
+#define SIZE_CLASS_COUNT \
+	((CONFIG_SYS_HEAP_SIZE_CLASS_MAX + 8 + CHUNK_UNIT - 1) / CHUNK_UNIT)
+
+/* LIFO of chunks that were freed but left marked used, linked
+ * through their FREE_NEXT field.  They are never split or merged
+ * while on the list.
+ */
+struct z_heap_size_class {
+	chunkid_t next;
+	uint32_t count;
+};
+#endif
+
 struct z_heap {
 	chunkid_t chunk0_hdr[2];
 	chunkid_t end_chunk;
@@ -72,6 +90,11 @@ struct z_heap {
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	size_t free_bytes;
 	size_t allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+	uint32_t size_class_hits;
+	uint32_t size_class_misses;
+	struct z_heap_size_class size_classes[SIZE_CLASS_COUNT];
 #endif
 	struct z_heap_bucket buckets[0];
 };
@@ -261,6 +284,14 @@ static inline bool size_too_big(struct z_heap *h, size_t bytes)
 	return (bytes / CHUNK_UNIT) >= h->end_chunk;
 }
 
+#ifdef CONFIG_SYS_HEAP_SIZE_CLASSES
+/* Largest chunk size handled by the size class front end */
+static inline chunksz_t size_class_max_chunks(struct z_heap *h)
+{
+	return bytes_to_chunksz(h, CONFIG_SYS_HEAP_SIZE_CLASS_MAX);
+}
+#endif
+
 /* For debugging */
 void heap_print_info(struct z_heap *h, bool dump_chunks);
 
@@ -5,16 +5,25 @@
  */
 
 #include <spinlock.h>
+#include <sys/atomic.h>
 #include <sys/heap_listener.h>
 
 static struct k_spinlock heap_listener_lock;
 static sys_slist_t heap_listener_list = SYS_SLIST_STATIC_INIT(&heap_listener_list);
 
+/* Size class events are raised on every small allocation, so keep a count
+ * of interested listeners and skip the lock when there are none.
+ */
+static atomic_t size_class_listeners;
+
 void heap_listener_register(struct heap_listener *listener)
 {
 	k_spinlock_key_t key = k_spin_lock(&heap_listener_lock);
 
 	sys_slist_append(&heap_listener_list, &listener->node);
+	if (listener->event == HEAP_SIZE_CLASS) {
+		atomic_inc(&size_class_listeners);
+	}
 
 	k_spin_unlock(&heap_listener_lock, key);
 }
@@ -23,7 +32,10 @@ void heap_listener_unregister(struct heap_listener *listener)
 {
 	k_spinlock_key_t key = k_spin_lock(&heap_listener_lock);
 
-	sys_slist_find_and_remove(&heap_listener_list, &listener->node);
+	if (sys_slist_find_and_remove(&heap_listener_list, &listener->node) &&
+	    listener->event == HEAP_SIZE_CLASS) {
+		atomic_dec(&size_class_listeners);
+	}
 
 	k_spin_unlock(&heap_listener_lock, key);
 }
@@ -75,3 +87,26 @@ void heap_listener_notify_resize(uintptr_t heap_id, void *old_heap_end, void *ne
 
 	k_spin_unlock(&heap_listener_lock, key);
 }
+
+void heap_listener_notify_size_class(uintptr_t heap_id, uint32_t hits,
+				     uint32_t misses)
+{
+	struct heap_listener *listener;
+	k_spinlock_key_t key;
+
+	if (atomic_get(&size_class_listeners) == 0) {
+		return;
+	}
+
+	key = k_spin_lock(&heap_listener_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&heap_listener_list, listener, node) {
+		if (listener->heap_id == heap_id
+		    && listener->size_class_cb != NULL
+		    && listener->event == HEAP_SIZE_CLASS) {
+			listener->size_class_cb(heap_id, hits, misses);
+		}
+	}
+
+	k_spin_unlock(&heap_listener_lock, key);
+}
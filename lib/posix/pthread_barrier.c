@@ -21,9 +21,7 @@ int pthread_barrier_wait(pthread_barrier_t *b)
 	if (b->count >= b->max) {
 		b->count = 0;
 
-		while (z_waitq_head(&b->wait_q)) {
-			_ready_one_thread(&b->wait_q);
-		}
+		(void)z_sched_wake_all(&b->wait_q, 0, NULL);
 		z_reschedule(&z_pthread_spinlock, key);
 		ret = PTHREAD_BARRIER_SERIAL_THREAD;
 	} else {
@@ -141,6 +141,145 @@ const struct net_buf_data_cb net_buf_var_cb = {
 	.unref = mem_pool_data_unref,
 };
 
+/* Elastic pools keep the size and origin of the data in front of it, the
+ * ref count stays in the byte before the data like for the other pools.
+ * The header is padded to a multiple of the pointer size, so the data
+ * keeps the alignment of the heap allocation.
+ */
+struct elastic_hdr {
+#if UINTPTR_MAX > UINT32_MAX
+	uint32_t pad;
+#endif
+	uint16_t size;
+	uint8_t borrowed;
+	uint8_t ref_count;
+};
+
+BUILD_ASSERT(sizeof(struct elastic_hdr) % sizeof(void *) == 0,
+	     "Elastic buffer data would be misaligned");
+
+static void *shared_heap_alloc(struct net_buf_shared_heap *shared,
+			       size_t size)
+{
+	k_spinlock_key_t key;
+	void *b;
+
+	b = k_heap_alloc(shared->heap, size, K_NO_WAIT);
+
+	key = k_spin_lock(&shared->lock);
+
+	if (!b) {
+		shared->failures++;
+		goto out;
+	}
+
+	shared->used += size;
+	shared->max_used = MAX(shared->max_used, shared->used);
+	shared->borrows++;
+
+	if (!shared->pressure && shared->used >= shared->high_wm) {
+		shared->pressure = true;
+		shared->pressure_count++;
+	}
+
+out:
+	k_spin_unlock(&shared->lock, key);
+
+	return b;
+}
+
+static void shared_heap_free(struct net_buf_shared_heap *shared, void *b,
+			     size_t size)
+{
+	k_spinlock_key_t key;
+
+	k_heap_free(shared->heap, b);
+
+	key = k_spin_lock(&shared->lock);
+
+	shared->used -= size;
+
+	if (shared->pressure && shared->used <= shared->low_wm) {
+		shared->pressure = false;
+	}
+
+	k_spin_unlock(&shared->lock, key);
+}
+
+static uint8_t *elastic_data_alloc(struct net_buf *buf, size_t *size,
+				   k_timeout_t timeout)
+{
+	struct net_buf_pool *buf_pool = net_buf_pool_get(buf->pool_id);
+	struct net_buf_pool_elastic *elastic = buf_pool->alloc->alloc_data;
+	size_t len = sizeof(struct elastic_hdr) + *size;
+	struct elastic_hdr *hdr;
+
+	if (len > UINT16_MAX) {
+		return NULL;
+	}
+
+	/* Only wait for the reservation when there is nothing to borrow */
+	hdr = k_heap_alloc(elastic->base, len, K_NO_WAIT);
+	if (hdr) {
+		hdr->borrowed = 0U;
+	} else {
+		hdr = shared_heap_alloc(elastic->shared, len);
+		if (hdr) {
+			hdr->borrowed = 1U;
+			atomic_add(&elastic->borrowed, len);
+		} else {
+			hdr = k_heap_alloc(elastic->base, len, timeout);
+			if (!hdr) {
+				return NULL;
+			}
+
+			hdr->borrowed = 0U;
+		}
+	}
+
+	hdr->size = len;
+	hdr->ref_count = 1U;
+
+	return (uint8_t *)(hdr + 1);
+}
+
+static void elastic_data_unref(struct net_buf *buf, uint8_t *data)
+{
+	struct net_buf_pool *buf_pool = net_buf_pool_get(buf->pool_id);
+	struct net_buf_pool_elastic *elastic = buf_pool->alloc->alloc_data;
+	struct elastic_hdr *hdr = (struct elastic_hdr *)data - 1;
+
+	if (--hdr->ref_count) {
+		return;
+	}
+
+	if (hdr->borrowed) {
+		atomic_sub(&elastic->borrowed, hdr->size);
+		shared_heap_free(elastic->shared, hdr, hdr->size);
+	} else {
+		k_heap_free(elastic->base, hdr);
+	}
+}
+
+const struct net_buf_data_cb net_buf_elastic_cb = {
+	.alloc = elastic_data_alloc,
+	.ref   = generic_data_ref,
+	.unref = elastic_data_unref,
+};
+
+size_t net_buf_pool_borrowed(struct net_buf_pool *pool)
+{
+	struct net_buf_pool_elastic *elastic;
+
+	if (pool->alloc->cb != &net_buf_elastic_cb) {
+		return 0;
+	}
+
+	elastic = pool->alloc->alloc_data;
+
+	return atomic_get(&elastic->borrowed);
+}
+
 static uint8_t *fixed_data_alloc(struct net_buf *buf, size_t *size,
 			      k_timeout_t timeout)
 {
@@ -59,6 +59,19 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* UDP and TCP handlers with a local port are hashed by that port, all the
+ * other handlers are in the wildcard list stored after the hash buckets.
+ */
+#define CONN_DEMUX_WILDCARD CONFIG_NET_CONN_HASH_SIZE
+
+static sys_slist_t conn_demux[CONFIG_NET_CONN_HASH_SIZE + 1];
+
+struct conn_demux_iter {
+	sys_snode_t *node;
+	int idx;
+	int bucket;
+};
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -127,11 +140,76 @@ static struct net_conn *conn_get_unused(void)
 	return CONTAINER_OF(node, struct net_conn, node);
 }
 
+static int conn_demux_bucket(uint16_t port)
+{
+	return ntohs(port) % CONFIG_NET_CONN_HASH_SIZE;
+}
+
+static sys_slist_t *conn_demux_list(struct net_conn *conn)
+{
+	if ((conn->flags & NET_CONN_LOCAL_PORT_SPEC) &&
+	    (conn->proto == IPPROTO_UDP || conn->proto == IPPROTO_TCP) &&
+	    (conn->family == AF_INET || conn->family == AF_INET6 ||
+	     conn->family == AF_UNSPEC)) {
+		return &conn_demux[conn_demux_bucket(
+				net_sin(&conn->local_addr)->sin_port)];
+	}
+
+	return &conn_demux[CONN_DEMUX_WILDCARD];
+}
+
+/* Start a walk over the handlers that can match a packet. For UDP and TCP
+ * these are the ones bound to the destination port and the wildcard ones,
+ * for other packets all the handlers are visited.
+ */
+static void conn_demux_start(struct conn_demux_iter *it, struct net_pkt *pkt,
+			     uint8_t proto, uint16_t dst_port)
+{
+	it->node = NULL;
+	it->idx = -1;
+	it->bucket = -1;
+
+	if ((proto == IPPROTO_UDP || proto == IPPROTO_TCP) &&
+	    (net_pkt_family(pkt) == AF_INET ||
+	     net_pkt_family(pkt) == AF_INET6)) {
+		it->bucket = conn_demux_bucket(dst_port);
+	}
+}
+
+static struct net_conn *conn_demux_next(struct conn_demux_iter *it)
+{
+	struct net_conn *conn;
+
+	while (it->node == NULL) {
+		if (it->bucket < 0) {
+			it->idx++;
+		} else if (it->idx < 0) {
+			it->idx = it->bucket;
+		} else if (it->idx == it->bucket) {
+			it->idx = CONN_DEMUX_WILDCARD;
+		} else {
+			return NULL;
+		}
+
+		if (it->idx > CONN_DEMUX_WILDCARD) {
+			return NULL;
+		}
+
+		it->node = sys_slist_peek_head(&conn_demux[it->idx]);
+	}
+
+	conn = CONTAINER_OF(it->node, struct net_conn, demux_node);
+	it->node = sys_slist_peek_next(it->node);
+
+	return conn;
+}
+
 static void conn_set_used(struct net_conn *conn)
 {
 	conn->flags |= NET_CONN_IN_USE;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+	sys_slist_prepend(conn_demux_list(conn), &conn->demux_node);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -380,6 +458,7 @@ int net_conn_unregister(struct net_conn_handle *handle)
 	NET_DBG("Connection handler %p removed", conn);
 
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	sys_slist_find_and_remove(conn_demux_list(conn), &conn->demux_node);
 
 	conn_set_unused(conn);
 
@@ -562,11 +641,18 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
 	int16_t best_rank = -1;
+	struct conn_demux_iter it;
 	struct net_conn *conn;
+#if defined(CONFIG_NET_STATISTICS_CONN_DEMUX)
+	uint32_t demux_start = k_cycle_get_32();
+	uint32_t demux_visited = 0U;
+#endif
 	enum net_verdict ret;
 	uint16_t src_port;
 	uint16_t dst_port;
 
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_TRANSPORT);
+
 	if (IS_ENABLED(CONFIG_NET_UDP) && proto == IPPROTO_UDP) {
 		src_port = proto_hdr->udp->src_port;
 		dst_port = proto_hdr->udp->dst_port;
@@ -627,7 +713,13 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	conn_demux_start(&it, pkt, proto, dst_port);
+
+	while ((conn = conn_demux_next(&it)) != NULL) {
+#if defined(CONFIG_NET_STATISTICS_CONN_DEMUX)
+		demux_visited++;
+#endif
+
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
 		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
@@ -780,6 +872,11 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+#if defined(CONFIG_NET_STATISTICS_CONN_DEMUX)
+	net_stats_update_conn_demux(pkt_iface, demux_start, k_cycle_get_32(),
+				    demux_visited);
+#endif
+
 	if ((is_mcast_pkt && mcast_pkt_delivered) ||
 	    (net_pkt_family(pkt) == AF_PACKET && (raw_pkt_delivered ||
 						  raw_pkt_continue))) {
@@ -860,6 +957,10 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+	for (i = 0; i < ARRAY_SIZE(conn_demux); i++) {
+		sys_slist_init(&conn_demux[i]);
+	}
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -51,6 +51,9 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal slist node in the port hash or wildcard list */
+	sys_snode_t demux_node;
+
 	/** Remote IP address */
 	struct sockaddr remote_addr;
 
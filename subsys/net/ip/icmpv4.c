@@ -54,6 +54,10 @@ int net_icmpv4_finalize(struct net_pkt *pkt)
 					      struct net_icmp_hdr);
 	struct net_icmp_hdr *icmp_hdr;
 
+	if (net_pkt_is_chksum_ready(pkt)) {
+		return 0;
+	}
+
 	if (IS_ENABLED(CONFIG_NET_IPV4_HDR_OPTIONS)) {
 		if (net_pkt_skip(pkt, net_pkt_ipv4_opts_len(pkt))) {
 			return -ENOBUFS;
@@ -411,6 +415,10 @@ static enum net_verdict icmpv4_handle_echo_request(struct net_pkt *pkt,
 					   struct net_ipv4_hdr *ip_hdr,
 					   struct net_icmp_hdr *icmp_hdr)
 {
+	struct net_icmp_hdr reply_hdr = {
+		.type = NET_ICMPV4_ECHO_REPLY,
+		.code = 0U,
+	};
 	struct net_pkt *reply = NULL;
 	const struct in_addr *src;
 	int16_t payload_len;
@@ -465,11 +473,20 @@ static enum net_verdict icmpv4_handle_echo_request(struct net_pkt *pkt,
 		}
 	}
 
-	if (icmpv4_create(reply, NET_ICMPV4_ECHO_REPLY, 0) ||
+	/* The checksum of the request was verified and the payload is
+	 * copied as is, so only the type and code change in the reply.
+	 */
+	reply_hdr.chksum = net_chksum_update_16(
+		icmp_hdr->chksum,
+		htons(icmp_hdr->type << 8 | icmp_hdr->code),
+		htons(reply_hdr.type << 8 | reply_hdr.code));
+
+	if (net_pkt_write(reply, &reply_hdr, sizeof(reply_hdr)) ||
 	    net_pkt_copy(reply, pkt, payload_len)) {
 		goto drop;
 	}
 
+	net_pkt_set_chksum_ready(reply, true);
 	net_pkt_cursor_init(reply);
 	net_ipv4_finalize(reply, IPPROTO_ICMP);
 
@@ -74,6 +74,10 @@ int net_icmpv6_finalize(struct net_pkt *pkt)
 					      struct net_icmp_hdr);
 	struct net_icmp_hdr *icmp_hdr;
 
+	if (net_pkt_is_chksum_ready(pkt)) {
+		return 0;
+	}
+
 	icmp_hdr = (struct net_icmp_hdr *)net_pkt_get_data(pkt, &icmp_access);
 	if (!icmp_hdr) {
 		return -ENOBUFS;
@@ -107,12 +111,14 @@ enum net_verdict icmpv6_handle_echo_request(struct net_pkt *pkt,
 					    struct net_ipv6_hdr *ip_hdr,
 					    struct net_icmp_hdr *icmp_hdr)
 {
+	struct net_icmp_hdr reply_hdr = {
+		.type = NET_ICMPV6_ECHO_REPLY,
+		.code = 0U,
+	};
 	struct net_pkt *reply = NULL;
 	const struct in6_addr *src;
 	int16_t payload_len;
 
-	ARG_UNUSED(icmp_hdr);
-
 	NET_DBG("Received Echo Request from %s to %s",
 		log_strdup(net_sprint_ipv6_addr(&ip_hdr->src)),
 		log_strdup(net_sprint_ipv6_addr(&ip_hdr->dst)));
@@ -151,12 +157,25 @@ enum net_verdict icmpv6_handle_echo_request(struct net_pkt *pkt,
 		goto drop;
 	}
 
-	if (net_icmpv6_create(reply, NET_ICMPV6_ECHO_REPLY, 0) ||
+	/* The checksum of the request was verified and the payload is
+	 * copied as is. The pseudo header only differs by the source
+	 * address, when the request was sent to a multicast address, and
+	 * the type and code change in the reply.
+	 */
+	reply_hdr.chksum = net_chksum_update(icmp_hdr->chksum, ip_hdr->dst,
+					     src, sizeof(struct in6_addr));
+	reply_hdr.chksum = net_chksum_update_16(
+		reply_hdr.chksum,
+		htons(icmp_hdr->type << 8 | icmp_hdr->code),
+		htons(reply_hdr.type << 8 | reply_hdr.code));
+
+	if (net_pkt_write(reply, &reply_hdr, sizeof(reply_hdr)) ||
 	    net_pkt_copy(reply, pkt, payload_len)) {
 		NET_DBG("DROP: wrong buffer");
 		goto drop;
 	}
 
+	net_pkt_set_chksum_ready(reply, true);
 	net_pkt_cursor_init(reply);
 	net_ipv6_finalize(reply, IPPROTO_ICMPV6);
 
@@ -224,6 +224,7 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 	union net_ip_header ip;
 	uint8_t hdr_len;
 	uint8_t opts_len;
+	uint16_t frag;
 	int pkt_len;
 
 #if defined(CONFIG_NET_L2_VIRTUAL)
@@ -233,6 +234,7 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 #endif
 
 	net_stats_update_ipv4_recv(net_pkt_iface(pkt));
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_IP);
 
 	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
 	if (!hdr) {
@@ -321,6 +323,22 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 		log_strdup(net_sprint_ipv4_addr(&hdr->src)),
 		log_strdup(net_sprint_ipv4_addr(&hdr->dst)));
 
+	frag = (hdr->offset[0] << 8) | hdr->offset[1];
+	if (frag & (NET_IPV4_FRAGH_MF_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) {
+		if (!IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT)) {
+			NET_DBG("DROP: fragmented packet");
+			net_stats_update_ip_errors_fragerr(net_pkt_iface(pkt));
+			goto drop;
+		}
+
+		verdict = net_ipv4_handle_fragment_hdr(pkt, hdr);
+		if (verdict == NET_DROP) {
+			goto drop;
+		}
+
+		return verdict;
+	}
+
 	switch (hdr->proto) {
 	case IPPROTO_ICMP:
 		verdict = net_icmpv4_input(pkt, hdr);
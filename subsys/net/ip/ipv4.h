@@ -204,4 +204,107 @@ static inline int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 }
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+/** Store pending IPv4 fragment information that is needed for reassembly. */
+struct net_ipv4_reassembly {
+	/** IPv4 source address of the fragment */
+	struct in_addr src;
+
+	/** IPv4 destination address of the fragment */
+	struct in_addr dst;
+
+	/**
+	 * Timeout for cancelling the reassembly. The timer is used
+	 * also to detect if this reassembly slot is used or not.
+	 */
+	struct k_work_delayable timer;
+
+	/** Pointers to pending fragments */
+	struct net_pkt *pkt[CONFIG_NET_IPV4_FRAGMENT_MAX_PKT];
+
+	/** IPv4 fragment identification */
+	uint16_t id;
+
+	/** IPv4 protocol of the fragment */
+	uint8_t protocol;
+};
+#else
+struct net_ipv4_reassembly;
+#endif
+
+/**
+ * @typedef net_ipv4_frag_cb_t
+ * @brief Callback used while iterating over pending IPv4 fragments.
+ *
+ * @param reass IPv4 fragment reassembly struct
+ * @param user_data A valid pointer on some user data or NULL
+ */
+typedef void (*net_ipv4_frag_cb_t)(struct net_ipv4_reassembly *reass,
+				   void *user_data);
+
+/**
+ * @brief Go through all the currently pending IPv4 fragments.
+ *
+ * @param cb Callback to call for each pending IPv4 fragment.
+ * @param user_data User specified data or NULL.
+ */
+void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data);
+
+/**
+ * @brief Handles IPv4 fragmented packets.
+ *
+ * @param pkt     Network head packet.
+ * @param hdr     The IPv4 header of the current packet
+ *
+ * @return Return verdict about the packet
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT) && defined(CONFIG_NET_NATIVE_IPV4)
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr);
+#else
+static inline
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hdr);
+
+	return NET_DROP;
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
+/**
+ * @brief Prepare IPv4 packet for sending, fragmenting it if it does
+ * not fit in the MTU of the network interface.
+ *
+ * @param pkt Network packet
+ *
+ * @return NET_OK if the packet can be sent as is, NET_CONTINUE if it
+ * was fragmented and the fragments were sent instead, NET_DROP if
+ * the packet must be dropped.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT) && defined(CONFIG_NET_NATIVE_IPV4)
+enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_OK;
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
+/**
+ * @brief Split an IPv4 packet into fragments and send them.
+ *
+ * @param iface Network interface
+ * @param pkt Network packet to fragment
+ * @param pkt_len Length of the network packet
+ * @param mtu MTU of the network interface
+ *
+ * @return 0 on success, a negative errno otherwise.
+ */
+int net_ipv4_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
+				 uint16_t pkt_len, uint16_t mtu);
+
 #endif /* __IPV4_H */
@@ -0,0 +1,686 @@
+/** @file
+ * @brief IPv4 Fragment related functions
+ */
+
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_stats.h>
+#include <net/net_context.h>
+#include <random/rand32.h>
+#include <sys/atomic.h>
+#include "net_private.h"
+#include "connection.h"
+#include "icmpv4.h"
+#include "udp_internal.h"
+#include "tcp_internal.h"
+#include "ipv4.h"
+#include "net_stats.h"
+
+#define IPV4_REASSEMBLY_TIMEOUT K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT)
+
+/* Largest possible value of the IPv4 Total Length field */
+#define IPV4_MAX_PKT_LEN 0xffff
+
+static void reassembly_timeout(struct k_work *work);
+static bool reassembly_init_done;
+
+/* The reassembly slots are shared by the RX path and the timeout
+ * handler running in the system work queue.
+ */
+static K_MUTEX_DEFINE(reassembly_lock);
+
+static struct net_ipv4_reassembly
+reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
+
+/* Identification of the next fragmented packet we send, the low 16 bits
+ * are used. Packets can be fragmented from several threads at once.
+ */
+static atomic_t fragment_id;
+
+static inline uint16_t fragment_hdr_len(struct net_pkt *pkt)
+{
+	return net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt);
+}
+
+static struct net_ipv4_reassembly *reassembly_get(uint16_t id,
+						  struct in_addr *src,
+						  struct in_addr *dst,
+						  uint8_t protocol)
+{
+	int i, avail = -1;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		if (k_work_delayable_remaining_get(&reassembly[i].timer) &&
+		    reassembly[i].id == id &&
+		    reassembly[i].protocol == protocol &&
+		    net_ipv4_addr_cmp(src, &reassembly[i].src) &&
+		    net_ipv4_addr_cmp(dst, &reassembly[i].dst)) {
+			return &reassembly[i];
+		}
+
+		/* A slot whose timer has fired still holds its fragments
+		 * until reassembly_timeout() gets the lock and drops them.
+		 */
+		if (k_work_delayable_remaining_get(&reassembly[i].timer) ||
+		    reassembly[i].pkt[0]) {
+			continue;
+		}
+
+		if (avail < 0) {
+			avail = i;
+		}
+	}
+
+	if (avail < 0) {
+		return NULL;
+	}
+
+	k_work_reschedule(&reassembly[avail].timer, IPV4_REASSEMBLY_TIMEOUT);
+
+	net_ipaddr_copy(&reassembly[avail].src, src);
+	net_ipaddr_copy(&reassembly[avail].dst, dst);
+
+	reassembly[avail].id = id;
+	reassembly[avail].protocol = protocol;
+
+	return &reassembly[avail];
+}
+
+static void reassembly_cancel(struct net_ipv4_reassembly *reass)
+{
+	int i;
+
+	NET_DBG("Cancel 0x%x", reass->id);
+
+	k_work_cancel_delayable(&reass->timer);
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		if (!reass->pkt[i]) {
+			continue;
+		}
+
+		NET_DBG("[%d] IPv4 reassembly pkt %p %zd bytes data",
+			i, reass->pkt[i], net_pkt_get_len(reass->pkt[i]));
+
+		net_pkt_unref(reass->pkt[i]);
+		reass->pkt[i] = NULL;
+	}
+
+	reass->id = 0U;
+}
+
+static void reassembly_info(char *str, struct net_ipv4_reassembly *reass)
+{
+	NET_DBG("%s id 0x%x src %s dst %s remain %d ms", str, reass->id,
+		log_strdup(net_sprint_ipv4_addr(&reass->src)),
+		log_strdup(net_sprint_ipv4_addr(&reass->dst)),
+		k_ticks_to_ms_ceil32(
+			k_work_delayable_remaining_get(&reass->timer)));
+}
+
+static void reassembly_timeout(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct net_ipv4_reassembly *reass =
+		CONTAINER_OF(dwork, struct net_ipv4_reassembly, timer);
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	/* The slot was completed, cancelled or reused while we were
+	 * waiting for the lock.
+	 */
+	if (!reass->pkt[0] ||
+	    k_work_delayable_remaining_get(&reass->timer)) {
+		goto out;
+	}
+
+	reassembly_info("Reassembly cancelled", reass);
+
+	net_stats_update_ipv4_frag_timeout(net_pkt_iface(reass->pkt[0]));
+
+	/* Send a ICMPv4 Time Exceeded only if we received the first
+	 * fragment (RFC 792 and RFC 1122 ch. 3.3.2).
+	 */
+	if (net_pkt_ipv4_fragment_offset(reass->pkt[0]) == 0U) {
+		net_icmpv4_send_error(reass->pkt[0], NET_ICMPV4_TIME_EXCEEDED,
+				      NET_ICMPV4_TIME_EXCEEDED_REASSEMBLY);
+	}
+
+	reassembly_cancel(reass);
+
+out:
+	k_mutex_unlock(&reassembly_lock);
+}
+
+static void reassemble_packet(struct net_ipv4_reassembly *reass)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+	struct net_buf *last;
+	int i;
+
+	k_work_cancel_delayable(&reass->timer);
+
+	NET_ASSERT(reass->pkt[0]);
+
+	last = net_buf_frag_last(reass->pkt[0]->buffer);
+
+	/* We start from 2nd packet which is then appended to
+	 * the first one.
+	 */
+	for (i = 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		int removed_len;
+
+		pkt = reass->pkt[i];
+		if (!pkt) {
+			break;
+		}
+
+		net_pkt_cursor_init(pkt);
+
+		/* Get rid of IPv4 header and options which are at
+		 * the beginning of the fragment.
+		 */
+		removed_len = fragment_hdr_len(pkt);
+
+		NET_DBG("Removing %d bytes from start of pkt %p",
+			removed_len, pkt->buffer);
+
+		if (net_pkt_pull(pkt, removed_len)) {
+			NET_ERR("Failed to pull headers");
+			reassembly_cancel(reass);
+			return;
+		}
+
+		/* Attach the data to previous pkt */
+		last->frags = pkt->buffer;
+		last = net_buf_frag_last(pkt->buffer);
+
+		pkt->buffer = NULL;
+		reass->pkt[i] = NULL;
+
+		net_pkt_unref(pkt);
+	}
+
+	pkt = reass->pkt[0];
+	reass->pkt[0] = NULL;
+	reass->id = 0U;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!hdr) {
+		goto error;
+	}
+
+	/* Fix the total length and clear the fragment offset and
+	 * More Fragments flag, only the DF flag is left untouched.
+	 */
+	hdr->len = htons(net_pkt_get_len(pkt));
+	hdr->offset[0] &= NET_IPV4_DF << 5;
+	hdr->offset[1] = 0U;
+	hdr->chksum = 0U;
+
+	if (net_pkt_set_data(pkt, &ipv4_access)) {
+		goto error;
+	}
+
+	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_set_overwrite(pkt, false);
+
+	NET_DBG("New pkt %p IPv4 len is %zd bytes", pkt, net_pkt_get_len(pkt));
+
+	net_stats_update_ipv4_frag_reassembled(net_pkt_iface(pkt));
+
+	/* We need to use the queue when feeding the packet back into the
+	 * IP stack as we might run out of stack if we call processing_data()
+	 * directly. As the packet does not contain link layer header, we
+	 * MUST NOT pass it to L2. The packet still carries the fragment
+	 * flags of the first fragment, which has the MF bit set, and
+	 * process_data() uses that to skip L2.
+	 */
+	if (net_recv_data(net_pkt_iface(pkt), pkt) >= 0) {
+		return;
+	}
+error:
+	net_pkt_unref(pkt);
+}
+
+void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data)
+{
+	int i;
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	for (i = 0; reassembly_init_done &&
+		     i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		if (!k_work_delayable_remaining_get(&reassembly[i].timer)) {
+			continue;
+		}
+
+		cb(&reassembly[i], user_data);
+	}
+
+	k_mutex_unlock(&reassembly_lock);
+}
+
+/* Verify that we have all the fragments received and in correct order.
+ * Return:
+ * - a negative value if the fragments are erroneous and must be dropped
+ * - zero if we are expecting more fragments
+ * - a positive value if we can proceed with the reassembly
+ */
+static int fragments_are_ready(struct net_ipv4_reassembly *reass)
+{
+	unsigned int expected_offset = 0;
+	bool more = true;
+	int i;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		struct net_pkt *pkt = reass->pkt[i];
+		unsigned int offset;
+
+		if (!pkt) {
+			break;
+		}
+
+		offset = net_pkt_ipv4_fragment_offset(pkt);
+
+		if (offset < expected_offset) {
+			/* Overlapping or duplicated fragment. Overlaps are
+			 * a known way to sneak data past filters, so drop
+			 * the whole packet as RFC 5722 does for IPv6.
+			 */
+			return -EBADMSG;
+		} else if (offset != expected_offset) {
+			/* Not contiguous, let's wait for fragments */
+			return 0;
+		}
+
+		expected_offset += net_pkt_get_len(pkt) - fragment_hdr_len(pkt);
+		more = net_pkt_ipv4_fragment_more(pkt);
+	}
+
+	if (more) {
+		return 0;
+	}
+
+	return 1;
+}
+
+static int shift_packets(struct net_ipv4_reassembly *reass, int pos)
+{
+	int i;
+
+	for (i = pos + 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		if (!reass->pkt[i]) {
+			NET_DBG("Moving [%d] %p (offset 0x%x) to [%d]",
+				pos, reass->pkt[pos],
+				net_pkt_ipv4_fragment_offset(reass->pkt[pos]),
+				pos + 1);
+
+			/* pkt[i] is free, so shift everything between
+			 * [pos] and [i - 1] by one element
+			 */
+			memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
+				sizeof(void *) * (i - pos));
+
+			/* pkt[pos] is now free */
+			reass->pkt[pos] = NULL;
+
+			return 0;
+		}
+	}
+
+	/* We do not have free space left in the array */
+	return -ENOMEM;
+}
+
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	struct net_ipv4_reassembly *reass = NULL;
+	struct net_if *iface = net_pkt_iface(pkt);
+	unsigned int payload_len;
+	uint16_t flags;
+	bool found;
+	int ret;
+	int i;
+
+	k_mutex_lock(&reassembly_lock, K_FOREVER);
+
+	if (!reassembly_init_done) {
+		/* Static initializing does not work here because of the array
+		 * so we must do it at runtime.
+		 */
+		for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+			k_work_init_delayable(&reassembly[i].timer,
+					      reassembly_timeout);
+		}
+
+		reassembly_init_done = true;
+	}
+
+	net_stats_update_ipv4_frag_recv(iface);
+
+	flags = (hdr->offset[0] << 8) | hdr->offset[1];
+	net_pkt_set_ipv4_fragment_flags(pkt, flags);
+	net_pkt_set_ipv4_fragment_id(pkt, (hdr->id[0] << 8) | hdr->id[1]);
+
+	payload_len = net_pkt_get_len(pkt) - fragment_hdr_len(pkt);
+
+	if (net_pkt_ipv4_fragment_more(pkt) && (payload_len % 8U)) {
+		/* All but the last fragment must carry a multiple of
+		 * 8 bytes of payload.
+		 */
+		NET_DBG("Fragment length %u is not multiple of 8",
+			payload_len);
+		goto drop;
+	}
+
+	if (net_pkt_ipv4_fragment_offset(pkt) + payload_len >
+	    IPV4_MAX_PKT_LEN - fragment_hdr_len(pkt)) {
+		/* The reassembled packet would not fit in 64kB */
+		NET_DBG("Fragment offset %u too big",
+			net_pkt_ipv4_fragment_offset(pkt));
+		goto drop;
+	}
+
+	reass = reassembly_get(net_pkt_ipv4_fragment_id(pkt),
+			       (struct in_addr *)hdr->src,
+			       (struct in_addr *)hdr->dst, hdr->proto);
+	if (!reass) {
+		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
+		goto drop;
+	}
+
+	/* The fragments might come in wrong order so place them
+	 * in reassembly chain in correct order.
+	 */
+	for (i = 0, found = false; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		if (reass->pkt[i]) {
+			if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) <
+			    net_pkt_ipv4_fragment_offset(pkt)) {
+				continue;
+			}
+
+			/* Make room for this fragment. If there is no room,
+			 * then it will discard the whole reassembly.
+			 */
+			if (shift_packets(reass, i)) {
+				break;
+			}
+		}
+
+		NET_DBG("Storing pkt %p to slot %d offset %d",
+			pkt, i, net_pkt_ipv4_fragment_offset(pkt));
+		reass->pkt[i] = pkt;
+		found = true;
+
+		break;
+	}
+
+	if (!found) {
+		/* We could not add this fragment into our saved fragment
+		 * list. We must discard the whole packet at this point.
+		 */
+		NET_DBG("No slots available for 0x%x", reass->id);
+		goto drop;
+	}
+
+	ret = fragments_are_ready(reass);
+	if (ret < 0) {
+		NET_DBG("Reassembled IPv4 verify failed, dropping id %u",
+			reass->id);
+
+		/* Let the caller release the already inserted pkt */
+		reass->pkt[i] = NULL;
+		goto drop;
+	} else if (ret == 0) {
+		reassembly_info("Reassembly nth pkt", reass);
+
+		NET_DBG("More fragments to be received");
+		goto accept;
+	}
+
+	reassembly_info("Reassembly last pkt", reass);
+
+	/* The last fragment received, reassemble the packet */
+	reassemble_packet(reass);
+
+accept:
+	k_mutex_unlock(&reassembly_lock);
+
+	return NET_OK;
+
+drop:
+	if (reass) {
+		reassembly_cancel(reass);
+	}
+
+	k_mutex_unlock(&reassembly_lock);
+
+	net_stats_update_ipv4_frag_drop(iface);
+
+	return NET_DROP;
+}
+
+#define BUF_ALLOC_TIMEOUT K_MSEC(100)
+
+static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t fit_len,
+			      uint16_t frag_offset, uint16_t id, bool final)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *ipv4_hdr;
+	struct net_pkt *frag_pkt;
+	uint8_t opts_len = 0U;
+	uint16_t offset;
+	int ret = -ENOBUFS;
+
+	/* Options are only copied to the first fragment. The only option
+	 * we send ourselves is Router Alert in IGMP reports, which are
+	 * never fragmented.
+	 */
+	if (frag_offset == 0U) {
+		opts_len = net_pkt_ipv4_opts_len(pkt);
+	}
+
+	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+					     opts_len + fit_len,
+					     AF_INET, 0, BUF_ALLOC_TIMEOUT);
+	if (!frag_pkt) {
+		return -ENOMEM;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	/* Copy the original header and then the payload part of this
+	 * fragment from the original packet.
+	 */
+	if (net_pkt_copy(frag_pkt, pkt, net_pkt_ip_hdr_len(pkt) + opts_len) ||
+	    net_pkt_skip(pkt, net_pkt_ipv4_opts_len(pkt) - opts_len) ||
+	    net_pkt_skip(pkt, frag_offset) ||
+	    net_pkt_copy(frag_pkt, pkt, fit_len)) {
+		goto fail;
+	}
+
+	net_pkt_set_ip_hdr_len(frag_pkt, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ipv4_opts_len(frag_pkt, opts_len);
+	net_pkt_set_priority(frag_pkt, net_pkt_priority(pkt));
+
+	net_pkt_cursor_init(frag_pkt);
+	net_pkt_set_overwrite(frag_pkt, true);
+
+	ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(frag_pkt,
+							   &ipv4_access);
+	if (!ipv4_hdr) {
+		goto fail;
+	}
+
+	offset = frag_offset / 8U;
+	if (!final) {
+		offset |= NET_IPV4_FRAGH_MF_MASK;
+	}
+
+	/* The upper layer checksum was already calculated over the whole
+	 * packet, so only the IPv4 header is updated here.
+	 */
+	ipv4_hdr->vhl = 0x40 | (fragment_hdr_len(frag_pkt) / 4U);
+	ipv4_hdr->len = htons(net_pkt_get_len(frag_pkt));
+	ipv4_hdr->id[0] = id >> 8;
+	ipv4_hdr->id[1] = id;
+	ipv4_hdr->offset[0] = offset >> 8;
+	ipv4_hdr->offset[1] = offset;
+	ipv4_hdr->chksum = 0U;
+
+	if (net_pkt_set_data(frag_pkt, &ipv4_access)) {
+		goto fail;
+	}
+
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(frag_pkt))) {
+		NET_IPV4_HDR(frag_pkt)->chksum =
+			net_calc_chksum_ipv4(frag_pkt);
+	}
+
+	net_pkt_cursor_init(frag_pkt);
+
+	/* If everything has been ok so far, we can send the packet. */
+	ret = net_send_data(frag_pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	net_stats_update_ipv4_frag_sent(net_pkt_iface(pkt));
+
+	/* Let this packet to be sent and hopefully it will release
+	 * the memory that can be utilized for next sent IPv4 fragment.
+	 */
+	k_yield();
+
+	return 0;
+
+fail:
+	NET_DBG("Cannot send fragment (%d)", ret);
+	net_pkt_unref(frag_pkt);
+
+	return ret;
+}
+
+int net_ipv4_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
+				 uint16_t pkt_len, uint16_t mtu)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *ipv4_hdr;
+	uint16_t frag_offset;
+	size_t length;
+	int fit_len;
+	uint16_t id;
+	int ret;
+
+	net_pkt_cursor_init(pkt);
+
+	ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!ipv4_hdr) {
+		return -ENOBUFS;
+	}
+
+	if (ipv4_hdr->offset[0] & (NET_IPV4_DF << 5)) {
+		NET_DBG("DF set, cannot fragment pkt %p len %u", pkt, pkt_len);
+		return -EMSGSIZE;
+	}
+
+	/* The maximum payload that fits into each packet after the IPv4
+	 * header and options, rounded down to the 8 byte units of the
+	 * Fragment Offset field.
+	 */
+	fit_len = ((int)mtu - fragment_hdr_len(pkt)) & ~7;
+	if (fit_len <= 0) {
+		NET_DBG("No room for IPv4 payload MTU %d hdrs_len %d",
+			mtu, fragment_hdr_len(pkt));
+		return -EINVAL;
+	}
+
+	(void)atomic_cas(&fragment_id, 0, (atomic_val_t)sys_rand32_get());
+
+	id = (uint16_t)atomic_inc(&fragment_id);
+
+	frag_offset = 0U;
+
+	length = pkt_len - fragment_hdr_len(pkt);
+	while (length) {
+		bool final = false;
+
+		if (fit_len >= length) {
+			final = true;
+			fit_len = length;
+		}
+
+		ret = send_ipv4_fragment(pkt, fit_len, frag_offset, id, final);
+		if (ret < 0) {
+			return ret;
+		}
+
+		length -= fit_len;
+		frag_offset += fit_len;
+	}
+
+	return 0;
+}
+
+enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
+{
+	uint16_t mtu = net_if_get_mtu(net_pkt_iface(pkt));
+	size_t pkt_len = net_pkt_get_len(pkt);
+	int ret;
+
+	/* Packets built for segmentation offload are split into TCP
+	 * segments that fit the MTU just before they are given to L2.
+	 */
+	if (mtu == 0U || pkt_len <= mtu || net_pkt_gso_size(pkt)) {
+		return NET_OK;
+	}
+
+	ret = net_ipv4_send_fragmented_pkt(net_pkt_iface(pkt), pkt,
+					   pkt_len, mtu);
+	if (ret < 0) {
+		NET_DBG("Cannot fragment IPv4 pkt (%d)", ret);
+
+		if (ret == -ENOMEM) {
+			/* Try to send the packet if we could not allocate
+			 * enough network packets and hope the original large
+			 * packet can be sent ok.
+			 */
+			return NET_OK;
+		}
+	}
+
+	/* We "fake" the sending of the packet here so that
+	 * tcp.c:tcp_retry_expired() will increase the ref count when
+	 * re-sending the packet. This is crucial thing to do here and
+	 * will cause free memory access if not done.
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP)) {
+		net_pkt_set_sent(pkt, true);
+	}
+
+	/* We need to unref here because we simulate the packet sending. */
+	net_pkt_unref(pkt);
+
+	/* No need to continue with the sending as the packet is now split
+	 * and its fragments will be sent separately to network.
+	 */
+	return NET_CONTINUE;
+}
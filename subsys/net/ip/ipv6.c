@@ -449,6 +449,7 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 #endif
 
 	net_stats_update_ipv6_recv(pkt_iface);
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_IP);
 
 	hdr = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
 	if (!hdr) {
@@ -1403,9 +1403,31 @@ static void set_pkt_txtime(struct net_pkt *pkt, const struct msghdr *msghdr)
 	}
 }
 
+/* Unlink the caller owned fragments from the packet so that they are not
+ * freed together with it.
+ */
+static void context_detach_frags(struct net_pkt *pkt, struct net_buf *frags)
+{
+	struct net_buf *buf = pkt->buffer;
+
+	if (buf == frags) {
+		pkt->buffer = NULL;
+		return;
+	}
+
+	while (buf && buf->frags != frags) {
+		buf = buf->frags;
+	}
+
+	if (buf) {
+		buf->frags = NULL;
+	}
+}
+
 static int context_sendto(struct net_context *context,
 			  const void *buf,
 			  size_t len,
+			  struct net_buf *frags,
 			  const struct sockaddr *dst_addr,
 			  socklen_t addrlen,
 			  net_context_send_cb_t cb,
@@ -1621,15 +1643,32 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
-	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
-	if (!pkt) {
-		return -ENOBUFS;
-	}
+	if (frags) {
+		/* The data is already in network buffers, so only the
+		 * headers are allocated here.
+		 */
+		if (net_context_get_family(context) != AF_INET &&
+		    net_context_get_family(context) != AF_INET6) {
+			return -EOPNOTSUPP;
+		}
+
+		len = net_buf_frags_len(frags);
 
-	tmp_len = net_pkt_available_payload_buffer(
+		pkt = context_alloc_pkt(context, 0, PKT_WAIT_TIME);
+		if (!pkt) {
+			return -ENOBUFS;
+		}
+	} else {
+		pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+		if (!pkt) {
+			return -ENOBUFS;
+		}
+
+		tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_ip_proto(context));
-	if (tmp_len < len) {
-		len = tmp_len;
+		if (tmp_len < len) {
+			len = tmp_len;
+		}
 	}
 
 	context->send_cb = cb;
@@ -1658,6 +1697,11 @@ static int context_sendto(struct net_context *context,
 
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
+		if (frags) {
+			ret = -EOPNOTSUPP;
+			goto fail;
+		}
+
 		ret = context_write_data(pkt, buf, len, msghdr);
 		if (ret < 0) {
 			goto fail;
@@ -1675,21 +1719,35 @@ static int context_sendto(struct net_context *context,
 		}
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
-		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
+		ret = context_setup_udp_packet(context, pkt, buf,
+					       frags ? 0 : len, msghdr,
 					       dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
 
+		if (frags) {
+			net_pkt_append_buffer(pkt, frags);
+		}
+
 		context_finalize_packet(context, pkt);
 
 		ret = net_send_data(pkt);
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
 
-		ret = context_write_data(pkt, buf, len, msghdr);
-		if (ret < 0) {
-			goto fail;
+		if (frags) {
+			/* TCP adds the headers itself when segmenting */
+			if (pkt->buffer) {
+				net_buf_unref(pkt->buffer);
+			}
+
+			pkt->buffer = frags;
+		} else {
+			ret = context_write_data(pkt, buf, len, msghdr);
+			if (ret < 0) {
+				goto fail;
+			}
 		}
 
 		net_pkt_cursor_init(pkt);
@@ -1698,7 +1756,10 @@ static int context_sendto(struct net_context *context,
 			goto fail;
 		}
 
-		ret = net_tcp_send_data(context, cb, user_data);
+		/* Once queued, the packet and its data belong to TCP, so
+		 * nothing may be freed or handed back to the caller here.
+		 */
+		(void)net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
 		ret = context_write_data(pkt, buf, len, msghdr);
@@ -1737,47 +1798,60 @@ static int context_sendto(struct net_context *context,
 
 	return len;
 fail:
+	if (frags) {
+		context_detach_frags(pkt, frags);
+	}
+
 	net_pkt_unref(pkt);
 
 	return ret;
 }
 
-int net_context_send(struct net_context *context,
-		     const void *buf,
-		     size_t len,
-		     net_context_send_cb_t cb,
-		     k_timeout_t timeout,
-		     void *user_data)
+static int context_remote_addrlen(struct net_context *context,
+				  socklen_t *addrlen)
 {
-	socklen_t addrlen;
-	int ret = 0;
-
-	k_mutex_lock(&context->lock, K_FOREVER);
-
 	if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
 	    !net_sin(&context->remote)->sin_port) {
-		ret = -EDESTADDRREQ;
-		goto unlock;
+		return -EDESTADDRREQ;
 	}
 
 	if (IS_ENABLED(CONFIG_NET_IPV6) &&
 	    net_context_get_family(context) == AF_INET6) {
-		addrlen = sizeof(struct sockaddr_in6);
+		*addrlen = sizeof(struct sockaddr_in6);
 	} else if (IS_ENABLED(CONFIG_NET_IPV4) &&
 		   net_context_get_family(context) == AF_INET) {
-		addrlen = sizeof(struct sockaddr_in);
+		*addrlen = sizeof(struct sockaddr_in);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = -EOPNOTSUPP;
-		goto unlock;
+		return -EOPNOTSUPP;
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN) {
-		addrlen = sizeof(struct sockaddr_can);
+		*addrlen = sizeof(struct sockaddr_can);
 	} else {
-		addrlen = 0;
+		*addrlen = 0;
+	}
+
+	return 0;
+}
+
+int net_context_send(struct net_context *context,
+		     const void *buf,
+		     size_t len,
+		     net_context_send_cb_t cb,
+		     k_timeout_t timeout,
+		     void *user_data)
+{
+	socklen_t addrlen;
+	int ret;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	ret = context_remote_addrlen(context, &addrlen);
+	if (ret < 0) {
+		goto unlock;
 	}
 
-	ret = context_sendto(context, buf, len, &context->remote,
+	ret = context_sendto(context, buf, len, NULL, &context->remote,
 			     addrlen, cb, timeout, user_data, false);
 unlock:
 	k_mutex_unlock(&context->lock);
@@ -1796,7 +1870,7 @@ int net_context_sendmsg(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, msghdr, 0, NULL, 0,
+	ret = context_sendto(context, msghdr, 0, NULL, NULL, 0,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -1817,7 +1891,7 @@ int net_context_sendto(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, buf, len, dst_addr, addrlen,
+	ret = context_sendto(context, buf, len, NULL, dst_addr, addrlen,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -1825,6 +1899,39 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *frags,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data)
+{
+	int ret = 0;
+
+	if (!frags) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!dst_addr) {
+		ret = context_remote_addrlen(context, &addrlen);
+		if (ret < 0) {
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+	}
+
+	ret = context_sendto(context, NULL, 0, frags, dst_addr, addrlen,
+			     cb, timeout, user_data, dst_addr != &context->remote);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -78,6 +78,16 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	}
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	/* Same thing for a reassembled IPv4 packet, it still has the MF
+	 * flag of its first fragment set.
+	 */
+	if (net_pkt_family(pkt) == AF_INET &&
+	    net_pkt_ipv4_fragment_more(pkt)) {
+		locally_routed = true;
+	}
+#endif
+
 	/* If there is no data, then drop the packet. */
 	if (!pkt->frags) {
 		NET_DBG("Corrupted packet (frags %p)", pkt->frags);
@@ -324,6 +334,8 @@ int net_send_data(struct net_pkt *pkt)
 	net_pkt_trim_buffer(pkt);
 	net_pkt_cursor_init(pkt);
 
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_TX_IP);
+
 	status = check_ip_addr(pkt);
 	if (status < 0) {
 		return status;
@@ -332,6 +344,8 @@ int net_send_data(struct net_pkt *pkt)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
+		net_pkt_trace_reset(pkt);
+		net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_DRIVER);
 		processing_data(pkt, true);
 		return 0;
 	}
@@ -371,6 +385,7 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 void net_process_rx_packet(struct net_pkt *pkt)
 {
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_L2);
 
 	net_capture_pkt(net_pkt_iface(pkt), pkt);
 
@@ -381,6 +396,12 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_rx_priority2tc(prio);
+	uint8_t queue = tc;
+
+#if defined(CONFIG_NET_TC_RX_FLOW_HASH)
+	queue = net_rx_flow2queue(pkt);
+	net_stats_update_flow_queue_recv(iface, queue, net_pkt_get_len(pkt));
+#endif
 
 #if defined(CONFIG_NET_STATISTICS)
 	net_stats_update_tc_recv_pkt(iface, tc);
@@ -389,13 +410,13 @@ static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 #endif
 
 #if NET_TC_RX_COUNT > 1
-	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
+	NET_DBG("TC %d queue %d with prio %d pkt %p", tc, queue, prio, pkt);
 #endif
 
 	if (NET_TC_RX_COUNT == 0) {
 		net_process_rx_packet(pkt);
 	} else {
-		net_tc_submit_to_rx_queue(tc, pkt);
+		net_tc_submit_to_rx_queue(queue, pkt);
 	}
 }
 
@@ -417,6 +438,10 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 	net_pkt_set_overwrite(pkt, true);
 	net_pkt_cursor_init(pkt);
 
+	/* A looped back packet still has its TX stages */
+	net_pkt_trace_reset(pkt);
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_DRIVER);
+
 	NET_DBG("prio %d iface %p pkt %p len %zu", net_pkt_priority(pkt),
 		iface, pkt, net_pkt_get_len(pkt));
 
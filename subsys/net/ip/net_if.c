@@ -24,7 +24,9 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 
 #include "net_private.h"
 #include "ipv6.h"
+#include "ipv4.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -223,6 +225,8 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 
 	create_time = net_pkt_create_time(pkt);
 
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_TX_L2);
+
 	debug_check_packet(pkt);
 
 	/* If there're any link callbacks, with such a callback receiving
@@ -258,7 +262,18 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (IS_ENABLED(CONFIG_NET_PKT_LATENCY_TRACE)) {
+			/* Keep the trace stages over L2 send */
+			net_pkt_ref(pkt);
+		}
+
+		if (IS_ENABLED(CONFIG_NET_TCP_GSO) && net_pkt_gso_size(pkt) &&
+		    net_if_need_tcp_segmentation(iface)) {
+			/* Segment the packet here if the device cannot */
+			status = net_tcp_gso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
 			uint32_t end_tick = k_cycle_get_32();
@@ -291,6 +306,14 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
+		if (IS_ENABLED(CONFIG_NET_PKT_LATENCY_TRACE)) {
+			if (status >= 0) {
+				net_pkt_trace_done(pkt, true);
+			}
+
+			net_pkt_unref(pkt);
+		}
+
 	} else {
 		/* Drop packet if interface is not up */
 		NET_WARN("iface %p is down", iface);
@@ -342,6 +365,7 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 
 	uint8_t prio = net_pkt_priority(pkt);
 	uint8_t tc = net_tx_priority2tc(prio);
+	uint8_t queue = tc;
 
 	net_stats_update_tc_sent_pkt(iface, tc);
 	net_stats_update_tc_sent_bytes(iface, tc, net_pkt_get_len(pkt));
@@ -359,15 +383,20 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 		return;
 	}
 
+#if defined(CONFIG_NET_TC_TX_FLOW_HASH)
+	queue = net_tx_flow2queue(pkt);
+	net_stats_update_flow_queue_sent(iface, queue, net_pkt_get_len(pkt));
+#endif
+
 #if NET_TC_TX_COUNT > 1
-	NET_DBG("TC %d with prio %d pkt %p", tc, prio, pkt);
+	NET_DBG("TC %d queue %d with prio %d pkt %p", tc, queue, prio, pkt);
 #endif
 
 #if defined(CONFIG_NET_POWER_MANAGEMENT)
 	iface->tx_pending++;
 #endif
 
-	if (!net_tc_submit_to_tx_queue(tc, pkt)) {
+	if (!net_tc_submit_to_tx_queue(queue, pkt)) {
 #if defined(CONFIG_NET_POWER_MANAGEMENT)
 		iface->tx_pending--
 #endif
@@ -480,6 +509,10 @@ enum net_verdict net_if_send_data(struct net_if *iface, struct net_pkt *pkt)
 	 */
 	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
 		verdict = net_ipv6_prepare_for_send(pkt);
+	} else if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) &&
+		   net_pkt_family(pkt) == AF_INET) {
+		/* Fragment the packet if it does not fit in the MTU */
+		verdict = net_ipv4_prepare_for_send(pkt);
 	}
 
 done:
@@ -3991,6 +4024,11 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface)
 	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
 }
 
+bool net_if_need_tcp_segmentation(struct net_if *iface)
+{
+	return need_calc_checksum(iface, ETHERNET_HW_TSO);
+}
+
 int net_if_get_by_iface(struct net_if *iface)
 {
 	if (!(iface >= _net_if_list_start && iface < _net_if_list_end)) {
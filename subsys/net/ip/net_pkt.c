@@ -123,7 +123,23 @@ NET_BUF_POOL_FIXED_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
 NET_BUF_POOL_FIXED_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
 			  CONFIG_NET_BUF_DATA_SIZE, 4, NULL);
 
-#else /* !CONFIG_NET_BUF_FIXED_DATA_SIZE */
+#elif defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+
+NET_BUF_SHARED_HEAP_DEFINE(net_pkt_shared_bufs,
+			   CONFIG_NET_BUF_SHARED_POOL_SIZE,
+			   CONFIG_NET_BUF_SHARED_POOL_SIZE *
+			   CONFIG_NET_BUF_SHARED_POOL_HIGH_WATERMARK / 100,
+			   CONFIG_NET_BUF_SHARED_POOL_SIZE *
+			   CONFIG_NET_BUF_SHARED_POOL_LOW_WATERMARK / 100);
+
+NET_BUF_POOL_ELASTIC_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
+			    CONFIG_NET_BUF_DATA_POOL_SIZE, net_pkt_shared_bufs,
+			    4, NULL);
+NET_BUF_POOL_ELASTIC_DEFINE(tx_bufs, CONFIG_NET_BUF_TX_COUNT,
+			    CONFIG_NET_BUF_DATA_POOL_SIZE, net_pkt_shared_bufs,
+			    4, NULL);
+
+#else /* CONFIG_NET_BUF_VARIABLE_DATA_SIZE */
 
 NET_BUF_POOL_VAR_DEFINE(rx_bufs, CONFIG_NET_BUF_RX_COUNT,
 			CONFIG_NET_BUF_DATA_POOL_SIZE, 4, NULL);
@@ -838,6 +854,13 @@ void net_pkt_get_info(struct k_mem_slab **rx,
 	}
 }
 
+#if defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+struct net_buf_shared_heap *net_pkt_get_shared_data(void)
+{
+	return &net_pkt_shared_bufs;
+}
+#endif
+
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
 void net_pkt_print(void)
 {
@@ -1258,6 +1281,7 @@ static struct net_pkt *pkt_alloc(struct k_mem_slab *slab, k_timeout_t timeout)
 
 	if (&tx_pkts == slab) {
 		net_pkt_set_priority(pkt, TX_DEFAULT_PRIORITY);
+		net_pkt_trace_set(pkt, NET_PKT_TRACE_TX_APP);
 	} else if (&rx_pkts == slab) {
 		net_pkt_set_priority(pkt, RX_DEFAULT_PRIORITY);
 	}
@@ -1774,6 +1798,11 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
 	net_pkt_set_captured(clone_pkt, net_pkt_is_captured(pkt));
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
+
+#if defined(CONFIG_NET_PKT_LATENCY_TRACE)
+	memcpy(clone_pkt->trace, pkt->trace, sizeof(clone_pkt->trace));
+#endif
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
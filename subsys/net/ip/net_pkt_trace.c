@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+#include <sys/atomic.h>
+#include <tracing/tracing.h>
+
+#include <net/net_pkt.h>
+
+#define RING_SIZE CONFIG_NET_PKT_LATENCY_TRACE_RING_SIZE
+
+BUILD_ASSERT((RING_SIZE & (RING_SIZE - 1)) == 0,
+	     "Latency trace ring size must be a power of two");
+
+/* Packets are finished by whichever thread reads or sends them, so the
+ * ring has no lock. A writer claims a slot by incrementing the head, and
+ * marks the slot with an odd sequence number while it copies the record
+ * and an even one when it is done. A reader only trusts its copy if the
+ * sequence number was the expected even one both before and after the
+ * copy. A record can still be mixed if the ring wraps around while it is
+ * being written, which only happens if the ring is far too small.
+ */
+static struct net_pkt_trace_record ring[RING_SIZE];
+static atomic_t ring_seq[RING_SIZE];
+static atomic_t ring_head;
+
+/* Index 0 of the stages is the total latency, see net_pkt_trace_hist_get() */
+static atomic_t hist[2][NET_PKT_TRACE_STAGES][NET_PKT_TRACE_HIST_BUCKETS];
+
+static inline int hist_bucket(uint32_t ns)
+{
+	return MIN(find_msb_set(ns / NSEC_PER_USEC),
+		   NET_PKT_TRACE_HIST_BUCKETS - 1);
+}
+
+static inline uint32_t cyc_to_ns(uint32_t cycles)
+{
+	return (uint32_t)MIN(k_cyc_to_ns_floor64(cycles), UINT32_MAX);
+}
+
+static void ring_push(const struct net_pkt_trace_record *rec)
+{
+	uint32_t n = (uint32_t)atomic_inc(&ring_head);
+	int slot = n & (RING_SIZE - 1);
+
+	atomic_set(&ring_seq[slot], (atomic_val_t)(2U * n + 1U));
+	memcpy(&ring[slot], rec, sizeof(*rec));
+	atomic_set(&ring_seq[slot], (atomic_val_t)(2U * n + 2U));
+}
+
+void net_pkt_trace_done(struct net_pkt *pkt, bool tx)
+{
+	struct net_pkt_trace_record rec = {
+		.pkt = (uintptr_t)pkt,
+		.tx = tx,
+	};
+	int last = tx ? NET_PKT_TRACE_TX_DRIVER : NET_PKT_TRACE_RX_APP;
+	uint32_t first = 0U, prev = 0U;
+	int i;
+
+	net_pkt_trace_set(pkt, last);
+
+	for (i = 0; i <= last; i++) {
+		uint32_t stamp = pkt->trace[i];
+
+		if (!stamp) {
+			continue;
+		}
+
+		if (!first) {
+			first = stamp;
+		} else {
+			rec.stage_ns[i] = cyc_to_ns(stamp - prev);
+			atomic_inc(&hist[tx][i][hist_bucket(rec.stage_ns[i])]);
+		}
+
+		prev = stamp;
+	}
+
+	rec.total_ns = cyc_to_ns(prev - first);
+	atomic_inc(&hist[tx][0][hist_bucket(rec.total_ns)]);
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP)
+	rec.timestamp = *net_pkt_timestamp(pkt);
+	rec.has_timestamp = rec.timestamp.second ||
+			    rec.timestamp.nanosecond;
+#endif
+
+	ring_push(&rec);
+
+	SYS_PORT_TRACING_FUNC(net_pkt, latency, &rec);
+
+	net_pkt_trace_reset(pkt);
+}
+
+int net_pkt_trace_foreach(net_pkt_trace_cb_t cb, void *user_data)
+{
+	struct net_pkt_trace_record rec;
+	uint32_t head = (uint32_t)atomic_get(&ring_head);
+	uint32_t n = head < RING_SIZE ? 0U : head - RING_SIZE;
+	int count = 0;
+
+	for (; n != head; n++) {
+		int slot = n & (RING_SIZE - 1);
+		uint32_t seq = 2U * n + 2U;
+
+		if ((uint32_t)atomic_get(&ring_seq[slot]) != seq) {
+			continue;
+		}
+
+		memcpy(&rec, &ring[slot], sizeof(rec));
+
+		/* The copy must be done before the sequence number is read
+		 * again, also as seen by other CPUs. The writer needs no
+		 * fence, atomic_set() is a full barrier.
+		 */
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+		if ((uint32_t)atomic_get(&ring_seq[slot]) != seq) {
+			continue;
+		}
+
+		cb(&rec, user_data);
+		count++;
+	}
+
+	return count;
+}
+
+void net_pkt_trace_hist_get(bool tx, enum net_pkt_trace_stage stage,
+			    uint32_t buckets[NET_PKT_TRACE_HIST_BUCKETS])
+{
+	int i;
+
+	for (i = 0; i < NET_PKT_TRACE_HIST_BUCKETS; i++) {
+		buckets[i] = (uint32_t)atomic_get(&hist[tx][stage][i]);
+	}
+}
@@ -90,6 +90,15 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+#if defined(CONFIG_NET_TC_RX_FLOW_HASH)
+extern uint8_t net_rx_flow2queue(struct net_pkt *pkt);
+#endif
+#if defined(CONFIG_NET_TCP_GRO)
+extern int net_tc_rx_queue_current(void);
+#endif
+#if defined(CONFIG_NET_TC_TX_FLOW_HASH)
+extern uint8_t net_tx_flow2queue(struct net_pkt *pkt);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -143,6 +152,8 @@ extern char *net_byte_to_hex(char *ptr, uint8_t byte, char base, bool pad);
 extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
+extern uint16_t net_calc_chksum_data(uint16_t sum, const uint8_t *data,
+				     size_t len);
 
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
@@ -203,6 +214,72 @@ static inline uint16_t net_calc_chksum_tcp(struct net_pkt *pkt)
 	return net_calc_chksum(pkt, IPPROTO_TCP);
 }
 
+/**
+ * @brief Update a checksum after a 16-bit field of the data changed
+ *
+ * This is the incremental update of RFC 1624, eqn. 3. All the values are
+ * as stored in the packet, in network byte order.
+ *
+ * @param chksum	Checksum before the change
+ * @param old_val	Old value of the field
+ * @param new_val	New value of the field
+ *
+ * @return Checksum covering the new value
+ */
+static inline uint16_t net_chksum_update_16(uint16_t chksum, uint16_t old_val,
+					    uint16_t new_val)
+{
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
+/**
+ * @brief Update a checksum after a 32-bit field of the data changed
+ *
+ * @param chksum	Checksum before the change
+ * @param old_val	Old value of the field, in network byte order
+ * @param new_val	New value of the field, in network byte order
+ *
+ * @return Checksum covering the new value
+ */
+static inline uint16_t net_chksum_update_32(uint16_t chksum, uint32_t old_val,
+					    uint32_t new_val)
+{
+	chksum = net_chksum_update_16(chksum, old_val >> 16, new_val >> 16);
+
+	return net_chksum_update_16(chksum, old_val, new_val);
+}
+
+/**
+ * @brief Update a checksum after a field of the data changed, like an
+ * address in a pseudo header
+ *
+ * @param chksum	Checksum before the change
+ * @param old_val	Old content of the field
+ * @param new_val	New content of the field
+ * @param len		Length of the field, must be even
+ *
+ * @return Checksum covering the new content
+ */
+static inline uint16_t net_chksum_update(uint16_t chksum, const void *old_val,
+					 const void *new_val, size_t len)
+{
+	const uint8_t *old_ptr = old_val;
+	const uint8_t *new_ptr = new_val;
+
+	for (size_t i = 0; i < len; i += 2) {
+		chksum = net_chksum_update_16(
+			chksum, UNALIGNED_GET((uint16_t *)&old_ptr[i]),
+			UNALIGNED_GET((uint16_t *)&new_ptr[i]));
+	}
+
+	return chksum;
+}
+
 static inline char *net_sprint_ll_addr(const uint8_t *ll, uint8_t ll_len)
 {
 	static char buf[sizeof("xx:xx:xx:xx:xx:xx:xx:xx")];
@@ -39,6 +39,7 @@ LOG_MODULE_REGISTER(net_shell, LOG_LEVEL_DBG);
 #endif
 
 #include "ipv6.h"
+#include "ipv4.h"
 
 #if defined(CONFIG_NET_ARP)
 #include "ethernet/arp.h"
@@ -260,6 +261,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_QBV,                  "IEEE 802.1Qbv (scheduled traffic)"),
 	EC(ETHERNET_QBU,                  "IEEE 802.1Qbu (frame preemption)"),
 	EC(ETHERNET_TXTIME,               "TXTIME"),
+	EC(ETHERNET_HW_TSO,               "TCP segmentation offload"),
 	EC(ETHERNET_PROMISC_MODE,         "Promiscuous mode"),
 	EC(ETHERNET_PRIORITY_QUEUES,      "Priority queues"),
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
@@ -771,6 +773,44 @@ static void iface_per_route_cb(struct net_if *iface, void *user_data)
 }
 #endif /* CONFIG_NET_ROUTE */
 
+#if defined(CONFIG_NET_ROUTE_IPV4)
+static void route_ipv4_cb(struct net_route_entry_ipv4 *entry, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	struct net_if *iface = data->user_data;
+
+	if (entry->iface != iface) {
+		return;
+	}
+
+	PR("IPv4 prefix : %s/%d\t", net_sprint_ipv4_addr(&entry->addr),
+	   entry->prefix_len);
+
+	if (net_ipv4_is_addr_unspecified(&entry->gw)) {
+		PR("gateway : <on-link>\n");
+	} else {
+		PR("gateway : %s\n", net_sprint_ipv4_addr(&entry->gw));
+	}
+}
+
+static void iface_per_route_ipv4_cb(struct net_if *iface, void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	const char *extra;
+
+	PR("\nIPv4 routes for interface %d (%p) (%s)\n",
+	   net_if_get_by_iface(iface), iface,
+	   iface2str(iface, &extra));
+	PR("=========================================%s\n", extra);
+
+	data->user_data = iface;
+
+	net_route_ipv4_foreach(route_ipv4_cb, data);
+}
+#endif /* CONFIG_NET_ROUTE_IPV4 */
+
 #if defined(CONFIG_NET_ROUTE_MCAST) && defined(CONFIG_NET_NATIVE)
 static void route_mcast_cb(struct net_route_entry_mcast *entry,
 			   void *user_data)
@@ -1163,6 +1203,39 @@ static void print_tc_rx_stats(const struct shell *shell, struct net_if *iface)
 #endif /* NET_TC_RX_COUNT > 1 */
 }
 
+static void print_flow_queue_stats(const struct shell *shell,
+				   struct net_if *iface)
+{
+#if defined(CONFIG_NET_STATISTICS_FLOW_QUEUES)
+	int i;
+
+#if defined(CONFIG_NET_TC_TX_FLOW_HASH)
+	PR("TX flow queue statistics:\n");
+	PR("Queue\tSent pkts\tbytes\n");
+
+	for (i = 0; i < NET_TC_TX_COUNT; i++) {
+		PR("[%d]\t%d\t\t%d\n", i,
+		   GET_STAT(iface, flow_queues.sent[i].pkts),
+		   GET_STAT(iface, flow_queues.sent[i].bytes));
+	}
+#endif /* CONFIG_NET_TC_TX_FLOW_HASH */
+
+#if defined(CONFIG_NET_TC_RX_FLOW_HASH)
+	PR("RX flow queue statistics:\n");
+	PR("Queue\tRecv pkts\tbytes\n");
+
+	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+		PR("[%d]\t%d\t\t%d\n", i,
+		   GET_STAT(iface, flow_queues.recv[i].pkts),
+		   GET_STAT(iface, flow_queues.recv[i].bytes));
+	}
+#endif /* CONFIG_NET_TC_RX_FLOW_HASH */
+#else
+	ARG_UNUSED(shell);
+	ARG_UNUSED(iface);
+#endif /* CONFIG_NET_STATISTICS_FLOW_QUEUES */
+}
+
 static void print_net_pm_stats(const struct shell *shell, struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
@@ -1182,6 +1255,101 @@ static void print_net_pm_stats(const struct shell *shell, struct net_if *iface)
 #endif
 }
 
+#if defined(CONFIG_NET_PKT_LATENCY_TRACE)
+/* Index 0 of the histograms is the total latency */
+static const char * const rx_trace_stages[] = {
+	"total", "L2", "IP", "transport", "socket", "app"
+};
+
+static const char * const tx_trace_stages[] = {
+	"total", "transport", "IP", "L2", "driver"
+};
+
+struct slowest_pkt {
+	struct net_pkt_trace_record rec[2];
+	bool found[2];
+};
+
+static void find_slowest_pkt(const struct net_pkt_trace_record *rec,
+			     void *user_data)
+{
+	struct slowest_pkt *slowest = user_data;
+
+	if (!slowest->found[rec->tx] ||
+	    rec->total_ns > slowest->rec[rec->tx].total_ns) {
+		slowest->rec[rec->tx] = *rec;
+		slowest->found[rec->tx] = true;
+	}
+}
+
+static void print_net_pkt_latency_dir(const struct shell *shell,
+				      struct slowest_pkt *slowest, bool tx)
+{
+	const char * const *stages = tx ? tx_trace_stages : rx_trace_stages;
+	int count = tx ? ARRAY_SIZE(tx_trace_stages) :
+			 ARRAY_SIZE(rx_trace_stages);
+	uint32_t buckets[NET_PKT_TRACE_HIST_BUCKETS];
+	int i, j;
+
+	PR("%s packet latency histogram (us):\n", tx ? "TX" : "RX");
+
+	for (i = 0; i < count; i++) {
+		net_pkt_trace_hist_get(tx, i, buckets);
+
+		PR("\t%-10s", stages[i]);
+
+		for (j = 0; j < NET_PKT_TRACE_HIST_BUCKETS; j++) {
+			if (!buckets[j]) {
+				continue;
+			}
+
+			if (j == NET_PKT_TRACE_HIST_BUCKETS - 1) {
+				PR(" >=%u:%u", 1U << (j - 1), buckets[j]);
+			} else {
+				PR(" <%u:%u", 1U << j, buckets[j]);
+			}
+		}
+
+		PR("\n");
+	}
+
+	if (!slowest->found[tx]) {
+		return;
+	}
+
+	PR("Slowest recent %s packet %p (ns):", tx ? "TX" : "RX",
+	   (void *)slowest->rec[tx].pkt);
+
+	for (i = 1; i < count; i++) {
+		PR(" %s %u", stages[i], slowest->rec[tx].stage_ns[i]);
+	}
+
+	PR(" total %u\n", slowest->rec[tx].total_ns);
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP)
+	if (slowest->rec[tx].has_timestamp) {
+		PR("\thardware timestamp %" PRIu64 ".%09u\n",
+		   slowest->rec[tx].timestamp.second,
+		   slowest->rec[tx].timestamp.nanosecond);
+	}
+#endif
+}
+#endif /* CONFIG_NET_PKT_LATENCY_TRACE */
+
+static void print_net_pkt_latency(const struct shell *shell)
+{
+#if defined(CONFIG_NET_PKT_LATENCY_TRACE)
+	struct slowest_pkt slowest = { 0 };
+
+	net_pkt_trace_foreach(find_slowest_pkt, &slowest);
+
+	print_net_pkt_latency_dir(shell, &slowest, false);
+	print_net_pkt_latency_dir(shell, &slowest, true);
+#else
+	ARG_UNUSED(shell);
+#endif
+}
+
 static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 {
 	struct net_shell_user_data *data = user_data;
@@ -1224,6 +1392,14 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, ipv4.sent),
 	   GET_STAT(iface, ipv4.drop),
 	   GET_STAT(iface, ipv4.forwarded));
+#if defined(CONFIG_NET_STATISTICS_IPV4_FRAGMENT)
+	PR("IPv4 frag recv %d\tsent\t%d\tdrop\t%d\treassembled\t%d\ttimeout\t%d\n",
+	   GET_STAT(iface, ipv4_frag.recv),
+	   GET_STAT(iface, ipv4_frag.sent),
+	   GET_STAT(iface, ipv4_frag.drop),
+	   GET_STAT(iface, ipv4_frag.reassembled),
+	   GET_STAT(iface, ipv4_frag.timeout));
+#endif /* CONFIG_NET_STATISTICS_IPV4_FRAGMENT */
 #endif /* CONFIG_NET_STATISTICS_IPV4 */
 
 	PR("IP vhlerr      %d\thblener\t%d\tlblener\t%d\n",
@@ -1250,6 +1426,16 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, ipv4_igmp.sent),
 	   GET_STAT(iface, ipv4_igmp.drop));
 #endif /* CONFIG_NET_STATISTICS_IGMP */
+#if defined(CONFIG_NET_STATISTICS_CONN_DEMUX)
+	if (GET_STAT(iface, conn_demux.count) > 0) {
+		PR("Conn lookup    %d\tavg\t%u ns\tcompared %u\n",
+		   GET_STAT(iface, conn_demux.count),
+		   (uint32_t)(GET_STAT(iface, conn_demux.sum) /
+			      GET_STAT(iface, conn_demux.count)),
+		   GET_STAT(iface, conn_demux.visited) /
+		   GET_STAT(iface, conn_demux.count));
+	}
+#endif /* CONFIG_NET_STATISTICS_CONN_DEMUX */
 #if defined(CONFIG_NET_STATISTICS_UDP) && defined(CONFIG_NET_NATIVE_UDP)
 	PR("UDP recv       %d\tsent\t%d\tdrop\t%d\n",
 	   GET_STAT(iface, udp.recv),
@@ -1287,6 +1473,7 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 
 	print_tc_tx_stats(shell, iface);
 	print_tc_rx_stats(shell, iface);
+	print_flow_queue_stats(shell, iface);
 
 #if defined(CONFIG_NET_STATISTICS_ETHERNET) && \
 					defined(CONFIG_NET_STATISTICS_USER_API)
@@ -1600,6 +1787,50 @@ static void ipv6_frag_cb(struct net_ipv6_reassembly *reass,
 }
 #endif /* CONFIG_NET_IPV6_FRAGMENT */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+static void ipv4_frag_cb(struct net_ipv4_reassembly *reass,
+			 void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *count = data->user_data;
+	char src[ADDR_LEN];
+	int i;
+
+	if (!*count) {
+		PR("\nIPv4 reassembly Id     Remain "
+		   "Src             \tDst\n");
+	}
+
+	snprintk(src, ADDR_LEN, "%s", net_sprint_ipv4_addr(&reass->src));
+
+	PR("%p      0x%04x  %5d %16s\t%16s\n", reass, reass->id,
+	   k_ticks_to_ms_ceil32(k_work_delayable_remaining_get(&reass->timer)),
+	   src, net_sprint_ipv4_addr(&reass->dst));
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		if (reass->pkt[i]) {
+			struct net_buf *frag = reass->pkt[i]->frags;
+
+			PR("[%d] pkt %p->", i, reass->pkt[i]);
+
+			while (frag) {
+				PR("%p", frag);
+
+				frag = frag->frags;
+				if (frag) {
+					PR("->");
+				}
+			}
+
+			PR("\n");
+		}
+	}
+
+	(*count)++;
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 #if defined(CONFIG_NET_DEBUG_NET_PKT_ALLOC)
 static void allocs_cb(struct net_pkt *pkt,
 		      struct net_buf *buf,
@@ -2074,6 +2305,12 @@ static int cmd_net_conn(const struct shell *shell, size_t argc, char *argv[])
 	/* Do not print anything if no fragments are pending atm */
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	count = 0;
+
+	net_ipv4_frag_foreach(ipv4_frag_cb, &user_data);
+#endif
+
 #else
 	PR_INFO("Set %s to enable %s support.\n",
 		"CONFIG_NET_OFFLOAD or CONFIG_NET_NATIVE",
@@ -3654,10 +3891,17 @@ static int cmd_net_mem(const struct shell *shell, size_t argc, char *argv[])
 #if defined(CONFIG_NET_OFFLOAD) || defined(CONFIG_NET_NATIVE)
 	struct k_mem_slab *rx, *tx;
 	struct net_buf_pool *rx_data, *tx_data;
+#if defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+	struct net_buf_shared_heap *shared;
+#endif
 
 	net_pkt_get_info(&rx, &tx, &rx_data, &tx_data);
 
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
 	PR("Fragment length %d bytes\n", CONFIG_NET_BUF_DATA_SIZE);
+#else
+	PR("Data pool size %d bytes\n", CONFIG_NET_BUF_DATA_POOL_SIZE);
+#endif
 
 	PR("Network buffer pools:\n");
 
@@ -3686,6 +3930,19 @@ static int cmd_net_mem(const struct shell *shell, size_t argc, char *argv[])
 		"CONFIG_NET_BUF_POOL_USAGE", "net_buf allocation");
 #endif /* CONFIG_NET_BUF_POOL_USAGE */
 
+#if defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+	shared = net_pkt_get_shared_data();
+
+	PR("\nShared data pool %d bytes, watermarks %zd/%zd bytes\n",
+	   CONFIG_NET_BUF_SHARED_POOL_SIZE, shared->high_wm, shared->low_wm);
+	PR("Borrowed\tRX %zd\tTX %zd\tTotal %zd\tMax %zd\n",
+	   net_buf_pool_borrowed(rx_data), net_buf_pool_borrowed(tx_data),
+	   shared->used, shared->max_used);
+	PR("Borrows %u\tFailed %u\tPressure %u (%s)\n",
+	   shared->borrows, shared->failures, shared->pressure_count,
+	   net_buf_shared_heap_pressure(shared) ? "on" : "off");
+#endif /* CONFIG_NET_BUF_ELASTIC_DATA_SIZE */
+
 	if (IS_ENABLED(CONFIG_NET_CONTEXT_NET_PKT_POOL)) {
 		struct net_shell_user_data user_data;
 		struct ctx_info info;
@@ -4417,21 +4674,27 @@ static int cmd_net_route(const struct shell *shell, size_t argc, char *argv[])
 	ARG_UNUSED(argv);
 
 #if defined(CONFIG_NET_NATIVE)
-#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST)
+#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST) || \
+	defined(CONFIG_NET_ROUTE_IPV4)
 	struct net_shell_user_data user_data;
 #endif
 
-#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST)
+#if defined(CONFIG_NET_ROUTE) || defined(CONFIG_NET_ROUTE_MCAST) || \
+	defined(CONFIG_NET_ROUTE_IPV4)
 	user_data.shell = shell;
 #endif
 
 #if defined(CONFIG_NET_ROUTE)
 	net_if_foreach(iface_per_route_cb, &user_data);
-#else
+#elif !defined(CONFIG_NET_ROUTE_IPV4)
 	PR_INFO("Set %s to enable %s support.\n", "CONFIG_NET_ROUTE",
 		"network route");
 #endif
 
+#if defined(CONFIG_NET_ROUTE_IPV4)
+	net_if_foreach(iface_per_route_ipv4_cb, &user_data);
+#endif
+
 #if defined(CONFIG_NET_ROUTE_MCAST)
 	net_if_foreach(iface_per_mcast_route_cb, &user_data);
 #endif
@@ -4469,6 +4732,8 @@ static int cmd_net_stats_all(const struct shell *shell, size_t argc,
 
 	/* Print global network statistics */
 	net_shell_print_statistics_all(&user_data);
+
+	print_net_pkt_latency(shell);
 #else
 	ARG_UNUSED(argc);
 	ARG_UNUSED(argv);
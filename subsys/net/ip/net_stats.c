@@ -105,6 +105,15 @@ static inline void stats(struct net_if *iface)
 			 GET_STAT(iface, ipv4.sent),
 			 GET_STAT(iface, ipv4.drop),
 			 GET_STAT(iface, ipv4.forwarded));
+#if defined(CONFIG_NET_STATISTICS_IPV4_FRAGMENT)
+		NET_INFO("IPv4 frag recv %d\tsent\t%d\tdrop\t%d\t"
+			 "reassembled\t%d\ttimeout\t%d",
+			 GET_STAT(iface, ipv4_frag.recv),
+			 GET_STAT(iface, ipv4_frag.sent),
+			 GET_STAT(iface, ipv4_frag.drop),
+			 GET_STAT(iface, ipv4_frag.reassembled),
+			 GET_STAT(iface, ipv4_frag.timeout));
+#endif /* CONFIG_NET_STATISTICS_IPV4_FRAGMENT */
 #endif /* CONFIG_NET_STATISTICS_IPV4 */
 
 		NET_INFO("IP vhlerr      %d\thblener\t%d\tlblener\t%d",
@@ -48,6 +48,11 @@ static inline void net_stats_update_ip_errors_vhlerr(struct net_if *iface)
 	UPDATE_STAT(iface, stats.ip_errors.vhlerr++);
 }
 
+static inline void net_stats_update_ip_errors_fragerr(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ip_errors.fragerr++);
+}
+
 static inline void net_stats_update_bytes_recv(struct net_if *iface,
 					       uint32_t bytes)
 {
@@ -63,6 +68,7 @@ static inline void net_stats_update_bytes_sent(struct net_if *iface,
 #define net_stats_update_processing_error(iface)
 #define net_stats_update_ip_errors_protoerr(iface)
 #define net_stats_update_ip_errors_vhlerr(iface)
+#define net_stats_update_ip_errors_fragerr(iface)
 #define net_stats_update_bytes_recv(iface, bytes)
 #define net_stats_update_bytes_sent(iface, bytes)
 #endif /* CONFIG_NET_STATISTICS */
@@ -345,6 +351,39 @@ static inline void net_stats_update_ipv4_igmp_drop(struct net_if *iface)
 #define net_stats_update_ipv4_igmp_drop(iface)
 #endif /* CONFIG_NET_STATISTICS_IGMP */
 
+#if defined(CONFIG_NET_STATISTICS_IPV4_FRAGMENT) && defined(CONFIG_NET_NATIVE)
+static inline void net_stats_update_ipv4_frag_recv(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv4_frag.recv++);
+}
+
+static inline void net_stats_update_ipv4_frag_sent(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv4_frag.sent++);
+}
+
+static inline void net_stats_update_ipv4_frag_reassembled(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv4_frag.reassembled++);
+}
+
+static inline void net_stats_update_ipv4_frag_timeout(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv4_frag.timeout++);
+}
+
+static inline void net_stats_update_ipv4_frag_drop(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.ipv4_frag.drop++);
+}
+#else
+#define net_stats_update_ipv4_frag_recv(iface)
+#define net_stats_update_ipv4_frag_sent(iface)
+#define net_stats_update_ipv4_frag_reassembled(iface)
+#define net_stats_update_ipv4_frag_timeout(iface)
+#define net_stats_update_ipv4_frag_drop(iface)
+#endif /* CONFIG_NET_STATISTICS_IPV4_FRAGMENT */
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS) && defined(CONFIG_NET_STATISTICS)
 static inline void net_stats_update_tx_time(struct net_if *iface,
 					    uint32_t start_time,
@@ -378,6 +417,43 @@ static inline void net_stats_update_tx_time_detail(struct net_if *iface,
 #define net_stats_update_tx_time_detail(iface, detail_stat)
 #endif /* NET_PKT_TXTIME_STATS_DETAIL */
 
+#if defined(CONFIG_NET_STATISTICS_FLOW_QUEUES)
+static inline void net_stats_update_flow_queue_sent(struct net_if *iface,
+						    uint8_t queue,
+						    size_t bytes)
+{
+	UPDATE_STAT(iface, stats.flow_queues.sent[queue].pkts++);
+	UPDATE_STAT(iface, stats.flow_queues.sent[queue].bytes += bytes);
+}
+
+static inline void net_stats_update_flow_queue_recv(struct net_if *iface,
+						    uint8_t queue,
+						    size_t bytes)
+{
+	UPDATE_STAT(iface, stats.flow_queues.recv[queue].pkts++);
+	UPDATE_STAT(iface, stats.flow_queues.recv[queue].bytes += bytes);
+}
+#else
+#define net_stats_update_flow_queue_sent(iface, queue, bytes)
+#define net_stats_update_flow_queue_recv(iface, queue, bytes)
+#endif /* CONFIG_NET_STATISTICS_FLOW_QUEUES */
+
+#if defined(CONFIG_NET_STATISTICS_CONN_DEMUX)
+static inline void net_stats_update_conn_demux(struct net_if *iface,
+					       uint32_t start_time,
+					       uint32_t end_time,
+					       uint32_t visited)
+{
+	uint32_t diff = end_time - start_time;
+
+	UPDATE_STAT(iface, stats.conn_demux.sum += k_cyc_to_ns_floor64(diff));
+	UPDATE_STAT(iface, stats.conn_demux.count += 1);
+	UPDATE_STAT(iface, stats.conn_demux.visited += visited);
+}
+#else
+#define net_stats_update_conn_demux(iface, start_time, end_time, visited)
+#endif /* CONFIG_NET_STATISTICS_CONN_DEMUX */
+
 #if defined(CONFIG_NET_PKT_RXTIME_STATS) && defined(CONFIG_NET_STATISTICS)
 static inline void net_stats_update_rx_time(struct net_if *iface,
 					    uint32_t start_time,
@@ -13,10 +13,12 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "tcp_internal.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
@@ -104,6 +106,165 @@ int net_rx_priority2tc(enum net_priority prio)
 #endif
 }
 
+#if defined(CONFIG_NET_TC_RX_FLOW_HASH) || defined(CONFIG_NET_TC_TX_FLOW_HASH)
+/* FNV-1a, the input is a few bytes of headers */
+#define FLOW_HASH_INIT 2166136261U
+
+static uint32_t flow_hash_update(uint32_t hash, const void *data, size_t len)
+{
+	const uint8_t *ptr = data;
+
+	while (len--) {
+		hash = (hash ^ *ptr++) * 16777619U;
+	}
+
+	return hash;
+}
+
+/* Hash the addresses, protocol and ports of the IP packet at the cursor.
+ * IPv4 fragments and IPv6 packets with extension headers are only hashed
+ * by addresses and protocol, so that all the packets of a flow get the
+ * same hash. Returns 0 for other packets.
+ */
+static uint32_t flow_hash_ip(struct net_pkt *pkt)
+{
+	union {
+		struct net_ipv4_hdr ipv4;
+		struct net_ipv6_hdr ipv6;
+	} hdr;
+	struct net_pkt_cursor backup;
+	uint32_t hash = FLOW_HASH_INIT;
+	bool has_ports = false;
+	uint8_t ports[4];
+	uint8_t version;
+	uint8_t proto;
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	if (net_pkt_read_u8(pkt, &version)) {
+		return 0U;
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	switch (version >> 4) {
+	case 4:
+		if (net_pkt_read(pkt, &hdr.ipv4, sizeof(hdr.ipv4))) {
+			return 0U;
+		}
+
+		hash = flow_hash_update(hash, hdr.ipv4.src,
+					2 * NET_IPV4_ADDR_SIZE);
+		proto = hdr.ipv4.proto;
+
+		/* Only the first fragment would have the ports */
+		if ((hdr.ipv4.offset[0] & 0x3f) == 0U &&
+		    hdr.ipv4.offset[1] == 0U) {
+			has_ports = !net_pkt_skip(pkt,
+						  (hdr.ipv4.vhl & 0x0f) * 4U -
+						  sizeof(hdr.ipv4));
+		}
+
+		break;
+
+	case 6:
+		if (net_pkt_read(pkt, &hdr.ipv6, sizeof(hdr.ipv6))) {
+			return 0U;
+		}
+
+		hash = flow_hash_update(hash, hdr.ipv6.src,
+					2 * NET_IPV6_ADDR_SIZE);
+		proto = hdr.ipv6.nexthdr;
+		has_ports = true;
+		break;
+
+	default:
+		return 0U;
+	}
+
+	hash = flow_hash_update(hash, &proto, sizeof(proto));
+
+	if (has_ports && (proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    !net_pkt_read(pkt, ports, sizeof(ports))) {
+		hash = flow_hash_update(hash, ports, sizeof(ports));
+	}
+
+	return hash;
+}
+#endif /* CONFIG_NET_TC_RX_FLOW_HASH || CONFIG_NET_TC_TX_FLOW_HASH */
+
+#if defined(CONFIG_NET_TC_RX_FLOW_HASH)
+/* Move the cursor to the IP header of a received frame. Only the link
+ * layers with a simple header are handled.
+ */
+static int flow_skip_link_hdr(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(ETHERNET)) {
+		struct net_eth_hdr hdr;
+
+		if (net_pkt_read(pkt, &hdr, sizeof(hdr))) {
+			return -ENOBUFS;
+		}
+
+		if (ntohs(hdr.type) == NET_ETH_PTYPE_VLAN) {
+			return net_pkt_skip(pkt,
+					    sizeof(struct net_eth_vlan_hdr) -
+					    sizeof(hdr));
+		}
+
+		return 0;
+	}
+#endif
+
+#if defined(CONFIG_NET_L2_DUMMY)
+	if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+		return 0;
+	}
+#endif
+
+	ARG_UNUSED(iface);
+
+	return -ENOTSUP;
+}
+
+uint8_t net_rx_flow2queue(struct net_pkt *pkt)
+{
+	struct net_pkt_cursor backup;
+	uint32_t hash = 0U;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (flow_skip_link_hdr(pkt) == 0) {
+		hash = flow_hash_ip(pkt);
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return (hash ^ (hash >> 16)) % NET_TC_RX_COUNT;
+}
+#endif /* CONFIG_NET_TC_RX_FLOW_HASH */
+
+#if defined(CONFIG_NET_TC_TX_FLOW_HASH)
+uint8_t net_tx_flow2queue(struct net_pkt *pkt)
+{
+	struct net_pkt_cursor backup;
+	uint32_t hash;
+
+	/* The link layer header is only added by the TX thread */
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	hash = flow_hash_ip(pkt);
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return (hash ^ (hash >> 16)) % NET_TC_TX_COUNT;
+}
+#endif /* CONFIG_NET_TC_TX_FLOW_HASH */
 
 #if IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE)
 #define BASE_PRIO_TX (CONFIG_NET_TC_NUM_PRIORITIES - 1)
@@ -236,10 +397,31 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #endif
 #endif
 
+#if defined(CONFIG_NET_TCP_GRO)
+/* Return the RX queue served by the calling thread, or -1 */
+int net_tc_rx_queue_current(void)
+{
+	k_tid_t tid = k_current_get();
+	int i;
+
+	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+		if (tid == &rx_classes[i].handler) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+#endif
+
 #if NET_TC_RX_COUNT > 0
 static void tc_rx_handler(struct k_fifo *fifo)
 {
 	struct net_pkt *pkt;
+#if defined(CONFIG_NET_TCP_GRO)
+	int queue = net_tc_rx_queue_current();
+	int burst = 0;
+#endif
 
 	while (1) {
 		pkt = k_fifo_get(fifo, K_FOREVER);
@@ -248,6 +430,18 @@ static void tc_rx_handler(struct k_fifo *fifo)
 		}
 
 		net_process_rx_packet(pkt);
+
+#if defined(CONFIG_NET_TCP_GRO)
+		/* Segments merged by TCP receive offload are only held
+		 * until the burst of received packets is over, or for a
+		 * bounded number of packets if the queue never drains.
+		 */
+		if (k_fifo_is_empty(fifo) ||
+		    ++burst >= CONFIG_NET_TCP_GRO_BURST) {
+			net_tcp_gro_flush(queue);
+			burst = 0;
+		}
+#endif
 	}
 }
 #endif
@@ -290,7 +484,9 @@ void net_tc_tx_init(void)
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = tx_tc2thread(i);
+		/* The flow hashed queues are all equal */
+		thread_priority = IS_ENABLED(CONFIG_NET_TC_TX_FLOW_HASH) ?
+			tx_tc2thread(0) : tx_tc2thread(i);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -324,6 +520,11 @@ void net_tc_tx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_TC_FLOW_CPU_PIN) && defined(CONFIG_NET_TC_TX_FLOW_HASH)
+		(void)k_thread_cpu_mask_clear(tid);
+		(void)k_thread_cpu_mask_enable(tid, i % CONFIG_MP_NUM_CPUS);
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -348,7 +549,9 @@ void net_tc_rx_init(void)
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		/* The flow hashed queues are all equal */
+		thread_priority = IS_ENABLED(CONFIG_NET_TC_RX_FLOW_HASH) ?
+			rx_tc2thread(0) : rx_tc2thread(i);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -382,6 +585,11 @@ void net_tc_rx_init(void)
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_TC_FLOW_CPU_PIN) && defined(CONFIG_NET_TC_RX_FLOW_HASH)
+		(void)k_thread_cpu_mask_clear(tid);
+		(void)k_thread_cpu_mask_enable(tid, i % CONFIG_MP_NUM_CPUS);
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
@@ -133,6 +133,43 @@ static inline struct net_route_entry *net_route_data(struct net_nbr *nbr)
 	return (struct net_route_entry *)nbr->data;
 }
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+/* The routes are also kept in a trie by their prefix, so the lookup does
+ * not need to compare the destination against every route.
+ */
+NET_ROUTE_LPM_DEFINE(route_lpm, CONFIG_NET_MAX_ROUTES, 128);
+
+static bool route_lpm_match(sys_snode_t *node, void *user_data)
+{
+	struct net_route_entry *route = CONTAINER_OF(node,
+						     struct net_route_entry,
+						     lpm_node);
+	struct net_if *iface = user_data;
+
+	return !iface || route->iface == iface;
+}
+
+static int route_lpm_add(struct net_route_entry *route)
+{
+	route->lpm = net_route_lpm_add(&route_lpm, route->addr.s6_addr,
+				       route->prefix_len);
+	if (!route->lpm) {
+		return -ENOMEM;
+	}
+
+	sys_slist_append(&route->lpm->entries, &route->lpm_node);
+
+	return 0;
+}
+
+static void route_lpm_del(struct net_route_entry *route)
+{
+	sys_slist_find_and_remove(&route->lpm->entries, &route->lpm_node);
+	net_route_lpm_del(&route_lpm, route->lpm);
+	route->lpm = NULL;
+}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
 struct net_nbr *net_route_get_nbr(struct net_route_entry *route)
 {
 	int i;
@@ -214,6 +251,15 @@ static struct net_nbr *nbr_new(struct net_if *iface,
 	net_ipaddr_copy(&net_route_data(nbr)->addr, addr);
 	net_route_data(nbr)->prefix_len = prefix_len;
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	net_route_data(nbr)->iface = iface;
+
+	if (route_lpm_add(net_route_data(nbr)) < 0) {
+		net_nbr_unref(nbr);
+		return NULL;
+	}
+#endif
+
 	NET_DBG("[%d] nbr %p iface %p IPv6 %s/%d",
 		nbr->idx, nbr, iface,
 		log_strdup(net_sprint_ipv6_addr(&net_route_data(nbr)->addr)),
@@ -281,15 +327,49 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_LPM)
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	sys_snode_t *node;
+
+	node = net_route_lpm_lookup(&route_lpm, dst->s6_addr,
+				    route_lpm_match, iface);
+	if (!node) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(node, struct net_route_entry, lpm_node);
+}
+
+static struct net_route_entry *route_find_exact(struct net_if *iface,
+						struct in6_addr *addr,
+						uint8_t prefix_len)
+{
+	struct net_route_lpm_node *node;
+	struct net_route_entry *route;
+
+	node = net_route_lpm_find(&route_lpm, addr->s6_addr, prefix_len);
+	if (!node) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&node->entries, route, lpm_node) {
+		if (route->iface == iface) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+#else
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	k_mutex_lock(&lock, K_FOREVER);
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -312,6 +392,44 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+
+static struct net_route_entry *route_find_exact(struct net_if *iface,
+						struct in6_addr *addr,
+						uint8_t prefix_len)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_NET_MAX_ROUTES; i++) {
+		struct net_nbr *nbr = get_nbr(i);
+		struct net_route_entry *route;
+
+		if (!nbr->ref || nbr->iface != iface) {
+			continue;
+		}
+
+		route = net_route_data(nbr);
+
+		if (route->prefix_len == prefix_len &&
+		    net_ipv6_is_prefix(addr->s6_addr, route->addr.s6_addr,
+				       prefix_len)) {
+			return route;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_NET_ROUTE_LPM */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	found = route_find(iface, dst);
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -377,8 +495,13 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 		log_strdup(net_sprint_ll_addr(nexthop_lladdr->addr,
 					      nexthop_lladdr->len)));
 
-	route = net_route_lookup(iface, addr);
+	/* A route with a shorter or longer prefix is a different route, so
+	 * the longest match for the address is not necessarily this one.
+	 */
+	route = route_find_exact(iface, addr, prefix_len);
 	if (route) {
+		update_route_access(route);
+
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
 
@@ -623,6 +746,10 @@ int net_route_del(struct net_route_entry *route)
 		release_nexthop_route(nexthop_route);
 	}
 
+#if defined(CONFIG_NET_ROUTE_LPM)
+	route_lpm_del(route);
+#endif
+
 	nbr_free(nbr);
 
 	k_mutex_unlock(&lock);
@@ -20,6 +20,7 @@
 #include <net/net_timeout.h>
 
 #include "nbr.h"
+#include "route_lpm.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +69,14 @@ struct net_route_entry {
 
 	/** Is the route valid forever */
 	uint8_t is_infinite : 1;
+
+#if defined(CONFIG_NET_ROUTE_LPM)
+	/** Node in the list of routes with the same prefix. */
+	sys_snode_t lpm_node;
+
+	/** Trie node of the route prefix. */
+	struct net_route_lpm_node *lpm;
+#endif
 };
 
 /* Route preference values, as defined in RFC 4191 */
@@ -319,6 +328,111 @@ int net_route_packet(struct net_pkt *pkt, struct in6_addr *nexthop);
  */
 int net_route_packet_if(struct net_pkt *pkt, struct net_if *iface);
 
+/**
+ * @brief IPv4 route entry.
+ */
+struct net_route_entry_ipv4 {
+	/** Node in the list of routes with the same prefix. */
+	sys_snode_t lpm_node;
+
+	/** Trie node of the route prefix. */
+	struct net_route_lpm_node *lpm;
+
+	/** Network interface for the route. */
+	struct net_if *iface;
+
+	/** IPv4 address/prefix of the route. */
+	struct in_addr addr;
+
+	/** Gateway, unspecified if the destination is on-link. */
+	struct in_addr gw;
+
+	/** IPv4 address/prefix length. */
+	uint8_t prefix_len;
+
+	/** Is this entry in use or not */
+	bool is_used;
+};
+
+typedef void (*net_route_ipv4_cb_t)(struct net_route_entry_ipv4 *entry,
+				    void *user_data);
+
+#if defined(CONFIG_NET_ROUTE_IPV4)
+/**
+ * @brief Add an IPv4 route to routing table.
+ *
+ * If there already is a route for the prefix on the interface, its gateway
+ * is updated.
+ *
+ * @param iface Network interface that this route is tied to.
+ * @param addr IPv4 address.
+ * @param prefix_len Length of the IPv4 address/prefix.
+ * @param gw IPv4 address of the gateway, unspecified for an on-link route.
+ *
+ * @return Return created route entry, NULL if could not be created.
+ */
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						struct in_addr *addr,
+						uint8_t prefix_len,
+						struct in_addr *gw);
+
+/**
+ * @brief Delete an IPv4 route from routing table.
+ *
+ * @param route Existing route entry.
+ *
+ * @return 0 if ok, <0 if error
+ */
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route);
+
+/**
+ * @brief Lookup IPv4 route to a given destination.
+ *
+ * @param iface Network interface. If NULL, then check against all interfaces.
+ * @param dst Destination IPv4 address.
+ *
+ * @return Return route entry with the longest prefix that matches the
+ * destination address, NULL if not found.
+ */
+struct net_route_entry_ipv4 *net_route_ipv4_lookup(struct net_if *iface,
+						   struct in_addr *dst);
+
+/**
+ * @brief Get the next hop towards an IPv4 destination.
+ *
+ * @param iface Network interface.
+ * @param dst Destination IPv4 address.
+ * @param nexthop The gateway, or the destination itself for an on-link
+ * route, is returned here.
+ *
+ * @return True if there is a route to the destination, False otherwise
+ */
+bool net_route_ipv4_get_nexthop(struct net_if *iface, struct in_addr *dst,
+				struct in_addr *nexthop);
+
+/**
+ * @brief Go through all the IPv4 routing entries and call callback
+ * for each entry that is in use.
+ *
+ * @param cb User supplied callback function to call.
+ * @param user_data User specified data.
+ *
+ * @return Total number of IPv4 routing entries found.
+ */
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data);
+#else
+static inline bool net_route_ipv4_get_nexthop(struct net_if *iface,
+					      struct in_addr *dst,
+					      struct in_addr *nexthop)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(dst);
+	ARG_UNUSED(nexthop);
+
+	return false;
+}
+#endif /* CONFIG_NET_ROUTE_IPV4 */
+
 #if defined(CONFIG_NET_ROUTE) && defined(CONFIG_NET_NATIVE)
 void net_route_init(void);
 #else
@@ -0,0 +1,205 @@
+/** @file
+ * @brief IPv4 route handling.
+ */
+
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_route_ipv4, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <kernel.h>
+#include <zephyr/types.h>
+#include <sys/slist.h>
+
+#include <net/net_core.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#include "net_private.h"
+#include "route.h"
+
+static struct net_route_entry_ipv4 routes[CONFIG_NET_MAX_IPV4_ROUTES];
+
+NET_ROUTE_LPM_DEFINE(route_lpm, CONFIG_NET_MAX_IPV4_ROUTES, 32);
+
+static K_MUTEX_DEFINE(lock);
+
+static bool route_lpm_match(sys_snode_t *node, void *user_data)
+{
+	struct net_route_entry_ipv4 *route =
+		CONTAINER_OF(node, struct net_route_entry_ipv4, lpm_node);
+	struct net_if *iface = user_data;
+
+	return !iface || route->iface == iface;
+}
+
+static struct net_route_entry_ipv4 *route_find(struct net_if *iface,
+					       struct in_addr *dst)
+{
+	sys_snode_t *node;
+
+	node = net_route_lpm_lookup(&route_lpm, dst->s4_addr,
+				    route_lpm_match, iface);
+	if (!node) {
+		return NULL;
+	}
+
+	return CONTAINER_OF(node, struct net_route_entry_ipv4, lpm_node);
+}
+
+struct net_route_entry_ipv4 *net_route_ipv4_add(struct net_if *iface,
+						struct in_addr *addr,
+						uint8_t prefix_len,
+						struct in_addr *gw)
+{
+	struct net_route_entry_ipv4 *route = NULL;
+	struct net_route_lpm_node *node;
+	int i;
+
+	NET_ASSERT(iface);
+	NET_ASSERT(addr);
+	NET_ASSERT(gw);
+
+	if (prefix_len > 32) {
+		return NULL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	node = net_route_lpm_add(&route_lpm, addr->s4_addr, prefix_len);
+	if (!node) {
+		NET_DBG("No free route node");
+		goto exit;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&node->entries, route, lpm_node) {
+		if (route->iface == iface) {
+			NET_DBG("Update route %s/%d gateway to %s",
+				log_strdup(net_sprint_ipv4_addr(addr)),
+				prefix_len,
+				log_strdup(net_sprint_ipv4_addr(gw)));
+
+			net_ipaddr_copy(&route->gw, gw);
+			goto exit;
+		}
+	}
+
+	route = NULL;
+
+	for (i = 0; i < CONFIG_NET_MAX_IPV4_ROUTES; i++) {
+		if (!routes[i].is_used) {
+			route = &routes[i];
+			break;
+		}
+	}
+
+	if (!route) {
+		NET_DBG("No free route entry");
+		net_route_lpm_del(&route_lpm, node);
+		goto exit;
+	}
+
+	route->is_used = true;
+	route->iface = iface;
+	route->prefix_len = prefix_len;
+	route->lpm = node;
+	net_ipaddr_copy(&route->addr, addr);
+	net_ipaddr_copy(&route->gw, gw);
+
+	sys_slist_append(&node->entries, &route->lpm_node);
+
+	NET_DBG("Added route %s/%d via %s (iface %p)",
+		log_strdup(net_sprint_ipv4_addr(addr)), prefix_len,
+		log_strdup(net_sprint_ipv4_addr(gw)), iface);
+
+exit:
+	k_mutex_unlock(&lock);
+
+	return route;
+}
+
+int net_route_ipv4_del(struct net_route_entry_ipv4 *route)
+{
+	if (!route) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	if (!route->is_used) {
+		k_mutex_unlock(&lock);
+		return -ENOENT;
+	}
+
+	NET_DBG("Deleted route %s/%d",
+		log_strdup(net_sprint_ipv4_addr(&route->addr)),
+		route->prefix_len);
+
+	sys_slist_find_and_remove(&route->lpm->entries, &route->lpm_node);
+	net_route_lpm_del(&route_lpm, route->lpm);
+
+	route->lpm = NULL;
+	route->is_used = false;
+
+	k_mutex_unlock(&lock);
+
+	return 0;
+}
+
+struct net_route_entry_ipv4 *net_route_ipv4_lookup(struct net_if *iface,
+						   struct in_addr *dst)
+{
+	struct net_route_entry_ipv4 *route;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	route = route_find(iface, dst);
+	k_mutex_unlock(&lock);
+
+	return route;
+}
+
+bool net_route_ipv4_get_nexthop(struct net_if *iface, struct in_addr *dst,
+				struct in_addr *nexthop)
+{
+	struct net_route_entry_ipv4 *route;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	route = route_find(iface, dst);
+	if (route) {
+		if (net_ipv4_is_addr_unspecified(&route->gw)) {
+			net_ipaddr_copy(nexthop, dst);
+		} else {
+			net_ipaddr_copy(nexthop, &route->gw);
+		}
+	}
+
+	k_mutex_unlock(&lock);
+
+	return route != NULL;
+}
+
+int net_route_ipv4_foreach(net_route_ipv4_cb_t cb, void *user_data)
+{
+	int i, ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	for (i = 0; i < CONFIG_NET_MAX_IPV4_ROUTES; i++) {
+		if (!routes[i].is_used) {
+			continue;
+		}
+
+		cb(&routes[i], user_data);
+
+		ret++;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
@@ -0,0 +1,234 @@
+/** @file
+ * @brief Longest prefix match trie for the routing tables
+ */
+
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <string.h>
+
+#include <net/net_core.h>
+
+#include "route_lpm.h"
+
+static inline uint8_t addr_bit(const uint8_t *addr, uint8_t bit)
+{
+	return (addr[bit / 8U] >> (7 - (bit % 8U))) & 1U;
+}
+
+static uint8_t common_prefix_len(const uint8_t *a, const uint8_t *b,
+				 uint8_t max_len)
+{
+	uint8_t len = 0U;
+
+	for (int i = 0; len < max_len; i++) {
+		uint8_t diff = a[i] ^ b[i];
+
+		if (diff) {
+			len += __builtin_clz(diff) - 24;
+			break;
+		}
+
+		len += 8U;
+	}
+
+	return MIN(len, max_len);
+}
+
+static struct net_route_lpm_node *node_alloc(struct net_route_lpm *lpm,
+					     const uint8_t *prefix,
+					     uint8_t prefix_len)
+{
+	for (int i = 0; i < lpm->node_count; i++) {
+		struct net_route_lpm_node *node = &lpm->nodes[i];
+
+		if (node->is_used) {
+			continue;
+		}
+
+		node->is_used = true;
+		node->child[0] = NULL;
+		node->child[1] = NULL;
+		sys_slist_init(&node->entries);
+		memcpy(node->prefix, prefix, DIV_ROUND_UP(prefix_len, 8U));
+		node->prefix_len = prefix_len;
+
+		return node;
+	}
+
+	return NULL;
+}
+
+static inline void node_free(struct net_route_lpm_node *node)
+{
+	node->is_used = false;
+}
+
+struct net_route_lpm_node *net_route_lpm_add(struct net_route_lpm *lpm,
+					     const uint8_t *prefix,
+					     uint8_t prefix_len)
+{
+	struct net_route_lpm_node **link = &lpm->root;
+	struct net_route_lpm_node *node, *new, *branch;
+	uint8_t len;
+
+	if (prefix_len > lpm->addr_len) {
+		return NULL;
+	}
+
+	while (*link) {
+		node = *link;
+		len = common_prefix_len(prefix, node->prefix,
+					MIN(prefix_len, node->prefix_len));
+
+		if (len == node->prefix_len) {
+			if (len == prefix_len) {
+				return node;
+			}
+
+			/* The new prefix is somewhere below this node */
+			link = &node->child[addr_bit(prefix, len)];
+			continue;
+		}
+
+		if (len == prefix_len) {
+			/* The new prefix is the parent of this node */
+			new = node_alloc(lpm, prefix, prefix_len);
+			if (!new) {
+				return NULL;
+			}
+
+			new->child[addr_bit(node->prefix, len)] = node;
+			*link = new;
+
+			return new;
+		}
+
+		/* The prefixes diverge before the end of both, so they
+		 * become the two subtrees of a new branch node.
+		 */
+		branch = node_alloc(lpm, prefix, len);
+		if (!branch) {
+			return NULL;
+		}
+
+		new = node_alloc(lpm, prefix, prefix_len);
+		if (!new) {
+			node_free(branch);
+			return NULL;
+		}
+
+		branch->child[addr_bit(prefix, len)] = new;
+		branch->child[addr_bit(node->prefix, len)] = node;
+		*link = branch;
+
+		return new;
+	}
+
+	new = node_alloc(lpm, prefix, prefix_len);
+	if (!new) {
+		return NULL;
+	}
+
+	*link = new;
+
+	return new;
+}
+
+void net_route_lpm_del(struct net_route_lpm *lpm,
+		       struct net_route_lpm_node *node)
+{
+	struct net_route_lpm_node **link = &lpm->root;
+	struct net_route_lpm_node **parent_link = NULL;
+	struct net_route_lpm_node *parent;
+
+	if (!sys_slist_is_empty(&node->entries)) {
+		return;
+	}
+
+	while (*link != node) {
+		NET_ASSERT(*link, "Node %p not in trie %p", node, lpm);
+		if (!*link) {
+			return;
+		}
+
+		parent_link = link;
+		link = &(*link)->child[addr_bit(node->prefix,
+						(*link)->prefix_len)];
+	}
+
+	/* A node with two subtrees is still needed to branch */
+	if (node->child[0] && node->child[1]) {
+		return;
+	}
+
+	*link = node->child[0] ? node->child[0] : node->child[1];
+	node_free(node);
+
+	if (!parent_link) {
+		return;
+	}
+
+	/* The parent may now be a branch node with a single subtree */
+	parent = *parent_link;
+
+	if (sys_slist_is_empty(&parent->entries) &&
+	    !(parent->child[0] && parent->child[1])) {
+		*parent_link = parent->child[0] ? parent->child[0] :
+						  parent->child[1];
+		node_free(parent);
+	}
+}
+
+struct net_route_lpm_node *net_route_lpm_find(struct net_route_lpm *lpm,
+					      const uint8_t *prefix,
+					      uint8_t prefix_len)
+{
+	struct net_route_lpm_node *node = lpm->root;
+
+	while (node && node->prefix_len <= prefix_len &&
+	       net_ipv6_is_prefix(prefix, node->prefix, node->prefix_len)) {
+		if (node->prefix_len == prefix_len) {
+			return node;
+		}
+
+		node = node->child[addr_bit(prefix, node->prefix_len)];
+	}
+
+	return NULL;
+}
+
+sys_snode_t *net_route_lpm_lookup(struct net_route_lpm *lpm,
+				  const uint8_t *addr,
+				  net_route_lpm_match_cb_t cb,
+				  void *user_data)
+{
+	struct net_route_lpm_node *node = lpm->root;
+	sys_snode_t *found = NULL;
+	sys_snode_t *entry;
+
+	/* The nodes are visited from the shortest to the longest prefix,
+	 * so the last matching entry is the longest match.
+	 */
+	while (node && net_ipv6_is_prefix(addr, node->prefix,
+					  node->prefix_len)) {
+		SYS_SLIST_FOR_EACH_NODE(&node->entries, entry) {
+			if (!cb || cb(entry, user_data)) {
+				found = entry;
+				break;
+			}
+		}
+
+		if (node->prefix_len >= lpm->addr_len) {
+			break;
+		}
+
+		node = node->child[addr_bit(addr, node->prefix_len)];
+	}
+
+	return found;
+}
@@ -0,0 +1,156 @@
+/** @file
+ * @brief Longest prefix match trie for the routing tables
+ *
+ * This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __ROUTE_LPM_H
+#define __ROUTE_LPM_H
+
+#include <zephyr/types.h>
+#include <sys/slist.h>
+
+#include <net/net_ip.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Node of a path compressed binary trie.
+ *
+ * A node either holds routes with exactly its prefix, or it only branches
+ * to two subtrees whose prefixes differ in the bit after its own prefix.
+ */
+struct net_route_lpm_node {
+	/** Subtrees for the bit after the prefix being 0 or 1 */
+	struct net_route_lpm_node *child[2];
+
+	/** Route entries with exactly this prefix */
+	sys_slist_t entries;
+
+	/** Prefix, only the first prefix_len bits are significant */
+	uint8_t prefix[sizeof(struct in6_addr)];
+
+	/** Prefix length in bits */
+	uint8_t prefix_len;
+
+	/** Is this node in use or not */
+	bool is_used;
+};
+
+/**
+ * @brief Longest prefix match trie.
+ *
+ * The trie does no locking, the routing table that owns it must serialize
+ * the calls.
+ */
+struct net_route_lpm {
+	/** Node with the shortest prefix */
+	struct net_route_lpm_node *root;
+
+	/** Node pool */
+	struct net_route_lpm_node *nodes;
+
+	/** Number of nodes in the pool */
+	uint16_t node_count;
+
+	/** Length of the addresses in bits */
+	uint8_t addr_len;
+};
+
+/**
+ * @brief Statically define a trie.
+ *
+ * Every route needs at most one node of its own and one branch node,
+ * so the pool has twice as many nodes as there can be routes.
+ *
+ * @param name Name of the trie.
+ * @param max_routes Maximum number of distinct prefixes.
+ * @param addr_bits Length of the addresses in bits, 32 or 128.
+ */
+#define NET_ROUTE_LPM_DEFINE(name, max_routes, addr_bits)		\
+	static struct net_route_lpm_node name##_nodes[2 * (max_routes)]; \
+	static struct net_route_lpm name = {				\
+		.nodes = name##_nodes,					\
+		.node_count = ARRAY_SIZE(name##_nodes),			\
+		.addr_len = (addr_bits),				\
+	}
+
+/**
+ * @brief Callback to select one of the entries of a matching prefix.
+ *
+ * @param entry Route entry.
+ * @param user_data User specified data.
+ *
+ * @return True if the entry can be used.
+ */
+typedef bool (*net_route_lpm_match_cb_t)(sys_snode_t *entry,
+					 void *user_data);
+
+/**
+ * @brief Get the node of a prefix, creating it if needed.
+ *
+ * @param lpm Trie.
+ * @param prefix Prefix.
+ * @param prefix_len Prefix length in bits.
+ *
+ * @return Node where the entries of this prefix are stored, NULL if there
+ * are no free nodes.
+ */
+struct net_route_lpm_node *net_route_lpm_add(struct net_route_lpm *lpm,
+					     const uint8_t *prefix,
+					     uint8_t prefix_len);
+
+/**
+ * @brief Release a node after an entry was removed from it.
+ *
+ * The node is only removed from the trie once it has no entries left, and
+ * branch nodes that are no longer needed are merged.
+ *
+ * @param lpm Trie.
+ * @param node Node returned by net_route_lpm_add().
+ */
+void net_route_lpm_del(struct net_route_lpm *lpm,
+		       struct net_route_lpm_node *node);
+
+/**
+ * @brief Get the node of a prefix without creating it.
+ *
+ * @param lpm Trie.
+ * @param prefix Prefix.
+ * @param prefix_len Prefix length in bits.
+ *
+ * @return Node where the entries of this prefix are stored, NULL if the
+ * trie has no such node.
+ */
+struct net_route_lpm_node *net_route_lpm_find(struct net_route_lpm *lpm,
+					      const uint8_t *prefix,
+					      uint8_t prefix_len);
+
+/**
+ * @brief Find the entry with the longest prefix that matches an address.
+ *
+ * @param lpm Trie.
+ * @param addr Address to look up.
+ * @param cb Callback to filter the entries, NULL to accept any entry.
+ * @param user_data User specified data.
+ *
+ * @return Matching entry, NULL if no prefix matches.
+ */
+sys_snode_t *net_route_lpm_lookup(struct net_route_lpm *lpm,
+				  const uint8_t *addr,
+				  net_route_lpm_match_cb_t cb,
+				  void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROUTE_LPM_H */
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <zephyr.h>
 #include <random/rand32.h>
 
@@ -31,19 +32,51 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #define FIN_TIMEOUT_MS MSEC_PER_SEC
 #define FIN_TIMEOUT K_MSEC(FIN_TIMEOUT_MS)
 
+/* Bounds of the computed retransmission timeout, RFC 6298 suggests a
+ * minimum of one second which is too conservative for local networks.
+ */
+#define TCP_RTO_MIN_MS 100
+#define TCP_RTO_MAX_MS (60 * MSEC_PER_SEC)
+
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
+/* Amount of data the RX and TX buffers can hold */
+#if defined(CONFIG_NET_BUF_FIXED_DATA_SIZE)
+#define TCP_RX_BUF_SIZE (CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE)
+#define TCP_TX_BUF_SIZE (CONFIG_NET_BUF_TX_COUNT * CONFIG_NET_BUF_DATA_SIZE)
+#elif defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+#define TCP_RX_BUF_SIZE (CONFIG_NET_BUF_DATA_POOL_SIZE + \
+			 CONFIG_NET_BUF_SHARED_POOL_SIZE)
+#define TCP_TX_BUF_SIZE (CONFIG_NET_BUF_DATA_POOL_SIZE + \
+			 CONFIG_NET_BUF_SHARED_POOL_SIZE)
+#else
+#define TCP_RX_BUF_SIZE CONFIG_NET_BUF_DATA_POOL_SIZE
+#define TCP_TX_BUF_SIZE CONFIG_NET_BUF_DATA_POOL_SIZE
+#endif
+
 static int tcp_window =
 #if (CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE != 0)
 	CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE;
 #else
-	(CONFIG_NET_BUF_RX_COUNT * CONFIG_NET_BUF_DATA_SIZE) / 3;
+	TCP_RX_BUF_SIZE / 3;
 #endif
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
 
+/* Connections with known endpoints, hashed by their address and port
+ * pair. The list above and tcp_lock cover allocation and release, the
+ * per-bucket locks let segments of unrelated connections be looked up
+ * concurrently.
+ */
+static struct tcp_conn_bucket {
+	sys_slist_t conns;
+	struct k_spinlock lock;
+} tcp_conn_hash[CONFIG_NET_TCP_CONN_HASH_SIZE];
+
+static uint32_t tcp_conn_hash_seed;
+
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -355,37 +388,62 @@ static void tcp_send_queue_flush(struct tcp *conn)
 	}
 }
 
-#if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
-#define tcp_conn_unref(conn)				\
-	tcp_conn_unref_debug(conn, __func__, __LINE__)
+static uint32_t tcp_endpoint_hash(const union tcp_endpoint *ep, uint32_t h)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && ep->sa.sa_family == AF_INET6) {
+		for (int i = 0; i < 4; i++) {
+			h = (h ^ UNALIGNED_GET(&ep->sin6.sin6_addr.s6_addr32[i])) *
+				0x9e3779b1U;
+		}
+	} else {
+		h = (h ^ UNALIGNED_GET(&ep->sin.sin_addr.s_addr)) * 0x9e3779b1U;
+	}
 
-static int tcp_conn_unref_debug(struct tcp *conn, const char *caller, int line)
-#else
-static int tcp_conn_unref(struct tcp *conn)
-#endif
+	/* The port is at the same offset in both address families */
+	h = (h ^ ep->sin.sin_port) * 0x9e3779b1U;
+
+	return h ^ (h >> 16);
+}
+
+static struct tcp_conn_bucket *tcp_conn_bucket(const union tcp_endpoint *src,
+					       const union tcp_endpoint *dst)
 {
-	int ref_count = atomic_get(&conn->ref_count);
-	struct net_pkt *pkt;
+	uint32_t h = tcp_endpoint_hash(dst, tcp_endpoint_hash(src,
+							tcp_conn_hash_seed));
 
-#if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
-	NET_DBG("conn: %p, ref_count=%d (%s():%d)", conn, ref_count,
-		caller, line);
-#endif
+	return &tcp_conn_hash[h % CONFIG_NET_TCP_CONN_HASH_SIZE];
+}
 
-#if !defined(CONFIG_NET_TEST_PROTOCOL)
-	if (conn->in_connect) {
-		NET_DBG("conn: %p is waiting on connect semaphore", conn);
-		tcp_send_queue_flush(conn);
-		goto out;
-	}
-#endif /* CONFIG_NET_TEST_PROTOCOL */
+/* Make the connection visible to tcp_conn_search(), must be called once
+ * both endpoints are known.
+ */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	struct tcp_conn_bucket *bucket = tcp_conn_bucket(&conn->src,
+							 &conn->dst);
+	k_spinlock_key_t key = k_spin_lock(&bucket->lock);
 
-	ref_count = atomic_dec(&conn->ref_count) - 1;
-	if (ref_count != 0) {
-		tp_out(net_context_get_family(conn->context), conn->iface,
-		       "TP_TRACE", "event", "CONN_DELETE");
-		return ref_count;
-	}
+	sys_slist_append(&bucket->conns, &conn->hash_next);
+
+	k_spin_unlock(&bucket->lock, key);
+}
+
+static void tcp_conn_hash_del(struct tcp *conn)
+{
+	struct tcp_conn_bucket *bucket = tcp_conn_bucket(&conn->src,
+							 &conn->dst);
+	k_spinlock_key_t key = k_spin_lock(&bucket->lock);
+
+	sys_slist_find_and_remove(&bucket->conns, &conn->hash_next);
+
+	k_spin_unlock(&bucket->lock, key);
+}
+
+static void tcp_conn_free(struct tcp *conn)
+{
+	struct net_pkt *pkt;
+
+	tcp_conn_hash_del(conn);
 
 	k_mutex_lock(&tcp_lock, K_FOREVER);
 
@@ -425,6 +483,9 @@ static int tcp_conn_unref(struct tcp *conn)
 
 	k_work_cancel_delayable(&conn->timewait_timer);
 	k_work_cancel_delayable(&conn->fin_timer);
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	k_work_cancel_delayable(&conn->ack_timer);
+#endif
 
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
 
@@ -433,10 +494,52 @@ static int tcp_conn_unref(struct tcp *conn)
 	k_mem_slab_free(&tcp_conns_slab, (void **)&conn);
 
 	k_mutex_unlock(&tcp_lock);
+}
+
+#if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
+#define tcp_conn_unref(conn)				\
+	tcp_conn_unref_debug(conn, __func__, __LINE__)
+
+static int tcp_conn_unref_debug(struct tcp *conn, const char *caller, int line)
+#else
+static int tcp_conn_unref(struct tcp *conn)
+#endif
+{
+	int ref_count = atomic_get(&conn->ref_count);
+
+#if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
+	NET_DBG("conn: %p, ref_count=%d (%s():%d)", conn, ref_count,
+		caller, line);
+#endif
+
+#if !defined(CONFIG_NET_TEST_PROTOCOL)
+	if (conn->in_connect) {
+		NET_DBG("conn: %p is waiting on connect semaphore", conn);
+		tcp_send_queue_flush(conn);
+		goto out;
+	}
+#endif /* CONFIG_NET_TEST_PROTOCOL */
+
+	ref_count = atomic_dec(&conn->ref_count) - 1;
+	if (ref_count != 0) {
+		tp_out(net_context_get_family(conn->context), conn->iface,
+		       "TP_TRACE", "event", "CONN_DELETE");
+		return ref_count;
+	}
+
+	tcp_conn_free(conn);
 out:
 	return ref_count;
 }
 
+/* Drop a reference taken by tcp_conn_search() */
+static void tcp_conn_release(struct tcp *conn)
+{
+	if (atomic_dec(&conn->ref_count) == 1) {
+		tcp_conn_free(conn);
+	}
+}
+
 int net_tcp_unref(struct net_context *context)
 {
 	int ref_count = 0;
@@ -605,19 +708,30 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 	return buf;
 }
 
+/* The MSS, window scale and SACK permitted options are only valid in
+ * SYN segments, so they are only reset and parsed when flags has SYN.
+ */
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, uint8_t flags)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
 	uint8_t *options = tcp_options_get(pkt, len, options_buf,
 					   sizeof(options_buf));
+	bool syn = flags & SYN;
 	uint8_t opt, opt_len;
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm = false;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	recv_options->sack_count = 0;
+#endif
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -652,6 +766,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -663,9 +781,49 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = MIN(options[2],
+						   NET_TCP_MAX_WINDOW_SCALE);
 			recv_options->wnd_found = true;
+			NET_DBG("WSCALE=%hu", recv_options->window);
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm = true;
+			}
+			break;
+#if defined(CONFIG_NET_TCP_SACK)
+		case NET_TCP_SACK_OPT: {
+			int count = (opt_len - 2) / NET_TCP_SACK_BLOCK_SIZE;
+
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE ||
+			    count == 0 || count > NET_TCP_MAX_SACK_BLOCKS) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 0; i < count; i++) {
+				uint8_t *block = options + 2 +
+					i * NET_TCP_SACK_BLOCK_SIZE;
+
+				recv_options->sack[i].start =
+					sys_get_be32(block);
+				recv_options->sack[i].end =
+					sys_get_be32(block + 4);
+			}
+
+			recv_options->sack_count = count;
+			break;
+		}
+#endif
 		default:
 			continue;
 		}
@@ -762,11 +920,47 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+/* While the data pools borrow from the shared pool above its high watermark
+ * the window stops opening. Its right edge stays where it was, but at least
+ * one segment ahead of the acknowledged data so the connection does not
+ * stall. A window that was already offered is not taken back.
+ */
+static uint32_t tcp_adv_win(struct tcp *conn)
+{
+#if defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+	int32_t offered = conn->recv_win_edge - conn->ack;
+	uint32_t win = conn->recv_win;
+
+	if (net_buf_shared_heap_pressure(net_pkt_get_shared_data())) {
+		win = MIN(win, MAX(offered, (int32_t)conn_mss(conn)));
+	}
+
+	return win;
+#else
+	return conn->recv_win;
+#endif
+}
+
+/* Remember the right edge of the window that was put on the wire, or of
+ * none when the peer's sequence number has just become known.
+ */
+static inline void tcp_adv_win_sent(struct tcp *conn, uint32_t win)
+{
+#if defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+	conn->recv_win_edge = conn->ack + win;
+#else
+	ARG_UNUSED(conn);
+	ARG_UNUSED(win);
+#endif
+}
+
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t opts_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
+	uint8_t shift;
+	uint32_t win;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -783,12 +977,19 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 		th->th_off++;
 	}
 
+	th->th_off += opts_len / 4;
+
+	/* The window is never scaled in SYN segments */
+	shift = (flags & SYN) ? 0U : conn->recv_wscale;
+	win = MIN(tcp_adv_win(conn) >> shift, UINT16_MAX);
+
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(win), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
 		UNALIGNED_PUT(htonl(conn->ack), &th->th_ack);
+		tcp_adv_win_sent(conn, win << shift);
 	}
 
 	return net_pkt_set_data(pkt, &tcp_access);
@@ -830,6 +1031,136 @@ static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 	return net_pkt_set_data(pkt, &mss_opt_access);
 }
 
+#if defined(CONFIG_NET_TCP_SACK)
+/* Describe the out-of-order data in the receive queue as SACK blocks */
+static size_t tcp_sack_blocks_add(struct tcp *conn, uint8_t *opts)
+{
+	struct tcp_sack_block blocks[NET_TCP_MAX_SACK_BLOCKS];
+	struct net_buf *buf;
+	int count = 0;
+
+	if (!CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT ||
+	    net_pkt_is_empty(conn->queue_recv_data)) {
+		return 0;
+	}
+
+	for (buf = conn->queue_recv_data->buffer; buf; buf = buf->frags) {
+		uint32_t seq = tcp_get_seq(buf);
+
+		if (count > 0 && seq == blocks[count - 1].end) {
+			blocks[count - 1].end += buf->len;
+			continue;
+		}
+
+		if (count == NET_TCP_MAX_SACK_BLOCKS) {
+			break;
+		}
+
+		blocks[count].start = seq;
+		blocks[count].end = seq + buf->len;
+		count++;
+	}
+
+	opts[0] = NET_TCP_NOP_OPT;
+	opts[1] = NET_TCP_NOP_OPT;
+	opts[2] = NET_TCP_SACK_OPT;
+	opts[3] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (int i = 0; i < count; i++) {
+		sys_put_be32(blocks[i].start,
+			     opts + 4 + i * NET_TCP_SACK_BLOCK_SIZE);
+		sys_put_be32(blocks[i].end,
+			     opts + 8 + i * NET_TCP_SACK_BLOCK_SIZE);
+	}
+
+	return 4 + count * NET_TCP_SACK_BLOCK_SIZE;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* Build the options, other than MSS, to send in a segment with the given
+ * flags. Returns the length of the options which is a multiple of four.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, uint8_t *opts)
+{
+	size_t len = 0;
+
+	if (flags & SYN) {
+		if (conn->send_options.wnd_found) {
+			opts[len++] = NET_TCP_NOP_OPT;
+			opts[len++] = NET_TCP_WINDOW_SCALE_OPT;
+			opts[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+			opts[len++] = conn->send_options.window;
+		}
+
+		if (conn->send_options.sack_perm) {
+			opts[len++] = NET_TCP_NOP_OPT;
+			opts[len++] = NET_TCP_NOP_OPT;
+			opts[len++] = NET_TCP_SACK_PERM_OPT;
+			opts[len++] = NET_TCP_SACK_PERM_SIZE;
+		}
+
+		return len;
+	}
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sack_ok && (flags & ACK) && !(flags & RST)) {
+		len += tcp_sack_blocks_add(conn, opts + len);
+	}
+#endif
+
+	return len;
+}
+
+/* Select the options to offer in our SYN, or to echo in our SYN-ACK where
+ * only the options the peer offered may be used.
+ */
+static void tcp_syn_options_set(struct tcp *conn, bool syn_ack)
+{
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    (!syn_ack || conn->recv_options.wnd_found)) {
+		uint8_t shift = 0U;
+
+		while (shift < NET_TCP_MAX_WINDOW_SCALE &&
+		       (tcp_window >> shift) > UINT16_MAX) {
+			shift++;
+		}
+
+		conn->send_options.window = shift;
+		conn->send_options.wnd_found = true;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    (!syn_ack || conn->recv_options.sack_perm)) {
+		conn->send_options.sack_perm = true;
+	}
+}
+
+/* Called when both SYNs have been seen, the options are in use only if
+ * both ends sent them.
+ */
+static void tcp_syn_options_negotiate(struct tcp *conn)
+{
+	if (conn->send_options.wnd_found && conn->recv_options.wnd_found) {
+		conn->send_wscale = conn->recv_options.window;
+		conn->recv_wscale = conn->send_options.window;
+	} else {
+		conn->send_wscale = 0U;
+		conn->recv_wscale = 0U;
+	}
+
+	conn->recv_win = MIN(conn->recv_win,
+			     (uint32_t)UINT16_MAX << conn->recv_wscale);
+
+	conn->sack_ok = conn->send_options.sack_perm &&
+		conn->recv_options.sack_perm;
+
+	conn->send_options.wnd_found = false;
+	conn->send_options.sack_perm = false;
+
+	NET_DBG("conn: %p wscale %u/%u sack %d", conn, conn->send_wscale,
+		conn->recv_wscale, conn->sack_ok);
+}
+
 static bool is_destination_local(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
@@ -857,6 +1188,9 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
 	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t opts[40]; /* TCP header max options size is 40 */
+	size_t data_len = data ? net_pkt_get_len(data) : 0;
+	size_t opts_len;
 	struct net_pkt *pkt;
 	int ret = 0;
 
@@ -864,6 +1198,9 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		alloc_len += sizeof(uint32_t);
 	}
 
+	opts_len = tcp_options_build(conn, flags, opts);
+	alloc_len += opts_len;
+
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -882,12 +1219,20 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, opts_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	/* The ACK of this segment covers all the data received so far */
+	if (flags & ACK) {
+		conn->ack_pending = 0U;
+		k_work_cancel_delayable(&conn->ack_timer);
+	}
+#endif
+
 	if (conn->send_options.mss_found) {
 		ret = net_tcp_set_mss_opt(conn, pkt);
 		if (ret < 0) {
@@ -896,6 +1241,21 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	if (opts_len) {
+		ret = net_pkt_write(pkt, opts, opts_len);
+		if (ret < 0) {
+			tcp_pkt_unref(pkt);
+			goto out;
+		}
+	}
+
+	/* Only set when tcp_send_data() built a packet for segmentation
+	 * offload, it is split into MSS sized segments before L2.
+	 */
+	if (data_len > conn_mss(conn)) {
+		net_pkt_set_gso_size(pkt, conn_mss(conn));
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -962,9 +1322,184 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+/* Time one segment per round trip. Retransmitted segments are never
+ * timed (Karn's algorithm), so the caller only starts a measurement for
+ * new data.
+ */
+static void tcp_rtt_start(struct tcp *conn, uint32_t end_seq)
+{
+	if (conn->rtt_pending) {
+		return;
+	}
+
+	conn->rtt_seq = end_seq;
+	conn->rtt_time = k_uptime_get_32();
+	conn->rtt_pending = true;
+}
+
+/* Update the smoothed round trip time and the retransmission timeout as
+ * in RFC 6298, once the segment being timed has been acknowledged.
+ */
+static void tcp_rtt_update(struct tcp *conn)
+{
+	uint32_t rtt;
+
+	if (!conn->rtt_pending ||
+	    net_tcp_seq_cmp(conn->seq, conn->rtt_seq) < 0) {
+		return;
+	}
+
+	conn->rtt_pending = false;
+	rtt = k_uptime_get_32() - conn->rtt_time;
+
+	if (conn->srtt == 0U) {
+		conn->srtt = rtt << 3;
+		conn->rttvar = rtt << 1;
+	} else {
+		int32_t err = (int32_t)rtt - (int32_t)(conn->srtt >> 3);
+
+		conn->srtt += err;
+		if (err < 0) {
+			err = -err;
+		}
+		conn->rttvar += err - (int32_t)(conn->rttvar >> 2);
+	}
+
+	conn->rto = CLAMP((conn->srtt >> 3) + MAX(conn->rttvar, 1U),
+			  TCP_RTO_MIN_MS, TCP_RTO_MAX_MS);
+
+	NET_DBG("conn: %p rtt %u srtt %u rttvar %u rto %u", conn, rtt,
+		conn->srtt >> 3, conn->rttvar >> 2, conn->rto);
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* Add a block to the scoreboard, merging it with the blocks it overlaps
+ * or touches. If the scoreboard is full the highest block is dropped, as
+ * the lowest ones describe the holes that are retransmitted first.
+ */
+static void tcp_sack_insert(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	int n = conn->sacked_count;
+	int i, j;
+
+	for (i = 0; i < n && net_tcp_seq_cmp(sb[i].end, start) < 0; i++) {
+	}
+
+	for (j = i; j < n && net_tcp_seq_cmp(sb[j].start, end) <= 0; j++) {
+		if (net_tcp_seq_cmp(sb[j].start, start) < 0) {
+			start = sb[j].start;
+		}
+
+		if (net_tcp_seq_cmp(sb[j].end, end) > 0) {
+			end = sb[j].end;
+		}
+	}
+
+	if (i == j) {
+		if (n == NET_TCP_MAX_SACK_BLOCKS) {
+			if (i == n) {
+				return;
+			}
+
+			n--;
+		}
+
+		memmove(&sb[i + 1], &sb[i], (n - i) * sizeof(*sb));
+		n++;
+	} else {
+		memmove(&sb[i + 1], &sb[j], (n - j) * sizeof(*sb));
+		n -= j - i - 1;
+	}
+
+	sb[i].start = start;
+	sb[i].end = end;
+	conn->sacked_count = n;
+}
+
+/* Merge the SACK blocks of the received segment into the scoreboard */
+static void tcp_sack_update(struct tcp *conn)
+{
+	struct tcp_options *opts = &conn->recv_options;
+	uint32_t snd_max = conn->seq + conn->send_data_total;
+
+	for (int i = 0; i < opts->sack_count; i++) {
+		uint32_t start = opts->sack[i].start;
+		uint32_t end = opts->sack[i].end;
+
+		if (net_tcp_seq_cmp(start, conn->seq) < 0) {
+			start = conn->seq;
+		}
+
+		/* Ignore blocks for data that was never sent */
+		if (net_tcp_seq_cmp(end, snd_max) > 0 ||
+		    net_tcp_seq_cmp(start, end) >= 0) {
+			continue;
+		}
+
+		tcp_sack_insert(conn, start, end);
+	}
+
+	opts->sack_count = 0;
+}
+
+/* Drop the blocks that the cumulative ACK has covered */
+static void tcp_sack_ack(struct tcp *conn)
+{
+	struct tcp_sack_block *sb = conn->sacked;
+	int n = conn->sacked_count;
+	int i;
+
+	for (i = 0; i < n && net_tcp_seq_cmp(sb[i].end, conn->seq) <= 0; i++) {
+	}
+
+	memmove(sb, &sb[i], (n - i) * sizeof(*sb));
+	n -= i;
+
+	if (n > 0 && net_tcp_seq_cmp(sb[0].start, conn->seq) < 0) {
+		sb[0].start = conn->seq;
+	}
+
+	conn->sacked_count = n;
+}
+
+/* Move the send position past data that the peer already has, and
+ * return how much can be sent before reaching the next SACKed block.
+ */
+static int tcp_sack_next(struct tcp *conn)
+{
+	for (int i = 0; i < conn->sacked_count; i++) {
+		int start = conn->sacked[i].start - conn->seq;
+		int end = conn->sacked[i].end - conn->seq;
+
+		if (conn->unacked_len < start) {
+			return start - conn->unacked_len;
+		}
+
+		if (conn->unacked_len < end) {
+			conn->unacked_len = end;
+		}
+	}
+
+	return INT_MAX;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+/* The amount of data that can be in flight, limited by both the peer's
+ * receive window and the congestion window.
+ */
+static uint32_t tcp_send_window(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	return MIN((uint32_t)conn->send_win, conn->cc.cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
-	bool window_full = !(conn->unacked_len < conn->send_win);
+	bool window_full = !(conn->unacked_len < tcp_send_window(conn));
 
 	NET_DBG("conn: %p window_full=%hu", conn, window_full);
 
@@ -989,16 +1524,72 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+/* Packets larger than the MSS are only built for Ethernet, where
+ * net_if_tx() segments them. Packets to a local address never get there.
+ */
+static bool tcp_gso_check(struct tcp *conn)
+{
+	if (!conn->iface ||
+	    net_if_l2(conn->iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_context_get_family(conn->context) == AF_INET) {
+		return !net_ipv4_is_addr_loopback(&conn->dst.sin.sin_addr) &&
+			!net_ipv4_is_my_addr(&conn->dst.sin.sin_addr);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    net_context_get_family(conn->context) == AF_INET6) {
+		return !net_ipv6_is_addr_loopback(&conn->dst.sin6.sin6_addr) &&
+			!net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr);
+	}
+
+	return false;
+}
+#endif
+
+/* Largest amount of data sent in one packet */
+static int tcp_send_max_len(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_GSO)
+	if (conn->gso) {
+		return MAX(CONFIG_NET_TCP_GSO_MAX_SIZE / mss, 1) * mss;
+	}
+#endif
+
+	return mss;
+}
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int pos, len;
 	struct net_pkt *pkt;
+#if defined(CONFIG_NET_TCP_SACK)
+	int gap = INT_MAX;
+
+	if (tcp_unsent_len(conn) > 0) {
+		gap = tcp_sack_next(conn);
+
+		/* Everything up to the window was already SACKed */
+		if (tcp_unsent_len(conn) <= 0 || tcp_window_full(conn)) {
+			goto out;
+		}
+	}
+#endif
 
 	pos = conn->unacked_len;
 	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
+		   (int)tcp_send_window(conn) - conn->unacked_len,
+		   tcp_send_max_len(conn));
+#if defined(CONFIG_NET_TCP_SACK)
+	len = MIN(len, gap);
+#endif
 	if (len == 0) {
 		NET_DBG("conn: %p no data to send", conn);
 		ret = -ENODATA;
@@ -1029,6 +1620,8 @@ static int tcp_send_data(struct tcp *conn)
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
 			net_stats_update_tcp_seg_sent(conn->iface);
+
+			tcp_rtt_start(conn, conn->seq + conn->unacked_len);
 		}
 	}
 
@@ -1086,12 +1679,118 @@ static int tcp_send_queued_data(struct tcp *conn)
 	if (subscribe) {
 		conn->send_data_retries = 0;
 		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-					    K_MSEC(tcp_rto));
+					    K_MSEC(conn->rto));
 	}
  out:
 	return ret;
 }
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+/* Resend len bytes of unacknowledged data starting at offset pos */
+static int tcp_retransmit(struct tcp *conn, int pos, int len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	if (len <= 0) {
+		return -ENODATA;
+	}
+
+	/* The segment being timed might be the one resent */
+	conn->rtt_pending = false;
+
+	pkt = tcp_pkt_alloc(conn, len);
+	if (!pkt) {
+		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_pkt_peek(pkt, conn->send_data, pos, len);
+	if (ret < 0) {
+		tcp_pkt_unref(pkt);
+		return -ENOBUFS;
+	}
+
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + pos);
+	if (ret == 0) {
+		net_stats_update_tcp_resent(conn->iface, len);
+		net_stats_update_tcp_seg_rexmit(conn->iface);
+	}
+
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+/* Resend the first unacknowledged segment without waiting for the
+ * retransmission timer.
+ */
+static int tcp_fast_retransmit(struct tcp *conn)
+{
+	int len = MIN(conn->unacked_len, conn_mss(conn));
+
+#if defined(CONFIG_NET_TCP_SACK)
+	if (conn->sacked_count > 0) {
+		len = MIN(len, (int)(conn->sacked[0].start - conn->seq));
+	}
+
+	conn->sack_rexmit = conn->seq + len;
+#endif
+
+	return tcp_retransmit(conn, 0, len);
+}
+
+#if defined(CONFIG_NET_TCP_SACK)
+/* During recovery, resend the next hole below the highest SACKed data */
+static bool tcp_sack_retransmit(struct tcp *conn)
+{
+	uint32_t from = conn->sack_rexmit;
+
+	if (net_tcp_seq_cmp(from, conn->seq) < 0) {
+		from = conn->seq;
+	}
+
+	for (int i = 0; i < conn->sacked_count; i++) {
+		struct tcp_sack_block *sb = &conn->sacked[i];
+
+		if (net_tcp_seq_cmp(from, sb->start) < 0) {
+			int len = MIN(sb->start - from, conn_mss(conn));
+
+			if (tcp_retransmit(conn, from - conn->seq, len) < 0) {
+				return false;
+			}
+
+			conn->sack_rexmit = from + len;
+			return true;
+		}
+
+		if (net_tcp_seq_cmp(from, sb->end) < 0) {
+			from = sb->end;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+static void tcp_dup_ack(struct tcp *conn)
+{
+	NET_DBG("conn: %p dup ack %u", conn, conn->seq);
+
+	if (tcp_cc_dup_ack(conn)) {
+		(void)tcp_fast_retransmit(conn);
+	} else if (conn->cc.in_recovery) {
+#if defined(CONFIG_NET_TCP_SACK)
+		if (tcp_sack_retransmit(conn)) {
+			return;
+		}
+#endif
+		/* The inflated window might allow new data to go out */
+		(void)tcp_send_queued_data(conn);
+	}
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1109,6 +1808,24 @@ static void tcp_cleanup_recv_queue(struct k_work *work)
 	k_mutex_unlock(&conn->lock);
 }
 
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+static void tcp_delayed_ack(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, ack_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->ack_pending) {
+		NET_DBG("conn: %p, delayed ACK for %u bytes", conn,
+			conn->ack_pending);
+		tcp_out(conn, ACK);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+#endif /* CONFIG_NET_TCP_DELAYED_ACK */
+
 static void tcp_resend_data(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1126,6 +1843,24 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	/* Karn's algorithm, never time a retransmitted segment */
+	conn->rtt_pending = false;
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	if (conn->unacked_len > 0) {
+		tcp_cc_timeout(conn);
+	}
+#endif
+
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Repeated timeouts might mean that the peer has dropped data it
+	 * had SACKed, so stop trusting the scoreboard.
+	 */
+	if (conn->send_data_retries > 0) {
+		conn->sacked_count = 0;
+	}
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1155,8 +1890,11 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+	/* Exponential backoff until the next round trip sample */
+	conn->rto = MIN(conn->rto * 2U, TCP_RTO_MAX_MS);
+
 	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-				    K_MSEC(tcp_rto));
+				    K_MSEC(conn->rto));
 
  out:
 	k_mutex_unlock(&conn->lock);
@@ -1206,7 +1944,22 @@ static void tcp_conn_ref(struct tcp *conn)
 {
 	int ref_count = atomic_inc(&conn->ref_count) + 1;
 
-	NET_DBG("conn: %p, ref_count: %d", conn, ref_count);
+	NET_DBG("conn: %p, ref_count: %d", conn, ref_count);
+}
+
+/* Take a reference unless the connection is already being released */
+static bool tcp_conn_try_ref(struct tcp *conn)
+{
+	atomic_val_t ref_count;
+
+	do {
+		ref_count = atomic_get(&conn->ref_count);
+		if (ref_count == 0) {
+			return false;
+		}
+	} while (!atomic_cas(&conn->ref_count, ref_count, ref_count + 1));
+
+	return true;
 }
 
 static struct tcp *tcp_conn_alloc(void)
@@ -1244,6 +1997,7 @@ static struct tcp *tcp_conn_alloc(void)
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
 	conn->recv_win = tcp_window;
+	conn->rto = tcp_rto;
 
 	/* The ISN value will be set when we get the connection attempt or
 	 * when trying to create a connection.
@@ -1252,11 +2006,18 @@ static struct tcp *tcp_conn_alloc(void)
 
 	sys_slist_init(&conn->send_queue);
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	tcp_cc_init(conn);
+#endif
+
 	k_work_init_delayable(&conn->send_timer, tcp_send_process);
 	k_work_init_delayable(&conn->timewait_timer, tcp_timewait_timeout);
 	k_work_init_delayable(&conn->fin_timer, tcp_fin_timeout);
 	k_work_init_delayable(&conn->send_data_timer, tcp_resend_data);
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	k_work_init_delayable(&conn->ack_timer, tcp_delayed_ack);
+#endif
 
 	tcp_conn_ref(conn);
 
@@ -1298,41 +2059,201 @@ out:
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
+static bool tcp_endpoint_eq(const union tcp_endpoint *a,
+			    const union tcp_endpoint *b)
 {
-	union tcp_endpoint ep_tmp;
+	return a->sa.sa_family == b->sa.sa_family &&
+		!memcmp(a, b, tcp_endpoint_len(a->sa.sa_family));
+}
 
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
+/* Find the connection the segment belongs to. The connection is
+ * returned with a reference held so that it cannot be released while
+ * the segment is processed, drop it with tcp_conn_release().
+ */
+static struct tcp *tcp_conn_search(struct net_pkt *pkt)
+{
+	union tcp_endpoint src, dst;
+	struct tcp_conn_bucket *bucket;
+	struct tcp *found = NULL;
+	struct tcp *conn;
+	k_spinlock_key_t key;
+
+	/* Our source endpoint is the destination of the segment */
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
+
+	bucket = tcp_conn_bucket(&src, &dst);
+
+	key = k_spin_lock(&bucket->lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&bucket->conns, conn, hash_next) {
+		if (tcp_endpoint_eq(&conn->src, &src) &&
+		    tcp_endpoint_eq(&conn->dst, &dst)) {
+			if (tcp_conn_try_ref(conn)) {
+				found = conn;
+			}
+
+			break;
+		}
 	}
 
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
+	k_spin_unlock(&bucket->lock, key);
+
+	return found;
 }
 
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
+static struct tcp *tcp_conn_new(struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_TCP_GRO)
+/* Connections holding segments for receive offload, one list per RX
+ * queue.  A list is only used by the thread of its queue, which holds
+ * the segments and processes them when it flushes, so that held data
+ * keeps its order and priority.  An all zero list is empty.
+ */
+static sys_slist_t tcp_gro_list[NET_TC_RX_COUNT];
+
+/* Only segments that carry in-order data and nothing else the state
+ * machine would need to see are merged.
+ */
+static bool tcp_gro_eligible(struct tcp *conn, struct tcphdr *th, size_t len)
 {
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
+	return conn->state == TCP_ESTABLISHED && len > 0 &&
+		th_off(th) == 5 && (th_flags(th) & ~PSH) == ACK;
 }
 
-static struct tcp *tcp_conn_search(struct net_pkt *pkt)
+/* Remove the headers in front of the payload without moving the data */
+static void tcp_gro_strip(struct net_pkt *pkt, size_t hdr_len)
 {
-	bool found = false;
-	struct tcp *conn;
-	struct tcp *tmp;
+	while (hdr_len && pkt->buffer) {
+		struct net_buf *buf = pkt->buffer;
+		size_t len = MIN(hdr_len, buf->len);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
-		found = tcp_conn_cmp(conn, pkt);
-		if (found) {
-			break;
+		net_buf_pull(buf, len);
+		hdr_len -= len;
+
+		if (buf->len == 0U) {
+			pkt->buffer = buf->frags;
+			buf->frags = NULL;
+			net_buf_unref(buf);
 		}
 	}
 
-	return found ? conn : NULL;
+	net_pkt_cursor_init(pkt);
 }
 
-static struct tcp *tcp_conn_new(struct net_pkt *pkt);
+static bool tcp_gro_merge(struct tcp *conn, struct net_pkt *pkt,
+			  struct tcphdr *th, size_t len)
+{
+	struct net_pkt *held = conn->gro_pkt;
+	struct tcphdr *held_th = th_get(held);
+
+	if (!held_th || th_seq(th) != conn->gro_seq ||
+	    th_ack(th) != th_ack(held_th) || th_win(th) != th_win(held_th)) {
+		return false;
+	}
+
+	if (conn->gro_seq - th_seq(held_th) + len >
+	    MIN(CONFIG_NET_TCP_GRO_MAX_SIZE, conn->recv_win)) {
+		return false;
+	}
+
+	if (th_flags(th) & PSH) {
+		UNALIGNED_PUT(th_flags(held_th) | PSH, &held_th->th_flags);
+	}
+
+	tcp_gro_strip(pkt, net_pkt_get_len(pkt) - len);
+	net_pkt_append_buffer(held, pkt->buffer);
+	pkt->buffer = NULL;
+	tcp_pkt_unref(pkt);
+
+	conn->gro_seq += len;
+
+	return true;
+}
+
+/* Returns true if the segment was taken to be merged with the following
+ * ones, otherwise the caller must process it. Segments held so far are
+ * processed first if the new one cannot be merged with them.
+ */
+static bool tcp_gro_receive(struct tcp *conn, struct net_pkt *pkt)
+{
+	struct tcphdr *th = th_get(pkt);
+	size_t len = th ? tcp_data_len(pkt) : 0;
+	bool push = th && (th_flags(th) & PSH);
+	int queue = net_tc_rx_queue_current();
+	struct net_pkt *flush = NULL;
+	bool held = false;
+	bool owner;
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	/* Segments are only held by the RX queue whose list has the conn */
+	owner = queue >= 0 &&
+		(!conn->gro_queued || conn->gro_queue == queue);
+
+	if (!th || !owner || !tcp_gro_eligible(conn, th, len)) {
+		flush = conn->gro_pkt;
+	} else if (conn->gro_pkt) {
+		held = tcp_gro_merge(conn, pkt, th, len);
+		if (!held || push) {
+			flush = conn->gro_pkt;
+		}
+	} else if (th_seq(th) == conn->ack && !push) {
+		conn->gro_pkt = pkt;
+		conn->gro_seq = conn->ack + len;
+		held = true;
+
+		if (!conn->gro_queued) {
+			/* The list keeps its own reference */
+			tcp_conn_ref(conn);
+			conn->gro_queued = true;
+			conn->gro_queue = queue;
+
+			sys_slist_append(&tcp_gro_list[queue], &conn->gro_next);
+		}
+	}
+
+	if (flush) {
+		conn->gro_pkt = NULL;
+	}
+
+	k_mutex_unlock(&conn->lock);
+
+	if (flush) {
+		tcp_in(conn, flush);
+		tcp_pkt_unref(flush);
+	}
+
+	return held;
+}
+
+void net_tcp_gro_flush(int queue)
+{
+	sys_slist_t list = tcp_gro_list[queue];
+	struct tcp *conn, *tmp;
+
+	sys_slist_init(&tcp_gro_list[queue]);
+
+	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&list, conn, tmp, gro_next) {
+		struct net_pkt *pkt;
+
+		k_mutex_lock(&conn->lock, K_FOREVER);
+		pkt = conn->gro_pkt;
+		conn->gro_pkt = NULL;
+		conn->gro_queued = false;
+		k_mutex_unlock(&conn->lock);
+
+		if (pkt) {
+			tcp_in(conn, pkt);
+			tcp_pkt_unref(pkt);
+		}
+
+		tcp_conn_release(conn);
+	}
+}
+#endif /* CONFIG_NET_TCP_GRO */
 
 static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				 struct net_pkt *pkt,
@@ -1348,7 +2269,17 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 
 	conn = tcp_conn_search(pkt);
 	if (conn) {
-		goto in;
+#if defined(CONFIG_NET_TCP_GRO)
+		if (tcp_gro_receive(conn, pkt)) {
+			tcp_conn_release(conn);
+
+			return NET_OK;
+		}
+#endif
+		tcp_in(conn, pkt);
+		tcp_conn_release(conn);
+
+		return NET_DROP;
 	}
 
 	th = th_get(pkt);
@@ -1566,6 +2497,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		conn = NULL;
 		goto err;
 	}
+
+	tcp_conn_hash_add(conn);
 err:
 	if (!conn) {
 		net_stats_update_tcp_seg_conndrop(net_pkt_iface(pkt));
@@ -1671,20 +2604,55 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 	}
 }
 
+/* Acknowledge in-order data, with delayed ACKs only every second full
+ * sized segment is acknowledged right away (RFC 5681 chapter 4.2).
+ * Full sized is the MSS we announced, which bounds the segments we
+ * receive, not conn_mss() which bounds the ones we send.
+ */
+static void tcp_ack_data(struct tcp *conn, size_t len)
+{
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	conn->ack_pending += len;
+
+	if (conn->ack_pending < 2U * net_tcp_get_recv_mss(conn)) {
+		if (!k_work_delayable_is_pending(&conn->ack_timer)) {
+			k_work_reschedule_for_queue(
+				&tcp_work_q, &conn->ack_timer,
+				K_MSEC(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT));
+		}
+
+		return;
+	}
+#endif
+
+	tcp_out(conn, ACK);
+}
+
 static bool tcp_data_received(struct tcp *conn, struct net_pkt *pkt,
 			      size_t *len)
 {
+	bool fills_hole;
+
 	if (*len == 0) {
 		return false;
 	}
 
+	fills_hole = CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
+		     !net_pkt_is_empty(conn->queue_recv_data);
+
 	if (tcp_data_get(conn, pkt, len) < 0) {
 		return false;
 	}
 
 	net_stats_update_tcp_seg_recv(conn->iface);
 	conn_ack(conn, *len);
-	tcp_out(conn, ACK);
+
+	/* The peer is recovering from a loss, let it know right away */
+	if (fills_hole) {
+		tcp_out(conn, ACK);
+	} else {
+		tcp_ack_data(conn, *len);
+	}
 
 	return true;
 }
@@ -1708,6 +2676,188 @@ static void tcp_out_of_order_data(struct tcp *conn, struct net_pkt *pkt,
 	/* We received out-of-order data. Try to queue it.
 	 */
 	tcp_queue_recv_data(conn, pkt, data_len, seq);
+
+	/* Tell the peer right away what we have, so it can resend only
+	 * the missing data. With delayed ACKs the duplicate ACK must not
+	 * wait either, the peer relies on it to detect the loss (RFC 5681
+	 * chapter 4.2).
+	 */
+	if ((IS_ENABLED(CONFIG_NET_TCP_SACK) && conn->sack_ok) ||
+	    IS_ENABLED(CONFIG_NET_TCP_DELAYED_ACK)) {
+		tcp_out(conn, ACK);
+	}
+}
+
+/* Send window offered by the peer, limited by our TX buffers */
+static uint32_t tcp_peer_win(struct tcp *conn, struct tcphdr *th)
+{
+	uint32_t win = ntohs(th_win(th));
+	size_t max_win;
+
+	if (!(th_flags(th) & SYN)) {
+		win <<= conn->send_wscale;
+	}
+
+#if defined(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
+	if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
+		max_win = CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE;
+	} else
+#endif
+	{
+		/* Adjust the window so that we do not run out of bufs
+		 * while waiting acks.
+		 */
+		max_win = TCP_TX_BUF_SIZE / 3;
+	}
+
+	max_win = MAX(max_win, NET_IPV6_MTU);
+	if ((size_t)win > max_win) {
+		NET_DBG("Lowering send window from %zd to %zd",
+			(size_t)win, max_win);
+
+		win = max_win;
+	}
+
+	return win;
+}
+
+/* Release the sent data the peer acknowledged. Returns false if there
+ * is nothing more to do for the segment, the connection is reset if the
+ * acknowledgment is not valid.
+ */
+static bool tcp_data_acked(struct tcp *conn, uint32_t len_acked)
+{
+	NET_DBG("conn: %p len_acked=%u", conn, len_acked);
+
+	if ((conn->send_data_total < len_acked) ||
+	    (tcp_pkt_pull(conn->send_data, len_acked) < 0)) {
+		NET_ERR("conn: %p, Invalid len_acked=%u (total=%zu)", conn,
+			len_acked, conn->send_data_total);
+		net_stats_update_tcp_seg_drop(conn->iface);
+		tcp_out(conn, RST);
+		conn_state(conn, TCP_CLOSED);
+		return false;
+	}
+
+	conn->send_data_total -= len_acked;
+	if (conn->unacked_len < len_acked) {
+		conn->unacked_len = 0;
+	} else {
+		conn->unacked_len -= len_acked;
+	}
+	conn_seq(conn, + len_acked);
+	net_stats_update_tcp_seg_recv(conn->iface);
+
+	tcp_rtt_update(conn);
+
+#if defined(CONFIG_NET_TCP_SACK)
+	tcp_sack_ack(conn);
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	if (tcp_cc_ack(conn, len_acked)) {
+		(void)tcp_fast_retransmit(conn);
+	}
+#endif
+
+	conn_send_data_dump(conn);
+
+	if (!k_work_delayable_remaining_get(&conn->send_data_timer)) {
+		NET_DBG("conn: %p, Missing a subscription "
+			"of the send_data queue timer", conn);
+		return false;
+	}
+
+	conn->send_data_retries = 0;
+	k_work_cancel_delayable(&conn->send_data_timer);
+	if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		conn->unacked_len = 0;
+	}
+	conn->data_mode = TCP_DATA_MODE_SEND;
+
+	return true;
+}
+
+/* Send the data the acknowledgment made room for */
+static bool tcp_send_more(struct tcp *conn)
+{
+	int ret;
+
+	ret = tcp_send_queued_data(conn);
+	if (ret < 0 && ret != -ENOBUFS) {
+		tcp_out(conn, RST);
+		conn_state(conn, TCP_CLOSED);
+		return false;
+	}
+
+	return true;
+}
+
+/* Header prediction (Van Jacobson, "TCP/IP header prediction"). In an
+ * established connection nearly every segment is either the next in-order
+ * data while we have nothing outstanding, or a pure ACK for data we sent,
+ * without options and without a change of the peer's window. Those are
+ * handled here without going through the state machine. Returns false if
+ * the segment needs the full processing of tcp_in().
+ */
+static bool tcp_in_fast(struct tcp *conn, struct net_pkt *pkt,
+			struct tcphdr *th)
+{
+	uint8_t fl = th_flags(th) & ~(ECN | CWR | PSH);
+	uint32_t len_acked;
+	size_t len;
+
+	if (conn->state != TCP_ESTABLISHED || fl != ACK ||
+	    th_off(th) != 5 || th_seq(th) != conn->ack ||
+	    tcp_peer_win(conn, th) != conn->send_win) {
+		return false;
+	}
+
+	len = tcp_data_len(pkt);
+	len_acked = th_ack(th) - conn->seq;
+
+	if (len == 0) {
+		/* A pure ACK for new data. Duplicate ACKs, ACKs during
+		 * loss recovery and the ACK of our last data before a FIN
+		 * take the slow path.
+		 */
+		if (len_acked == 0 ||
+		    len_acked > (uint32_t)conn->unacked_len ||
+		    conn->data_mode != TCP_DATA_MODE_SEND || conn->in_close) {
+			return false;
+		}
+
+#if defined(CONFIG_NET_TCP_SACK)
+		if (conn->sacked_count) {
+			return false;
+		}
+#endif
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		if (conn->cc.in_recovery) {
+			return false;
+		}
+#endif
+
+		if (tcp_data_acked(conn, len_acked)) {
+			(void)tcp_send_more(conn);
+		}
+
+		return true;
+	}
+
+	/* In-order data that acknowledges nothing new, while no out of
+	 * order data waits for it.
+	 */
+	if (len_acked != 0 ||
+	    (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
+	     !net_pkt_is_empty(conn->queue_recv_data))) {
+		return false;
+	}
+
+	(void)tcp_data_received(conn, pkt, &len);
+
+	return true;
 }
 
 /* TCP state machine, everything happens here */
@@ -1722,8 +2872,10 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	struct net_pkt *recv_pkt;
 	void *recv_user_data;
 	struct k_fifo *recv_data_fifo;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	uint32_t prev_send_win = 0U;
+#endif
 	size_t len;
-	int ret;
 
 	if (th) {
 		/* Currently we ignore ECN and CWR flags */
@@ -1732,6 +2884,11 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	k_mutex_lock(&conn->lock, K_FOREVER);
 
+	if (IS_ENABLED(CONFIG_NET_TCP_HEADER_PREDICTION) && th &&
+	    tcp_in_fast(conn, pkt, th)) {
+		goto out;
+	}
+
 	NET_DBG("%s", log_strdup(tcp_conn_state(conn, pkt)));
 
 	if (th && th_off(th) < 5) {
@@ -1754,7 +2911,7 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len, fl)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		conn_state(conn, TCP_CLOSED);
@@ -1762,30 +2919,10 @@ static void tcp_in(struct tcp *conn, struct net_pkt *pkt)
 	}
 
 	if (th) {
-		size_t max_win;
-
-		conn->send_win = ntohs(th_win(th));
-
-#if defined(CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE)
-		if (CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE) {
-			max_win = CONFIG_NET_TCP_MAX_SEND_WINDOW_SIZE;
-		} else
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		prev_send_win = conn->send_win;
 #endif
-		{
-			/* Adjust the window so that we do not run out of bufs
-			 * while waiting acks.
-			 */
-			max_win = (CONFIG_NET_BUF_TX_COUNT *
-				   CONFIG_NET_BUF_DATA_SIZE) / 3;
-		}
-
-		max_win = MAX(max_win, NET_IPV6_MTU);
-		if ((size_t)conn->send_win > max_win) {
-			NET_DBG("Lowering send window from %zd to %zd",
-				(size_t)conn->send_win, max_win);
-
-			conn->send_win = max_win;
-		}
+		conn->send_win = tcp_peer_win(conn, th);
 	}
 
 next_state:
@@ -1796,9 +2933,12 @@ next_state:
 		if (FL(&fl, ==, SYN)) {
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
+			tcp_syn_options_set(conn, true);
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
+			tcp_adv_win_sent(conn, 0);
 			tcp_out(conn, SYN | ACK);
 			conn->send_options.mss_found = false;
+			tcp_syn_options_negotiate(conn);
 			conn_seq(conn, + 1);
 			next = TCP_SYN_RECEIVED;
 
@@ -1809,6 +2949,7 @@ next_state:
 						    ACK_TIMEOUT);
 		} else {
 			conn->send_options.mss_found = true;
+			tcp_syn_options_set(conn, false);
 			tcp_out(conn, SYN);
 			conn->send_options.mss_found = false;
 			conn_seq(conn, + 1);
@@ -1820,6 +2961,12 @@ next_state:
 				th_seq(th) == conn->ack)) {
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			tcp_cc_init(conn);
+#endif
+#if defined(CONFIG_NET_TCP_GSO)
+			conn->gso = tcp_gso_check(conn);
+#endif
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1852,7 +2999,9 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_syn_options_negotiate(conn);
 			conn_ack(conn, th_seq(th) + 1);
+			tcp_adv_win_sent(conn, 0);
 			if (len) {
 				if (tcp_data_get(conn, pkt, &len) < 0) {
 					break;
@@ -1860,6 +3009,12 @@ next_state:
 				conn_ack(conn, + len);
 			}
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			tcp_cc_init(conn);
+#endif
+#if defined(CONFIG_NET_TCP_GSO)
+			conn->gso = tcp_gso_check(conn);
+#endif
 			next = TCP_ESTABLISHED;
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -1906,46 +3061,27 @@ next_state:
 			break;
 		}
 
-		if (th && net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
-			uint32_t len_acked = th_ack(th) - conn->seq;
-
-			NET_DBG("conn: %p len_acked=%u", conn, len_acked);
-
-			if ((conn->send_data_total < len_acked) ||
-					(tcp_pkt_pull(conn->send_data,
-						      len_acked) < 0)) {
-				NET_ERR("conn: %p, Invalid len_acked=%u "
-					"(total=%zu)", conn, len_acked,
-					conn->send_data_total);
-				net_stats_update_tcp_seg_drop(conn->iface);
-				tcp_out(conn, RST);
-				conn_state(conn, TCP_CLOSED);
-				break;
-			}
-
-			conn->send_data_total -= len_acked;
-			if (conn->unacked_len < len_acked) {
-				conn->unacked_len = 0;
-			} else {
-				conn->unacked_len -= len_acked;
-			}
-			conn_seq(conn, + len_acked);
-			net_stats_update_tcp_seg_recv(conn->iface);
+#if defined(CONFIG_NET_TCP_SACK)
+		if (th && conn->sack_ok) {
+			tcp_sack_update(conn);
+		}
+#endif
 
-			conn_send_data_dump(conn);
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		/* A duplicate ACK carries no data, does not move the window
+		 * and acknowledges nothing new while data is outstanding.
+		 */
+		if (th && len == 0 && th_ack(th) == conn->seq &&
+		    conn->send_win == prev_send_win && conn->unacked_len > 0 &&
+		    conn->data_mode == TCP_DATA_MODE_SEND) {
+			tcp_dup_ack(conn);
+		}
+#endif
 
-			if (!k_work_delayable_remaining_get(
-				    &conn->send_data_timer)) {
-				NET_DBG("conn: %p, Missing a subscription "
-					"of the send_data queue timer", conn);
+		if (th && net_tcp_seq_cmp(th_ack(th), conn->seq) > 0) {
+			if (!tcp_data_acked(conn, th_ack(th) - conn->seq)) {
 				break;
 			}
-			conn->send_data_retries = 0;
-			k_work_cancel_delayable(&conn->send_data_timer);
-			if (conn->data_mode == TCP_DATA_MODE_RESEND) {
-				conn->unacked_len = 0;
-			}
-			conn->data_mode = TCP_DATA_MODE_SEND;
 
 			/* We are closing the connection, send a FIN to peer */
 			if (conn->in_close && conn->send_data_total == 0) {
@@ -1957,10 +3093,7 @@ next_state:
 				break;
 			}
 
-			ret = tcp_send_queued_data(conn);
-			if (ret < 0 && ret != -ENOBUFS) {
-				tcp_out(conn, RST);
-				conn_state(conn, TCP_CLOSED);
+			if (!tcp_send_more(conn)) {
 				break;
 			}
 		}
@@ -2054,6 +3187,7 @@ next_state:
 		goto next_state;
 	}
 
+out:
 	/* If the conn->context is not set, then the connection was already
 	 * closed.
 	 */
@@ -2117,7 +3251,7 @@ int net_tcp_put(struct net_context *context)
 			 */
 			k_work_reschedule_for_queue(&tcp_work_q,
 						    &conn->send_data_timer,
-						    K_MSEC(tcp_rto));
+						    K_MSEC(conn->rto));
 		} else {
 			int ret;
 
@@ -2167,7 +3301,8 @@ int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 	}
 
 	new_win = ((struct tcp *)context->tcp)->recv_win + delta;
-	if (new_win < 0 || new_win > UINT16_MAX) {
+	if (new_win < 0 ||
+	    new_win > (UINT16_MAX << ((struct tcp *)context->tcp)->recv_wscale)) {
 		return -EINVAL;
 	}
 
@@ -2234,14 +3369,10 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 	pkt->buffer = NULL;
 
 	ret = tcp_send_queued_data(conn);
-	if (ret < 0 && ret != -ENOBUFS) {
-		tcp_conn_unref(conn);
-		goto out;
-	}
-
-	if (ret == -ENOBUFS) {
+	if (ret < 0) {
 		/* Restore the original data so that we do not resend the pkt
-		 * data multiple times.
+		 * data multiple times. The caller gets its buffers back on
+		 * any error, as they may be zero-copy buffers it still owns.
 		 */
 		conn->send_data_total -= len;
 
@@ -2252,6 +3383,10 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 			pkt->buffer = conn->send_data->buffer;
 			conn->send_data->buffer = NULL;
 		}
+
+		if (ret != -ENOBUFS) {
+			tcp_conn_unref(conn);
+		}
 	} else {
 		/* We should not free the pkt if there was an error. It will be
 		 * freed in net_context.c:context_sendto()
@@ -2361,6 +3496,8 @@ int net_tcp_connect(struct net_context *context,
 
 	net_context_set_state(context, NET_CONTEXT_CONNECTING);
 
+	tcp_conn_hash_add(conn);
+
 	ret = net_conn_register(net_context_get_ip_proto(context),
 				net_context_get_family(context),
 				remote_addr, local_addr,
@@ -2497,7 +3634,11 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_TX_TRANSPORT);
+
+	/* Segments of a segmentation offload packet get their own checksum */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_gso_size(pkt)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
@@ -2538,7 +3679,15 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 	if (th) {
 		struct tcp *conn = tcp_conn_search(pkt);
 
-		if (conn == NULL && SYN == th_flags(th)) {
+		if (conn) {
+			conn->iface = pkt->iface;
+			tcp_in(conn, pkt);
+			tcp_conn_release(conn);
+
+			return NET_DROP;
+		}
+
+		if (SYN == th_flags(th)) {
 			struct net_context *context =
 				tcp_calloc(1, sizeof(struct net_context));
 			net_tcp_get(context);
@@ -2546,6 +3695,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_add(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -2624,6 +3774,13 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 	bool responded = false;
 	static char buf[512];
 
+	/* The test protocol drives the connections from this thread only,
+	 * so the lookup reference is not needed.
+	 */
+	if (conn) {
+		tcp_conn_release(conn);
+	}
+
 	net_pkt_cursor_init(pkt);
 	net_pkt_set_overwrite(pkt, true);
 	net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
@@ -2667,6 +3824,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_hash_add(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
@@ -2843,6 +4001,8 @@ const char *net_tcp_state_str(enum tcp_state state)
 
 void net_tcp_init(void)
 {
+	tcp_conn_hash_seed = sys_rand32_get();
+
 #if defined(CONFIG_NET_TEST_PROTOCOL)
 	/* Register inputs for TTCN-3 based TCP sanity check */
 	test_cb_register(AF_INET,  IPPROTO_TCP, 4242, 4242, tcp_input);
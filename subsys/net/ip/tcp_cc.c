@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* Number of duplicate ACKs that trigger a fast retransmit */
+#define DUP_ACK_THRESHOLD 3
+
+/* Initial window as in RFC 5681 chapter 3.1 */
+static uint32_t initial_window(uint32_t mss)
+{
+	if (mss > 2190) {
+		return 2 * mss;
+	} else if (mss > 1095) {
+		return 3 * mss;
+	}
+
+	return 4 * mss;
+}
+
+#if defined(CONFIG_NET_TCP_CC_NEWRENO)
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cc *cc = &conn->cc;
+
+	/* Appropriate byte counting, one segment per window of data */
+	cc->bytes_acked += acked;
+	if (cc->bytes_acked >= cc->cwnd) {
+		cc->bytes_acked -= cc->cwnd;
+		cc->cwnd += conn_mss(conn);
+	}
+}
+
+static uint32_t newreno_ssthresh(struct tcp *conn)
+{
+	return MAX((uint32_t)conn->unacked_len / 2, 2U * conn_mss(conn));
+}
+
+static const struct tcp_cc_ops tcp_cc_newreno = {
+	.name = "newreno",
+	.cong_avoid = newreno_cong_avoid,
+	.ssthresh = newreno_ssthresh,
+};
+
+#define TCP_CC_DEFAULT (&tcp_cc_newreno)
+#endif /* CONFIG_NET_TCP_CC_NEWRENO */
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+/* Multiplicative decrease factor 0.7 and TCP friendly increase factor
+ * 3 * (1 - 0.7) / (1 + 0.7) ~ 0.53, both scaled by 1024.
+ */
+#define CUBIC_BETA 717U
+#define CUBIC_ALPHA 542U
+
+/* Limit of the time offset from K so that the cube fits in 64 bits */
+#define CUBIC_MAX_T_MS (1 << 17)
+
+/* Integer cube root, from Hacker's Delight */
+static uint32_t cubic_root(uint64_t x)
+{
+	uint64_t y = 0U;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3U * y * (y + 1U) + 1U;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void cubic_init(struct tcp *conn)
+{
+	conn->cc.w_max = 0U;
+	conn->cc.epoch_start = 0U;
+}
+
+/* W(t) = C * (t - K)^3 + W_max with C = 0.4 segments / s^3, computed in
+ * bytes with t and K in milliseconds.
+ */
+static uint32_t cubic_window(struct tcp *conn, uint32_t t)
+{
+	struct tcp_cc *cc = &conn->cc;
+	int32_t d = CLAMP((int32_t)(t - cc->k), -CUBIC_MAX_T_MS,
+			  CUBIC_MAX_T_MS);
+	uint64_t a = d < 0 ? -d : d;
+	uint64_t delta = (a * a * a / 1000U) * conn_mss(conn) * 4U / 10000000U;
+
+	if (d >= 0) {
+		return (uint32_t)MIN(cc->origin + delta, UINT32_MAX);
+	}
+
+	return delta < cc->origin ? cc->origin - (uint32_t)delta : 0U;
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cc *cc = &conn->cc;
+	uint32_t mss = conn_mss(conn);
+	uint32_t now = k_uptime_get_32();
+	uint32_t target;
+
+	if (cc->epoch_start == 0U) {
+		cc->epoch_start = now ? now : 1U;
+		cc->w_est = cc->cwnd;
+
+		if (cc->cwnd < cc->w_max) {
+			/* K = cbrt((W_max - cwnd) / C) */
+			cc->k = cubic_root((uint64_t)(cc->w_max - cc->cwnd) *
+					   2500000000ULL / mss);
+			cc->origin = cc->w_max;
+		} else {
+			cc->k = 0U;
+			cc->origin = cc->cwnd;
+		}
+	}
+
+	/* Aim for the window one round trip ahead */
+	target = cubic_window(conn, now - cc->epoch_start + (conn->srtt >> 3));
+
+	/* Grow at least as fast as standard TCP would */
+	cc->w_est += (uint32_t)((uint64_t)acked * mss * CUBIC_ALPHA /
+				(1024U * cc->cwnd));
+	target = MAX(target, cc->w_est);
+
+	if (target > cc->cwnd) {
+		cc->cwnd += MIN((uint32_t)((uint64_t)(target - cc->cwnd) *
+					   acked / cc->cwnd), acked);
+	}
+}
+
+static uint32_t cubic_ssthresh(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+
+	cc->epoch_start = 0U;
+
+	/* Fast convergence, release bandwidth for newer flows */
+	if (cc->cwnd < cc->w_max) {
+		cc->w_max = (uint32_t)((uint64_t)cc->cwnd *
+				       (1024U + CUBIC_BETA) / 2048U);
+	} else {
+		cc->w_max = cc->cwnd;
+	}
+
+	return MAX((uint32_t)((uint64_t)cc->cwnd * CUBIC_BETA / 1024U),
+		   2U * conn_mss(conn));
+}
+
+static const struct tcp_cc_ops tcp_cc_cubic = {
+	.name = "cubic",
+	.init = cubic_init,
+	.cong_avoid = cubic_cong_avoid,
+	.ssthresh = cubic_ssthresh,
+};
+
+#define TCP_CC_DEFAULT (&tcp_cc_cubic)
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
+
+void tcp_cc_init(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+
+	cc->ops = TCP_CC_DEFAULT;
+	cc->cwnd = initial_window(conn_mss(conn));
+	cc->ssthresh = UINT32_MAX;
+	cc->recover = conn->seq - 1U;
+	cc->bytes_acked = 0U;
+	cc->dup_acks = 0U;
+	cc->in_recovery = false;
+
+	if (cc->ops->init) {
+		cc->ops->init(conn);
+	}
+
+	NET_DBG("conn: %p cc %s cwnd %u", conn, cc->ops->name, cc->cwnd);
+}
+
+/* Called after conn->seq has been advanced by acked bytes. Returns true
+ * if this was a partial ACK during fast recovery, in which case the
+ * caller must retransmit the first unacknowledged segment.
+ */
+bool tcp_cc_ack(struct tcp *conn, uint32_t acked)
+{
+	struct tcp_cc *cc = &conn->cc;
+	uint32_t mss = conn_mss(conn);
+
+	cc->dup_acks = 0U;
+
+	if (cc->in_recovery) {
+		if (net_tcp_seq_cmp(conn->seq, cc->recover) > 0) {
+			/* Full ACK, deflate the window */
+			cc->in_recovery = false;
+			cc->cwnd = cc->ssthresh;
+			cc->bytes_acked = 0U;
+
+			NET_DBG("conn: %p recovery done, cwnd %u", conn,
+				cc->cwnd);
+			return false;
+		}
+
+		/* Partial ACK (RFC 6582 chapter 3.2 step 3) */
+		cc->cwnd -= MIN(acked, cc->cwnd - mss);
+		cc->cwnd += mss;
+		return true;
+	}
+
+	/* Do not grow the window when the sender was not limited by it */
+	if (conn->unacked_len + acked < cc->cwnd) {
+		return false;
+	}
+
+	if (cc->cwnd < cc->ssthresh) {
+		cc->cwnd += MIN(acked, mss);
+	} else {
+		cc->ops->cong_avoid(conn, acked);
+	}
+
+	return false;
+}
+
+/* Returns true when enough duplicate ACKs have been seen to do a fast
+ * retransmit.
+ */
+bool tcp_cc_dup_ack(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+	uint32_t mss = conn_mss(conn);
+
+	if (cc->in_recovery) {
+		/* Every duplicate ACK means a segment has left the network */
+		cc->cwnd += mss;
+		return false;
+	}
+
+	if (++cc->dup_acks != DUP_ACK_THRESHOLD) {
+		return false;
+	}
+
+	/* Do not enter recovery again for losses from the same window */
+	if (net_tcp_seq_cmp(conn->seq, cc->recover) <= 0) {
+		return false;
+	}
+
+	cc->ssthresh = cc->ops->ssthresh(conn);
+	cc->cwnd = cc->ssthresh + DUP_ACK_THRESHOLD * mss;
+	cc->recover = conn->seq + conn->unacked_len - 1U;
+	cc->in_recovery = true;
+
+	NET_DBG("conn: %p fast retransmit, ssthresh %u cwnd %u", conn,
+		cc->ssthresh, cc->cwnd);
+
+	return true;
+}
+
+void tcp_cc_timeout(struct tcp *conn)
+{
+	struct tcp_cc *cc = &conn->cc;
+
+	/* Only the first timeout of a segment reduces ssthresh */
+	if (conn->send_data_retries == 0U) {
+		cc->ssthresh = cc->ops->ssthresh(conn);
+	}
+
+	cc->cwnd = conn_mss(conn);
+	cc->recover = conn->seq + conn->unacked_len - 1U;
+	cc->bytes_acked = 0U;
+	cc->dup_acks = 0U;
+	cc->in_recovery = false;
+
+	NET_DBG("conn: %p timeout, ssthresh %u cwnd %u", conn, cc->ssthresh,
+		cc->cwnd);
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+#include "net_private.h"
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+/* Timeout for the buffers of one segment */
+#define BUF_ALLOC_TIMEOUT K_MSEC(100)
+
+/* Only the last segment keeps these flags of the original packet */
+#define LAST_SEGMENT_FLAGS (FIN | PSH)
+
+static void gso_copy_attributes(struct net_pkt *seg, struct net_pkt *pkt)
+{
+	net_pkt_set_context(seg, net_pkt_context(pkt));
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+
+	/* The link layer addresses point to the neighbor cache or to the
+	 * interface, so they stay valid while the segments are sent.
+	 */
+	*net_pkt_lladdr_src(seg) = *net_pkt_lladdr_src(pkt);
+	*net_pkt_lladdr_dst(seg) = *net_pkt_lladdr_dst(pkt);
+}
+
+/* Update the headers copied from the original packet, the checksums are
+ * then calculated by the normal finalize path.
+ */
+static int gso_update_headers(struct net_pkt *seg, size_t offset,
+			      uint16_t index, bool last)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	struct net_tcp_hdr *tcp_hdr;
+	uint32_t seq;
+
+	net_pkt_cursor_init(seg);
+	net_pkt_set_overwrite(seg, true);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		struct net_ipv4_hdr *ipv4_hdr = NET_IPV4_HDR(seg);
+		uint16_t id = (ipv4_hdr->id[0] << 8 | ipv4_hdr->id[1]) + index;
+
+		ipv4_hdr->id[0] = id >> 8;
+		ipv4_hdr->id[1] = id;
+		ipv4_hdr->chksum = 0U;
+	}
+
+	if (net_pkt_skip(seg, net_pkt_ip_hdr_len(seg) +
+			 net_pkt_ip_opts_len(seg))) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(seg, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	seq = sys_get_be32(tcp_hdr->seq) + offset;
+	sys_put_be32(seq, tcp_hdr->seq);
+
+	if (!last) {
+		tcp_hdr->flags &= ~LAST_SEGMENT_FLAGS;
+	}
+
+	if (net_pkt_set_data(seg, &tcp_access)) {
+		return -ENOBUFS;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		return net_ipv4_finalize(seg, IPPROTO_TCP);
+	}
+
+	return net_ipv6_finalize(seg, IPPROTO_TCP);
+}
+
+static struct net_pkt *gso_segment(struct net_pkt *pkt, size_t hdr_len,
+				   size_t offset, size_t len, uint16_t index,
+				   bool last)
+{
+	struct net_pkt *seg;
+
+	seg = net_pkt_alloc_with_buffer(net_pkt_iface(pkt), hdr_len + len,
+					net_pkt_family(pkt), 0,
+					BUF_ALLOC_TIMEOUT);
+	if (!seg) {
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(seg, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(seg, pkt, len)) {
+		goto fail;
+	}
+
+	gso_copy_attributes(seg, pkt);
+
+	if (gso_update_headers(seg, offset, index, last) < 0) {
+		goto fail;
+	}
+
+	net_pkt_cursor_init(seg);
+
+	return seg;
+
+fail:
+	net_pkt_unref(seg);
+
+	return NULL;
+}
+
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	struct net_tcp_hdr *tcp_hdr;
+	size_t hdr_len, data_len, offset;
+	uint16_t index = 0U;
+	int ret = -ENODATA;
+	int sent = 0;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	if (net_pkt_skip(pkt, hdr_len)) {
+		return -ENOBUFS;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -ENOBUFS;
+	}
+
+	hdr_len += (tcp_hdr->offset >> 4) * 4U;
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	NET_DBG("pkt %p len %zu mss %u", pkt, data_len, mss);
+
+	for (offset = 0; offset < data_len; offset += mss, index++) {
+		size_t len = MIN(mss, data_len - offset);
+		struct net_pkt *seg;
+
+		seg = gso_segment(pkt, hdr_len, offset, len, index,
+				  offset + len == data_len);
+		if (!seg) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		ret = net_if_l2(iface)->send(iface, seg);
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			break;
+		}
+
+		sent += ret;
+	}
+
+	if (sent == 0) {
+		return ret;
+	}
+
+	/* Like L2 does, the original packet is consumed once anything was
+	 * sent. Data of the segments that were not sent is retransmitted
+	 * by TCP.
+	 */
+	net_pkt_unref(pkt);
+
+	return sent;
+}
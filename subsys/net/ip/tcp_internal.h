@@ -299,7 +299,8 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
  * @brief Enqueue a single packet for transmission
  *
  * @param context TCP context
- * @param pkt Packet
+ * @param pkt Packet. On success TCP takes the packet and its data, on
+ *        error the data is left in the packet for the caller.
  *
  * @return 0 if ok, < 0 if error
  */
@@ -359,6 +360,43 @@ static inline int net_tcp_put(struct net_context *context)
 }
 #endif
 
+/**
+ * @brief Split a TCP packet larger than the MSS into segments and send
+ * them with the L2 of the interface.
+ *
+ * @param iface Network interface the packet is sent to
+ * @param pkt Packet with net_pkt_gso_size() set
+ *
+ * @return Number of bytes sent, in which case the packet is consumed,
+ *         or < 0 on error if nothing was sent
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_tcp_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Process the TCP segments held for receive offload
+ *
+ * Called by the thread of an RX queue when the queue becomes empty, so
+ * that merged segments are never held longer than the burst they
+ * arrived in. Only the segments held by that queue are processed.
+ *
+ * @param queue RX queue of the calling thread
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+void net_tcp_gro_flush(int queue);
+#else
+#define net_tcp_gro_flush(...)
+#endif
+
 #define NET_TCP_MAX_OPT_SIZE  8
 
 #if defined(CONFIG_NET_NATIVE_TCP)
@@ -125,7 +125,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -206,22 +206,74 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Largest shift allowed by RFC 7323 */
+#define NET_TCP_MAX_WINDOW_SCALE  14
+
+/* Without timestamps four SACK blocks fit in the option space */
+#define NET_TCP_MAX_SACK_BLOCKS   4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
-	uint16_t window;
+	uint16_t window; /* window scale shift */
+#if defined(CONFIG_NET_TCP_SACK)
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+	uint8_t sack_count;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm : 1;
+};
+
+struct tcp;
+
+/* Congestion control algorithm. Slow start, fast retransmit and fast
+ * recovery are common to all algorithms, the algorithm only decides how
+ * the window grows in congestion avoidance and how much it is reduced
+ * on a congestion event.
+ */
+struct tcp_cc_ops {
+	const char *name;
+	void (*init)(struct tcp *conn);
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked);
+	uint32_t (*ssthresh)(struct tcp *conn);
+};
+
+struct tcp_cc {
+	const struct tcp_cc_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	uint32_t recover; /* last seq sent when recovery was entered */
+	uint32_t bytes_acked;
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	uint32_t w_max;
+	uint32_t w_est;
+	uint32_t origin;
+	uint32_t epoch_start;
+	uint32_t k;
+#endif
+	uint8_t dup_acks;
+	bool in_recovery : 1;
 };
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+	sys_snode_t hash_next; /* connection hash table bucket list */
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_pkt *queue_recv_data;
@@ -239,6 +291,9 @@ struct tcp { /* TCP connection */
 	struct tcp_options send_options;
 	struct k_work_delayable send_timer;
 	struct k_work_delayable recv_queue_timer;
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	struct k_work_delayable ack_timer;
+#endif
 	struct k_work_delayable send_data_timer;
 	struct k_work_delayable timewait_timer;
 	union {
@@ -251,6 +306,21 @@ struct tcp { /* TCP connection */
 	};
 	union tcp_endpoint src;
 	union tcp_endpoint dst;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	struct tcp_cc cc;
+#endif
+#if defined(CONFIG_NET_TCP_SACK)
+	/* Data selectively acknowledged by the peer, sorted by seq */
+	struct tcp_sack_block sacked[NET_TCP_MAX_SACK_BLOCKS];
+	uint32_t sack_rexmit; /* next seq to resend during recovery */
+	uint8_t sacked_count;
+#endif
+#if defined(CONFIG_NET_TCP_GRO)
+	sys_snode_t gro_next;	 /* entry in the list of held segments */
+	struct net_pkt *gro_pkt; /* in-order segments merged so far */
+	uint32_t gro_seq;	 /* seq following the merged data */
+	uint8_t gro_queue;	 /* RX queue whose list holds the conn */
+#endif
 	size_t send_data_total;
 	size_t send_retries;
 	int unacked_len;
@@ -259,12 +329,29 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win;
-	uint16_t send_win;
+	uint32_t rtt_seq;  /* end of the segment being timed */
+	uint32_t rtt_time; /* uptime in ms when rtt_seq was sent */
+	uint32_t srtt;     /* smoothed round trip time, in 1/8 ms */
+	uint32_t rttvar;   /* round trip time variation, in 1/4 ms */
+	uint32_t rto;      /* retransmission timeout in ms */
+	uint32_t recv_win;
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+	uint32_t ack_pending; /* bytes received but not acknowledged yet */
+#endif
+#if defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+	uint32_t recv_win_edge; /* seq at the right edge of the last window */
+#endif
+	uint32_t send_win;
+	uint8_t send_wscale; /* shift of the window advertised by peer */
+	uint8_t recv_wscale; /* shift of the window we advertise */
 	uint8_t send_data_retries;
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
+	bool rtt_pending : 1;
+	bool sack_ok : 1;
+	bool gso : 1;
+	bool gro_queued : 1;
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
@@ -284,3 +371,10 @@ struct tcp { /* TCP connection */
 	_flags(_fl, _op, _mask, strlen("" #_args) ? _args : true)
 
 typedef void (*net_tcp_cb_t)(struct tcp *conn, void *user_data);
+
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+void tcp_cc_init(struct tcp *conn);
+bool tcp_cc_ack(struct tcp *conn, uint32_t acked);
+bool tcp_cc_dup_ack(struct tcp *conn);
+void tcp_cc_timeout(struct tcp *conn);
+#endif
@@ -51,6 +51,8 @@ int net_udp_finalize(struct net_pkt *pkt)
 
 	udp_hdr->len = htons(length);
 
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_TX_TRANSPORT);
+
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
 		udp_hdr->chksum = net_calc_chksum_udp(pkt);
 	}
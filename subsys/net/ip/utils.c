@@ -487,34 +487,95 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+/* Add up the data as native 16-bit words, 32 bits at a time, into a wide
+ * accumulator so that carries only need to be folded back once at the end.
+ * The one's complement sum does not depend on the byte order (RFC 1071),
+ * the caller converts the folded result to host order. The data must be
+ * 16-bit aligned.
+ */
+static uint64_t chksum_words(const uint8_t *data, size_t len)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	uint64_t acc = 0U;
 
-	end = data + len - 1;
+	if ((POINTER_TO_UINT(data) & 2U) && len >= 2U) {
+		acc += *(const uint16_t *)data;
+		data += 2;
+		len -= 2U;
+	}
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	while (len >= 16U) {
+		const uint32_t *p = (const uint32_t *)data;
+
+		acc += (uint64_t)p[0] + p[1] + p[2] + p[3];
+		data += 16;
+		len -= 16U;
+	}
 
+	while (len >= 4U) {
+		acc += *(const uint32_t *)data;
+		data += 4;
+		len -= 4U;
+	}
+
+	if (len >= 2U) {
+		acc += *(const uint16_t *)data;
 		data += 2;
+		len -= 2U;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	/* A trailing byte is the high byte of a word padded with zero */
+	if (len) {
+		acc += ntohs(data[0] << 8);
+	}
+
+	return acc;
+}
+
+static inline uint16_t chksum_fold(uint64_t acc)
+{
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffff) + (acc >> 16);
+	acc = (acc & 0xffff) + (acc >> 16);
+
+	return acc;
+}
+
+static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	uint64_t acc;
+	uint16_t tmp;
+
+	if (len == 0U) {
+		return sum;
+	}
+
+	if (POINTER_TO_UINT(data) & 1U) {
+		/* The first byte is the high byte of a word. The rest is
+		 * then summed one byte off, which only swaps the bytes of
+		 * its sum.
+		 */
+		tmp = chksum_fold(chksum_words(data + 1, len - 1));
+		acc = ntohs(data[0] << 8) + (uint16_t)__bswap_16(tmp);
+	} else {
+		acc = chksum_words(data, len);
+	}
+
+	tmp = ntohs(chksum_fold(acc));
+
+	sum += tmp;
+	if (sum < tmp) {
+		sum++;
 	}
 
 	return sum;
 }
 
+uint16_t net_calc_chksum_data(uint16_t sum, const uint8_t *data, size_t len)
+{
+	return calc_chksum(sum, data, len);
+}
+
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
@@ -273,6 +273,8 @@ int z_impl_zsock_close(int sock)
 		return -1;
 	}
 
+	z_epoll_fd_close(sock);
+
 	(void)k_mutex_lock(lock, K_FOREVER);
 
 	NET_DBG("close: ctx=%p, fd=%d", ctx, sock);
@@ -396,6 +398,7 @@ static void zsock_received_cb(struct net_context *ctx,
 	net_pkt_set_eof(pkt, false);
 
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_SOCKET);
 
 	k_fifo_put(&ctx->recv_q, pkt);
 
@@ -1053,18 +1056,129 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
+static int sock_get_pkt_dst_addr(struct net_pkt *pkt, void *addr)
+{
+	struct net_pkt_cursor backup;
+	int ret = 0;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) &&
+	    net_pkt_family(pkt) == AF_INET) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access,
+						      struct net_ipv4_hdr);
+		struct net_ipv4_hdr *ipv4_hdr;
+
+		ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(
+							pkt, &ipv4_access);
+		if (!ipv4_hdr) {
+			ret = -ENOBUFS;
+			goto error;
+		}
+
+		net_ipv4_addr_copy_raw(addr, ipv4_hdr->dst);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv6_access,
+						      struct net_ipv6_hdr);
+		struct net_ipv6_hdr *ipv6_hdr;
+
+		ipv6_hdr = (struct net_ipv6_hdr *)net_pkt_get_data(
+							pkt, &ipv6_access);
+		if (!ipv6_hdr) {
+			ret = -ENOBUFS;
+			goto error;
+		}
+
+		net_ipv6_addr_copy_raw(addr, ipv6_hdr->dst);
+	} else {
+		ret = -ENOTSUP;
+	}
+
+error:
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return ret;
+}
+
+static void sock_put_cmsg(struct msghdr *msg, size_t *used, int level,
+			  int type, const void *data, size_t len)
+{
+	struct cmsghdr *cmsg;
+
+	if (msg->msg_controllen - *used < CMSG_SPACE(len)) {
+		msg->msg_flags |= ZSOCK_MSG_CTRUNC;
+		return;
+	}
+
+	cmsg = (struct cmsghdr *)((uint8_t *)msg->msg_control + *used);
+	cmsg->cmsg_len = CMSG_LEN(len);
+	cmsg->cmsg_level = level;
+	cmsg->cmsg_type = type;
+	memcpy(CMSG_DATA(cmsg), data, len);
+
+	*used += CMSG_SPACE(len);
+}
+
+/* Fill the ancillary data enabled by the socket options. The IP headers
+ * are still in front of the cursor of the received packet.
+ */
+static void sock_get_pkt_cmsgs(struct net_context *ctx, struct net_pkt *pkt,
+			       struct msghdr *msg)
+{
+	size_t used = 0;
+
+	if (sock_get_flag(ctx, SOCK_PKTINFO) &&
+	    !net_if_is_ip_offloaded(net_pkt_iface(pkt))) {
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(pkt) == AF_INET) {
+			struct in_pktinfo info = {
+				.ipi_ifindex =
+					net_if_get_by_iface(net_pkt_iface(pkt)),
+			};
+
+			if (sock_get_pkt_dst_addr(pkt, &info.ipi_addr) == 0) {
+				info.ipi_spec_dst = info.ipi_addr;
+				sock_put_cmsg(msg, &used, IPPROTO_IP,
+					      IP_PKTINFO, &info, sizeof(info));
+			}
+		} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+			   net_pkt_family(pkt) == AF_INET6) {
+			struct in6_pktinfo info = {
+				.ipi6_ifindex =
+					net_if_get_by_iface(net_pkt_iface(pkt)),
+			};
+
+			if (sock_get_pkt_dst_addr(pkt, &info.ipi6_addr) == 0) {
+				sock_put_cmsg(msg, &used, IPPROTO_IPV6,
+					      IPV6_PKTINFO, &info,
+					      sizeof(info));
+			}
+		}
+	}
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP)
+	if (sock_get_flag(ctx, SOCK_TIMESTAMP)) {
+		sock_put_cmsg(msg, &used, SOL_SOCKET, SCM_TIMESTAMP,
+			      net_pkt_timestamp(pkt),
+			      sizeof(struct net_ptp_time));
+	}
+#endif
+
+	msg->msg_controllen = used;
+}
+
 static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+				       struct msghdr *msg,
+				       int flags)
 {
 	k_timeout_t timeout = K_FOREVER;
 	size_t recv_len = 0;
-	size_t read_len;
+	size_t read_len = 0;
 	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
+	size_t i;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
 		timeout = K_NO_WAIT;
@@ -1102,7 +1216,11 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	net_pkt_cursor_backup(pkt, &backup);
 
-	if (src_addr && addrlen) {
+	msg->msg_flags = 0;
+
+	if (msg->msg_name) {
+		struct sockaddr *src_addr = msg->msg_name;
+
 		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
 			/*
@@ -1113,7 +1231,8 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 			 */
 			if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
 				memcpy(src_addr, &ctx->remote,
-				       MIN(*addrlen, sizeof(ctx->remote)));
+				       MIN(msg->msg_namelen,
+					   sizeof(ctx->remote)));
 			} else {
 				errno = ENOTSUP;
 				goto fail;
@@ -1122,7 +1241,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 			int rv;
 
 			rv = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
-						   src_addr, *addrlen);
+						   src_addr, msg->msg_namelen);
 			if (rv < 0) {
 				errno = -rv;
 				LOG_ERR("sock_get_pkt_src_addr %d", rv);
@@ -1134,21 +1253,34 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		 * size of source address
 		 */
 		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
+			msg->msg_namelen = sizeof(struct sockaddr_in);
 		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
+			msg->msg_namelen = sizeof(struct sockaddr_in6);
 		} else {
 			errno = ENOTSUP;
 			goto fail;
 		}
 	}
 
+	if (msg->msg_control && msg->msg_controllen > 0) {
+		sock_get_pkt_cmsgs(ctx, pkt, msg);
+	}
+
 	recv_len = net_pkt_remaining_data(pkt);
-	read_len = MIN(recv_len, max_len);
 
-	if (net_pkt_read(pkt, buf, read_len)) {
-		errno = ENOBUFS;
-		goto fail;
+	for (i = 0; i < msg->msg_iovlen && read_len < recv_len; i++) {
+		size_t len = MIN(msg->msg_iov[i].iov_len, recv_len - read_len);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
+
+		read_len += len;
+	}
+
+	if (read_len < recv_len) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
 	}
 
 	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
@@ -1157,6 +1289,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 	}
 
 	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_trace_done(pkt, false);
 		net_pkt_unref(pkt);
 	} else {
 		net_pkt_cursor_restore(pkt, &backup);
@@ -1268,6 +1401,7 @@ static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 						pkt, k_cycle_get_32());
 				}
 
+				net_pkt_trace_done(pkt, false);
 				net_pkt_unref(pkt);
 			}
 		} else {
@@ -1305,7 +1439,27 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	}
 
 	if (sock_type == SOCK_DGRAM) {
-		return zsock_recv_dgram(ctx, buf, max_len, flags, src_addr, addrlen);
+		struct iovec iov = {
+			.iov_base = buf,
+			.iov_len = max_len,
+		};
+		struct msghdr msg = {
+			.msg_iov = &iov,
+			.msg_iovlen = 1,
+		};
+		ssize_t ret;
+
+		if (src_addr && addrlen) {
+			msg.msg_name = src_addr;
+			msg.msg_namelen = *addrlen;
+		}
+
+		ret = zsock_recv_dgram(ctx, &msg, flags);
+		if (ret >= 0 && msg.msg_name) {
+			*addrlen = msg.msg_namelen;
+		}
+
+		return ret;
 	} else if (sock_type == SOCK_STREAM) {
 		return zsock_recv_stream(ctx, buf, max_len, flags);
 	} else {
@@ -1353,6 +1507,572 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static ssize_t zsock_recv_stream_msg(struct net_context *ctx,
+				     struct msghdr *msg, int flags)
+{
+	ssize_t recv_len = 0;
+	size_t i;
+
+	for (i = 0; i < msg->msg_iovlen; i++) {
+		ssize_t ret;
+
+		if (msg->msg_iov[i].iov_len == 0) {
+			continue;
+		}
+
+		ret = zsock_recv_stream(ctx, msg->msg_iov[i].iov_base,
+					msg->msg_iov[i].iov_len, flags);
+		if (ret < 0) {
+			return recv_len > 0 ? recv_len : ret;
+		}
+
+		recv_len += ret;
+
+		/* Peeking again would return the same data */
+		if (ret < msg->msg_iov[i].iov_len ||
+		    (flags & ZSOCK_MSG_PEEK)) {
+			break;
+		}
+
+		/* Only fill the remaining vectors with the data that is
+		 * already queued, unless the caller wants to wait for all.
+		 */
+		if (!(flags & ZSOCK_MSG_WAITALL)) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return recv_len;
+}
+
+ssize_t zsock_recvmsg_ctx(struct net_context *ctx, struct msghdr *msg,
+			  int flags)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+
+	if (msg == NULL || (msg->msg_iov == NULL && msg->msg_iovlen > 0)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sock_type == SOCK_DGRAM) {
+		return zsock_recv_dgram(ctx, msg, flags);
+	} else if (sock_type == SOCK_STREAM) {
+		msg->msg_controllen = 0;
+		msg->msg_flags = 0;
+
+		return zsock_recv_stream_msg(ctx, msg, flags);
+	}
+
+	__ASSERT(0, "Unknown socket type");
+
+	return 0;
+}
+
+ssize_t z_impl_zsock_recvmsg(int sock, struct msghdr *msg, int flags)
+{
+	VTABLE_CALL(recvmsg, sock, msg, flags);
+}
+
+#ifdef CONFIG_USERSPACE
+/* Copy the message header and the iovec array to kernel memory. The data
+ * buffers stay in user memory, only the access to them is checked.
+ */
+static void zsock_msghdr_from_user(struct msghdr *msg_copy,
+				   const struct msghdr *msg, bool write)
+{
+	size_t i;
+
+	Z_OOPS(z_user_from_copy(msg_copy, (void *)msg, sizeof(*msg_copy)));
+
+	if (msg_copy->msg_iovlen > 0) {
+		msg_copy->msg_iov = z_user_alloc_from_copy(msg_copy->msg_iov,
+				msg_copy->msg_iovlen * sizeof(struct iovec));
+		Z_OOPS(!msg_copy->msg_iov);
+	} else {
+		msg_copy->msg_iov = NULL;
+	}
+
+	for (i = 0; i < msg_copy->msg_iovlen; i++) {
+		Z_OOPS(Z_SYSCALL_MEMORY(msg_copy->msg_iov[i].iov_base,
+					msg_copy->msg_iov[i].iov_len, write));
+	}
+
+	if (msg_copy->msg_name) {
+		Z_OOPS(Z_SYSCALL_MEMORY(msg_copy->msg_name,
+					msg_copy->msg_namelen, write));
+	}
+
+	if (msg_copy->msg_control) {
+		Z_OOPS(Z_SYSCALL_MEMORY(msg_copy->msg_control,
+					msg_copy->msg_controllen, write));
+	}
+}
+
+/* Pass the value-result fields of a received message back to user mode */
+static void zsock_msghdr_to_user(struct msghdr *msg,
+				 const struct msghdr *msg_copy)
+{
+	Z_OOPS(z_user_to_copy(&msg->msg_namelen, &msg_copy->msg_namelen,
+			      sizeof(msg->msg_namelen)));
+	Z_OOPS(z_user_to_copy(&msg->msg_controllen,
+			      &msg_copy->msg_controllen,
+			      sizeof(msg->msg_controllen)));
+	Z_OOPS(z_user_to_copy(&msg->msg_flags, &msg_copy->msg_flags,
+			      sizeof(msg->msg_flags)));
+}
+
+static inline ssize_t z_vrfy_zsock_recvmsg(int sock, struct msghdr *msg,
+					   int flags)
+{
+	struct msghdr msg_copy;
+	ssize_t ret;
+
+	zsock_msghdr_from_user(&msg_copy, msg, true);
+
+	ret = z_impl_zsock_recvmsg(sock, &msg_copy, flags);
+
+	k_free(msg_copy.msg_iov);
+
+	if (ret >= 0) {
+		zsock_msghdr_to_user(msg, &msg_copy);
+	}
+
+	return ret;
+}
+#include <syscalls/zsock_recvmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_recvmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL || vtable->recvmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t ret;
+
+		ret = vtable->recvmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		/* Only the first datagram is waited for */
+		flags |= ZSOCK_MSG_DONTWAIT;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* An error after the first datagram is reported by the next call,
+	 * errno is already set if nothing was received.
+	 */
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *msgvec_copy;
+	unsigned int i;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(struct zsock_mmsghdr)));
+
+	if (vlen == 0) {
+		return 0;
+	}
+
+	msgvec_copy = z_user_alloc_from_copy(msgvec,
+					vlen * sizeof(struct zsock_mmsghdr));
+	if (msgvec_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		zsock_msghdr_from_user(&msgvec_copy[i].msg_hdr,
+				       &msgvec[i].msg_hdr, true);
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		zsock_msghdr_to_user(&msgvec[i].msg_hdr,
+				     &msgvec_copy[i].msg_hdr);
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len,
+				      &msgvec_copy[i].msg_len,
+				      sizeof(msgvec[i].msg_len)));
+	}
+
+	for (i = 0; i < vlen; i++) {
+		k_free(msgvec_copy[i].msg_hdr.msg_iov);
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_sendmmsg(int sock, struct zsock_mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL || vtable->sendmsg == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ssize_t ret;
+
+		ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	k_mutex_unlock(lock);
+
+	if (i == 0 && vlen > 0) {
+		return -1;
+	}
+
+	return i;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock,
+					struct zsock_mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct zsock_mmsghdr *msgvec_copy;
+	unsigned int i;
+	int ret;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(struct zsock_mmsghdr)));
+
+	if (vlen == 0) {
+		return 0;
+	}
+
+	msgvec_copy = z_user_alloc_from_copy(msgvec,
+					vlen * sizeof(struct zsock_mmsghdr));
+	if (msgvec_copy == NULL) {
+		errno = ENOMEM;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		zsock_msghdr_from_user(&msgvec_copy[i].msg_hdr,
+				       &msgvec[i].msg_hdr, false);
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, msgvec_copy, vlen, flags);
+
+	for (i = 0; ret > 0 && i < (unsigned int)ret; i++) {
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len,
+				      &msgvec_copy[i].msg_len,
+				      sizeof(msgvec[i].msg_len)));
+	}
+
+	for (i = 0; i < vlen; i++) {
+		k_free(msgvec_copy[i].msg_hdr.msg_iov);
+	}
+
+	k_free(msgvec_copy);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_ZERO_COPY)
+static struct net_context *zsock_zc_get_ctx(int sock, struct k_mutex **lock)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+
+	ctx = get_sock_vtable(sock, &vtable, lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	/* Only the native sockets queue net_pkt's that can be handed over */
+	if (vtable != &sock_fd_op_vtable) {
+		errno = EOPNOTSUPP;
+		return NULL;
+	}
+
+	return ctx;
+}
+
+/* Drop the headers in front of the packet data without copying anything */
+static struct net_buf *zsock_zc_strip(struct net_buf *buf, size_t len)
+{
+	while (buf && len > 0) {
+		if (buf->len > len) {
+			net_buf_pull(buf, len);
+			break;
+		}
+
+		len -= buf->len;
+		buf = net_buf_frag_del(NULL, buf);
+	}
+
+	return buf;
+}
+
+static ssize_t zsock_recv_zc_ctx(struct net_context *ctx,
+				 struct net_buf **frags, int flags,
+				 struct sockaddr *src_addr,
+				 socklen_t *addrlen)
+{
+	enum net_sock_type sock_type = net_context_get_type(ctx);
+	k_timeout_t timeout = K_FOREVER;
+	struct net_pkt *pkt;
+	size_t recv_len;
+	int ret;
+
+	*frags = NULL;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (sock_type == SOCK_STREAM) {
+		if (!net_context_is_used(ctx)) {
+			errno = EBADF;
+			return -1;
+		}
+
+		if (net_context_get_state(ctx) != NET_CONTEXT_CONNECTED) {
+			errno = ENOTCONN;
+			return -1;
+		}
+
+		if (sock_is_eof(ctx)) {
+			return 0;
+		}
+	}
+
+	if (!(flags & ZSOCK_MSG_DONTWAIT) && !sock_is_nonblock(ctx)) {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, K_NO_WAIT);
+	if (!pkt) {
+		if (sock_type == SOCK_STREAM && sock_is_eof(ctx)) {
+			return 0;
+		}
+
+		errno = EAGAIN;
+		return -1;
+	}
+
+	if (sock_type == SOCK_DGRAM && src_addr && addrlen) {
+		ret = sock_get_pkt_src_addr(pkt, net_context_get_ip_proto(ctx),
+					    src_addr, *addrlen);
+		if (ret < 0) {
+			errno = -ret;
+			goto fail;
+		}
+
+		if (src_addr->sa_family == AF_INET) {
+			*addrlen = sizeof(struct sockaddr_in);
+		} else if (src_addr->sa_family == AF_INET6) {
+			*addrlen = sizeof(struct sockaddr_in6);
+		} else {
+			errno = ENOTSUP;
+			goto fail;
+		}
+	}
+
+	/* The cursor points to the start of the application data */
+	recv_len = net_pkt_remaining_data(pkt);
+
+	*frags = zsock_zc_strip(pkt->buffer, net_pkt_get_len(pkt) - recv_len);
+	pkt->buffer = NULL;
+
+	if (sock_type == SOCK_STREAM) {
+		if (net_pkt_eof(pkt)) {
+			sock_set_eof(ctx);
+		}
+
+		net_context_update_recv_wnd(ctx, recv_len);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	net_pkt_trace_done(pkt, false);
+	net_pkt_unref(pkt);
+
+	return recv_len;
+
+fail:
+	net_pkt_unref(pkt);
+
+	return -1;
+}
+
+ssize_t zsock_recvfrom_zc(int sock, struct net_buf **frags, int flags,
+			  struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zsock_zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_recv_zc_ctx(ctx, frags, flags, src_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+void zsock_recv_zc_release(struct net_buf *frags)
+{
+	if (frags) {
+		net_buf_unref(frags);
+	}
+}
+
+static ssize_t zsock_send_zc_ctx(struct net_context *ctx,
+				 struct net_buf *frags, int flags,
+				 const struct sockaddr *dest_addr,
+				 socklen_t addrlen)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint64_t buf_timeout = 0;
+	int status;
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_clock_timeout_end_calc(MAX_WAIT_BUFS);
+	}
+
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		return -1;
+	}
+
+	while (1) {
+		status = net_context_sendto_buf(ctx, frags, dest_addr, addrlen,
+						NULL, timeout, ctx->user_data);
+		if (status >= 0) {
+			break;
+		}
+
+		/* The buffers are still ours on failure, so retry like
+		 * zsock_sendto_ctx() does.
+		 */
+		if (((status == -ENOBUFS) || (status == -EAGAIN)) &&
+		    K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = buf_timeout - sys_clock_tick_get();
+
+			if (remaining <= 0) {
+				if (status == -ENOBUFS) {
+					errno = ENOMEM;
+				} else {
+					errno = ENOBUFS;
+				}
+
+				return -1;
+			}
+
+			k_sleep(WAIT_BUFS);
+			continue;
+		}
+
+		errno = -status;
+		return -1;
+	}
+
+	return status;
+}
+
+ssize_t zsock_sendto_zc(int sock, struct net_buf *frags, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	ssize_t ret;
+
+	if (frags == NULL) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zsock_zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = zsock_send_zc_ctx(ctx, frags, flags, dest_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+#endif /* CONFIG_NET_SOCKETS_ZERO_COPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1802,6 +2522,20 @@ int z_vrfy_zsock_getsockopt(int sock, int level, int optname,
 #include <syscalls/zsock_getsockopt_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* Enable or disable an ancillary message returned by recvmsg() */
+static int sock_set_cmsg_flag(struct net_context *ctx, uintptr_t flag,
+			      const void *optval, socklen_t optlen)
+{
+	if (optval == NULL || optlen != sizeof(int)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	sock_set_flag(ctx, flag, *(const int *)optval ? flag : 0);
+
+	return 0;
+}
+
 int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 const void *optval, socklen_t optlen)
 {
@@ -1969,10 +2703,30 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			return 0;
 		}
 
+		case SO_TIMESTAMP:
+			if (IS_ENABLED(CONFIG_NET_PKT_TIMESTAMP)) {
+				return sock_set_cmsg_flag(ctx, SOCK_TIMESTAMP,
+							  optval, optlen);
+			}
+
+			break;
 		}
 
 		break;
 
+	case IPPROTO_IP:
+		switch (optname) {
+		case IP_PKTINFO:
+			if (IS_ENABLED(CONFIG_NET_IPV4) &&
+			    net_context_get_family(ctx) == AF_INET) {
+				return sock_set_cmsg_flag(ctx, SOCK_PKTINFO,
+							  optval, optlen);
+			}
+
+			break;
+		}
+		break;
+
 	case IPPROTO_TCP:
 		switch (optname) {
 		case TCP_NODELAY:
@@ -1990,6 +2744,15 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			 * existing apps.
 			 */
 			return 0;
+
+		case IPV6_RECVPKTINFO:
+			if (IS_ENABLED(CONFIG_NET_IPV6) &&
+			    net_context_get_family(ctx) == AF_INET6) {
+				return sock_set_cmsg_flag(ctx, SOCK_PKTINFO,
+							  optval, optlen);
+			}
+
+			break;
 		}
 		break;
 	}
@@ -2219,6 +2982,11 @@ static ssize_t sock_sendmsg_vmeth(void *obj, const struct msghdr *msg,
 	return zsock_sendmsg_ctx(obj, msg, flags);
 }
 
+static ssize_t sock_recvmsg_vmeth(void *obj, struct msghdr *msg, int flags)
+{
+	return zsock_recvmsg_ctx(obj, msg, flags);
+}
+
 static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				   int flags, struct sockaddr *src_addr,
 				   socklen_t *addrlen)
@@ -2265,6 +3033,7 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.sendto = sock_sendto_vmeth,
 	.sendmsg = sock_sendmsg_vmeth,
 	.recvfrom = sock_recvfrom_vmeth,
+	.recvmsg = sock_recvmsg_vmeth,
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
 	.getsockname = sock_getsockname_vmeth,
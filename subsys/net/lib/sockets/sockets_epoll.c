@@ -0,0 +1,628 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* epoll-style readiness on top of the ZFD_IOCTL_POLL_* hooks of the file
+ * descriptors. Instead of preparing every file descriptor for each wait
+ * like poll() does, the kernel objects returned by ZFD_IOCTL_POLL_PREPARE
+ * are kept in a k_poll_set, and a wait only polls the file descriptors
+ * whose objects were signaled, plus the ones reported ready last time.
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_sock_epoll, CONFIG_NET_SOCKETS_LOG_LEVEL);
+
+#include <kernel.h>
+#include <syscall_handler.h>
+#include <sys/fdtable.h>
+#include <net/net_context.h>
+#include <net/socket.h>
+#include "sockets_internal.h"
+
+/* Objects one file descriptor can register, for reading and writing */
+#define EPOLL_ITEM_MAX_OBJS 2
+
+/* Signaled objects collected from the poll set at a time */
+#define EPOLL_WAIT_BATCH 8
+
+#define EPOLL_POLL_EVENTS (ZSOCK_EPOLLIN | ZSOCK_EPOLLOUT)
+#define EPOLL_ALWAYS_EVENTS (ZSOCK_EPOLLERR | ZSOCK_EPOLLHUP)
+
+struct epoll_item {
+	/* Linked on the check list while the item has to be polled */
+	sys_dnode_t check_node;
+	zsock_epoll_data_t data;
+	uint32_t events;
+	int fd;
+	void *objs[EPOLL_ITEM_MAX_OBJS];
+	uint8_t num_objs;
+};
+
+struct epoll_instance {
+	struct k_mutex lock;
+	struct k_poll_set set;
+	struct z_poll_set_entry entries[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS *
+					EPOLL_ITEM_MAX_OBJS];
+	struct epoll_item items[CONFIG_NET_SOCKETS_EPOLL_MAX_FDS];
+	sys_dlist_t check;
+	bool in_use;
+};
+
+static struct epoll_instance epoll_instances[CONFIG_NET_SOCKETS_EPOLL_MAX];
+static K_MUTEX_DEFINE(epoll_lock);
+
+/* Number of epoll instances watching each file descriptor, so closing a
+ * file descriptor nobody watches does not have to lock the instances.
+ */
+static atomic_t epoll_watchers[CONFIG_POSIX_MAX_FDS];
+
+static const struct fd_op_vtable epoll_fd_op_vtable;
+
+static struct epoll_item *epoll_find(struct epoll_instance *ep, int fd)
+{
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		if (ep->items[i].fd == fd) {
+			return &ep->items[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void epoll_item_unregister(struct epoll_instance *ep,
+				  struct epoll_item *item)
+{
+	for (int i = 0; i < item->num_objs; i++) {
+		(void)k_poll_set_remove(&ep->set, item->objs[i]);
+	}
+
+	item->num_objs = 0U;
+}
+
+/* Make the poll set registrations of the item match the events prepared
+ * by its file descriptor. These only change when the item is modified,
+ * or for a DTLS client once the handshake completes.
+ */
+static int epoll_item_register(struct epoll_instance *ep,
+			       struct epoll_item *item,
+			       struct k_poll_event *evs, int num)
+{
+	uint32_t edge = (item->events & ZSOCK_EPOLLET) ? K_POLL_SET_EDGE : 0U;
+	uint8_t tag = item - ep->items;
+	int ret;
+
+	if (num == item->num_objs) {
+		int i;
+
+		for (i = 0; i < num; i++) {
+			if (evs[i].obj != item->objs[i]) {
+				break;
+			}
+		}
+
+		if (i == num) {
+			return 0;
+		}
+	}
+
+	epoll_item_unregister(ep, item);
+
+	for (int i = 0; i < num; i++) {
+		ret = k_poll_set_add(&ep->set, evs[i].type | edge, evs[i].obj,
+				     tag);
+		if (ret < 0) {
+			epoll_item_unregister(ep, item);
+			return ret;
+		}
+
+		item->objs[item->num_objs++] = evs[i].obj;
+	}
+
+	return 0;
+}
+
+/* Poll the file descriptor of the item like poll() does, keeping its poll
+ * set registrations in sync. Returns the ready events, or a negative error
+ * code if the file descriptor cannot be watched.
+ */
+static int epoll_item_poll(struct epoll_instance *ep, struct epoll_item *item)
+{
+	struct k_poll_event evs[EPOLL_ITEM_MAX_OBJS];
+	const struct fd_op_vtable *vtable;
+	struct zsock_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->events & EPOLL_POLL_EVENTS,
+	};
+	struct k_poll_event *pev;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = z_get_fd_obj_and_vtable(item->fd, &vtable, &lock);
+	if (obj == NULL) {
+		return -EBADF;
+	}
+
+	/* Nested epoll instances are not supported */
+	if (vtable == &epoll_fd_op_vtable) {
+		return -EINVAL;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	do {
+		pfd.revents = 0;
+		pev = evs;
+
+		ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_PREPARE,
+					   &pfd, &pev, evs + ARRAY_SIZE(evs));
+		if (ret == -EXDEV) {
+			/* Offloaded sockets have no kernel objects to watch */
+			ret = -EOPNOTSUPP;
+			break;
+		} else if (ret < 0 && ret != -EALREADY) {
+			break;
+		}
+
+		ret = epoll_item_register(ep, item, evs, pev - evs);
+		if (ret < 0) {
+			break;
+		}
+
+		if (pev != evs) {
+			(void)k_poll(evs, pev - evs, K_NO_WAIT);
+		}
+
+		/* -EAGAIN asks for the events to be prepared again */
+		pev = evs;
+		ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE,
+					   &pfd, &pev);
+	} while (ret == -EAGAIN);
+
+	k_mutex_unlock(lock);
+
+	if (ret < 0) {
+		return ret;
+	}
+
+	return pfd.revents & (item->events | EPOLL_ALWAYS_EVENTS);
+}
+
+/* Register the item and queue it for the next wait if already ready */
+static int epoll_item_start(struct epoll_instance *ep, struct epoll_item *item)
+{
+	int revents;
+
+	revents = epoll_item_poll(ep, item);
+	if (revents < 0) {
+		epoll_item_unregister(ep, item);
+		return revents;
+	}
+
+	if (revents != 0) {
+		sys_dlist_append(&ep->check, &item->check_node);
+	}
+
+	return 0;
+}
+
+static void epoll_item_stop(struct epoll_instance *ep, struct epoll_item *item)
+{
+	epoll_item_unregister(ep, item);
+
+	if (sys_dnode_is_linked(&item->check_node)) {
+		sys_dlist_remove(&item->check_node);
+	}
+}
+
+static void epoll_item_remove(struct epoll_instance *ep,
+			      struct epoll_item *item)
+{
+	epoll_item_stop(ep, item);
+	atomic_dec(&epoll_watchers[item->fd]);
+	item->fd = -1;
+}
+
+/* Queue the items of the signaled objects for polling */
+static void epoll_mark(struct epoll_instance *ep, struct k_poll_event *ready,
+		       int num)
+{
+	for (int i = 0; i < num; i++) {
+		struct epoll_item *item = &ep->items[ready[i].tag];
+
+		if (item->fd >= 0 && !sys_dnode_is_linked(&item->check_node)) {
+			sys_dlist_append(&ep->check, &item->check_node);
+		}
+	}
+}
+
+/* Poll the queued items. Level triggered items stay queued while they are
+ * ready, as not all readiness is signaled through kernel objects (e.g.
+ * sockets are always writable), and are moved to the tail so a small
+ * maxevents doesn't starve the others.
+ */
+static int epoll_collect(struct epoll_instance *ep,
+			 struct zsock_epoll_event *events, int maxevents)
+{
+	struct epoll_item *item, *next;
+	sys_dlist_t reported;
+	sys_dnode_t *node;
+	int count = 0;
+
+	sys_dlist_init(&reported);
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&ep->check, item, next, check_node) {
+		int revents;
+
+		if (count == maxevents) {
+			break;
+		}
+
+		revents = epoll_item_poll(ep, item);
+		if (revents < 0) {
+			NET_DBG("fd %d poll failed (%d)", item->fd, revents);
+			revents = ZSOCK_EPOLLERR;
+		}
+
+		sys_dlist_remove(&item->check_node);
+
+		if (revents == 0) {
+			continue;
+		}
+
+		if (!(item->events & ZSOCK_EPOLLET)) {
+			sys_dlist_append(&reported, &item->check_node);
+		}
+
+		events[count].events = revents;
+		events[count].data = item->data;
+		count++;
+	}
+
+	while ((node = sys_dlist_get(&reported)) != NULL) {
+		sys_dlist_append(&ep->check, node);
+	}
+
+	return count;
+}
+
+void z_epoll_fd_close(int fd)
+{
+	if (fd < 0 || fd >= ARRAY_SIZE(epoll_watchers) ||
+	    atomic_get(&epoll_watchers[fd]) == 0) {
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		struct epoll_instance *ep = &epoll_instances[i];
+		struct epoll_item *item;
+
+		if (!ep->in_use) {
+			continue;
+		}
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+		item = epoll_find(ep, fd);
+		if (item != NULL) {
+			epoll_item_remove(ep, item);
+		}
+
+		k_mutex_unlock(&ep->lock);
+	}
+}
+
+int z_impl_zsock_epoll_create(int flags)
+{
+	struct epoll_instance *ep = NULL;
+	int fd;
+
+	if (flags != 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_instances); i++) {
+		if (!epoll_instances[i].in_use) {
+			ep = &epoll_instances[i];
+			ep->in_use = true;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&epoll_lock);
+
+	if (ep == NULL) {
+		z_free_fd(fd);
+		errno = ENOMEM;
+		return -1;
+	}
+
+	k_mutex_init(&ep->lock);
+	k_poll_set_init(&ep->set, ep->entries, ARRAY_SIZE(ep->entries));
+	sys_dlist_init(&ep->check);
+
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		ep->items[i].fd = -1;
+		ep->items[i].num_objs = 0U;
+		sys_dnode_init(&ep->items[i].check_node);
+	}
+
+	z_finalize_fd(fd, ep, &epoll_fd_op_vtable);
+
+	NET_DBG("epoll %p created, fd=%d", ep, fd);
+
+	return fd;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_create(int flags)
+{
+	return z_impl_zsock_epoll_create(flags);
+}
+#include <syscalls/zsock_epoll_create_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_ctl(int epfd, int op, int fd,
+			   struct zsock_epoll_event *event)
+{
+	struct epoll_instance *ep;
+	struct epoll_item *item;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd < 0 || fd >= ARRAY_SIZE(epoll_watchers)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (fd == epfd || (op != ZSOCK_EPOLL_CTL_DEL && event == NULL)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	item = epoll_find(ep, fd);
+
+	switch (op) {
+	case ZSOCK_EPOLL_CTL_ADD:
+		if (item != NULL) {
+			ret = -EEXIST;
+			break;
+		}
+
+		item = epoll_find(ep, -1);
+		if (item == NULL) {
+			ret = -ENOSPC;
+			break;
+		}
+
+		item->fd = fd;
+		item->events = event->events;
+		item->data = event->data;
+
+		ret = epoll_item_start(ep, item);
+		if (ret < 0) {
+			item->fd = -1;
+			break;
+		}
+
+		atomic_inc(&epoll_watchers[fd]);
+		break;
+
+	case ZSOCK_EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_stop(ep, item);
+		item->events = event->events;
+		item->data = event->data;
+
+		ret = epoll_item_start(ep, item);
+		if (ret < 0) {
+			epoll_item_remove(ep, item);
+		}
+
+		break;
+
+	case ZSOCK_EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		epoll_item_remove(ep, item);
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	if (ret < 0) {
+		errno = -ret;
+		return -1;
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_ctl(int epfd, int op, int fd,
+					 struct zsock_epoll_event *event)
+{
+	struct zsock_epoll_event event_copy;
+
+	if (event != NULL) {
+		Z_OOPS(z_user_from_copy(&event_copy, (void *)event,
+					sizeof(event_copy)));
+		event = &event_copy;
+	}
+
+	return z_impl_zsock_epoll_ctl(epfd, op, fd, event);
+}
+#include <syscalls/zsock_epoll_ctl_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+int z_impl_zsock_epoll_wait(int epfd, struct zsock_epoll_event *events,
+			    int maxevents, int timeout)
+{
+	struct k_poll_event ready[EPOLL_WAIT_BATCH];
+	struct epoll_instance *ep;
+	k_timeout_t wait = K_NO_WAIT;
+	k_timeout_t ktimeout;
+	uint64_t end;
+	int ret;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_op_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (timeout < 0) {
+		ktimeout = K_FOREVER;
+	} else {
+		ktimeout = K_MSEC(timeout);
+	}
+
+	end = sys_clock_timeout_end_calc(ktimeout);
+
+	/* The first round only polls the items queued by previous waits and
+	 * the ones of already signaled objects, the next ones wait for new
+	 * signals.
+	 */
+	for (;;) {
+		ret = k_poll_set_wait(&ep->set, ready, ARRAY_SIZE(ready), wait);
+		if (ret < 0 && ret != -EAGAIN) {
+			errno = -ret;
+			return -1;
+		}
+
+		(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+		if (ret > 0) {
+			epoll_mark(ep, ready, ret);
+		}
+
+		ret = epoll_collect(ep, events, maxevents);
+
+		k_mutex_unlock(&ep->lock);
+
+		if (ret > 0 || K_TIMEOUT_EQ(ktimeout, K_NO_WAIT)) {
+			return ret;
+		}
+
+		if (K_TIMEOUT_EQ(ktimeout, K_FOREVER)) {
+			wait = K_FOREVER;
+		} else {
+			int64_t left = (int64_t)(end - sys_clock_tick_get());
+
+			if (left <= 0) {
+				return 0;
+			}
+
+			wait = K_TICKS(left);
+		}
+	}
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_epoll_wait(int epfd,
+					  struct zsock_epoll_event *events,
+					  int maxevents, int timeout)
+{
+	if (maxevents > 0) {
+		Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(events, maxevents,
+					sizeof(struct zsock_epoll_event)));
+	}
+
+	return z_impl_zsock_epoll_wait(epfd, events, maxevents, timeout);
+}
+#include <syscalls/zsock_epoll_wait_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+static ssize_t epoll_read_vmeth(void *obj, void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_vmeth(void *obj, const void *buffer, size_t count)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buffer);
+	ARG_UNUSED(count);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_close_vmeth(void *obj)
+{
+	struct epoll_instance *ep = obj;
+
+	(void)k_mutex_lock(&ep->lock, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(ep->items); i++) {
+		if (ep->items[i].fd >= 0) {
+			epoll_item_remove(ep, &ep->items[i]);
+		}
+	}
+
+	k_mutex_unlock(&ep->lock);
+
+	(void)k_mutex_lock(&epoll_lock, K_FOREVER);
+	ep->in_use = false;
+	k_mutex_unlock(&epoll_lock);
+
+	return 0;
+}
+
+static int epoll_ioctl_vmeth(void *obj, unsigned int request, va_list args)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(args);
+
+	switch (request) {
+	case ZFD_IOCTL_SET_LOCK:
+		return 0;
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_op_vtable = {
+	.read = epoll_read_vmeth,
+	.write = epoll_write_vmeth,
+	.close = epoll_close_vmeth,
+	.ioctl = epoll_ioctl_vmeth,
+};
@@ -11,6 +11,8 @@
 
 #define SOCK_EOF 1
 #define SOCK_NONBLOCK 2
+#define SOCK_PKTINFO 4
+#define SOCK_TIMESTAMP 8
 
 int zsock_close_ctx(struct net_context *ctx);
 int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout);
@@ -66,6 +68,7 @@ struct socket_op_vtable {
 	int (*setsockopt)(void *obj, int level, int optname,
 			  const void *optval, socklen_t optlen);
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
+	ssize_t (*recvmsg)(void *obj, struct msghdr *msg, int flags);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
 };
@@ -250,6 +250,7 @@ ssize_t zpacket_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	}
 
 	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_trace_done(pkt, false);
 		net_pkt_unref(pkt);
 	} else {
 		net_pkt_cursor_init(pkt);
@@ -61,6 +61,7 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	size_t unused;
 	size_t size = thread->stack_info.size;
 	const char *tname;
+	int64_t timeout;
 	int ret;
 
 #ifdef CONFIG_THREAD_RUNTIME_STATS
@@ -74,11 +75,21 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 		      (thread == k_current_get()) ? "*" : " ",
 		      thread,
 		      tname ? tname : "NA");
+
+#ifdef CONFIG_SYS_CLOCK_EXISTS
+	/* dticks is a delta with the list timeout queue but an absolute
+	 * tick with the timing wheel, so print the ticks left instead.
+	 */
+	timeout = k_thread_timeout_remaining_ticks(thread);
+#else
+	timeout = thread->base.timeout.dticks;
+#endif
+
 	/* Cannot use lld as it's less portable. */
 	shell_print(shell, "\toptions: 0x%x, priority: %d timeout: %" PRId64,
 		      thread->base.user_options,
 		      thread->base.prio,
-		      (int64_t)thread->base.timeout.dticks);
+		      timeout);
 	shell_print(shell, "\tstate: %s, entry: %p", k_thread_state_str(thread),
 		    thread->entry.pEntry);
 
@@ -9,6 +9,10 @@
 #include <kernel_internal.h>
 #include <ctf_top.h>
 
+#if defined(CONFIG_NET_PKT_LATENCY_TRACE)
+#include <net/net_pkt.h>
+#endif
+
 
 static void _get_thread_name(struct k_thread *thread,
 			     ctf_bounded_string_t *name)
@@ -295,3 +299,30 @@ void sys_trace_k_timer_status_sync_blocking(struct k_timer *timer)
 void sys_trace_k_timer_status_sync_exit(struct k_timer *timer, uint32_t result)
 {
 }
+
+#if defined(CONFIG_NET_PKT_LATENCY_TRACE)
+BUILD_ASSERT(CTF_NET_PKT_STAGES == NET_PKT_TRACE_STAGES);
+
+void sys_trace_net_pkt_latency(const struct net_pkt_trace_record *rec)
+{
+	ctf_net_pkt_stages_t stages;
+	uint32_t hw_sec = 0U, hw_nsec = 0U;
+
+	memcpy(stages.ns, rec->stage_ns, sizeof(stages.ns));
+
+#if defined(CONFIG_NET_PKT_TIMESTAMP)
+	hw_sec = (uint32_t)rec->timestamp.second;
+	hw_nsec = rec->timestamp.nanosecond;
+#endif
+
+	ctf_top_net_pkt_latency(
+		(uint32_t)rec->pkt,
+		(uint8_t)rec->tx,
+		rec->total_ns,
+		stages,
+		(uint8_t)rec->has_timestamp,
+		hw_sec,
+		hw_nsec
+		);
+}
+#endif /* CONFIG_NET_PKT_LATENCY_TRACE */
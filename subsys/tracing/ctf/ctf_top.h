@@ -97,12 +97,20 @@ typedef enum {
 	CTF_EVENT_MUTEX_LOCK_EXIT = 0x2B,
 	CTF_EVENT_MUTEX_UNLOCK_ENTER = 0x2C,
 	CTF_EVENT_MUTEX_UNLOCK_EXIT = 0x2D,
+	CTF_EVENT_NET_PKT_LATENCY = 0x2E,
 } ctf_event_t;
 
 typedef struct {
 	char buf[CTF_MAX_STRING_LEN];
 } ctf_bounded_string_t;
 
+/* Same as the number of network packet trace stages */
+#define CTF_NET_PKT_STAGES 6
+
+typedef struct {
+	uint32_t ns[CTF_NET_PKT_STAGES];
+} ctf_net_pkt_stages_t;
+
 static inline void ctf_top_thread_switched_out(uint32_t thread_id,
 					       ctf_bounded_string_t name)
 {
@@ -290,4 +298,15 @@ static inline void ctf_top_mutex_unlock_exit(uint32_t mutex_id, int32_t ret)
 	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_MUTEX_UNLOCK_EXIT), mutex_id);
 }
 
+/* Network packet */
+static inline void ctf_top_net_pkt_latency(uint32_t pkt_id, uint8_t tx,
+					   uint32_t total_ns,
+					   ctf_net_pkt_stages_t stages,
+					   uint8_t has_timestamp,
+					   uint32_t hw_sec, uint32_t hw_nsec)
+{
+	CTF_EVENT(CTF_LITERAL(uint8_t, CTF_EVENT_NET_PKT_LATENCY), pkt_id, tx,
+		  total_ns, stages, has_timestamp, hw_sec, hw_nsec);
+}
+
 #endif /* SUBSYS_DEBUG_TRACING_CTF_TOP_H */
@@ -339,6 +339,8 @@ extern "C" {
 #define sys_port_trace_pm_device_runtime_disable_enter(dev)
 #define sys_port_trace_pm_device_runtime_disable_exit(dev, ret)
 
+#define sys_port_trace_net_pkt_latency(rec) sys_trace_net_pkt_latency(rec)
+
 void sys_trace_idle(void);
 void sys_trace_isr_enter(void);
 void sys_trace_isr_exit(void);
@@ -426,6 +428,9 @@ void sys_trace_k_timer_status_sync_exit(struct k_timer *timer, uint32_t result);
 
 void sys_trace_k_event_init(struct k_event *event);
 
+struct net_pkt_trace_record;
+void sys_trace_net_pkt_latency(const struct net_pkt_trace_record *rec);
+
 #ifdef __cplusplus
 }
 #endif
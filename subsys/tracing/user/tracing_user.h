@@ -320,6 +320,8 @@ void sys_trace_idle(void);
 #define sys_port_trace_pm_device_runtime_disable_enter(dev)
 #define sys_port_trace_pm_device_runtime_disable_exit(dev, ret)
 
+#define sys_port_trace_net_pkt_latency(rec)
+
 #ifdef __cplusplus
 }
 #endif
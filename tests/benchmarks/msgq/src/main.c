@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* This is a message queue contention benchmark.  For 1..MP_NUM_CPUS
+ * threads it has every thread hammer the same queue with
+ * non-blocking put/get pairs for RUN_MS and reports how many pairs
+ * all threads completed in total.
+ */
+
+#define RUN_MS 1000
+#define QUEUE_LEN 64
+
+struct record {
+	uint32_t src;
+	uint32_t seq;
+	uint32_t data[2];
+};
+
+K_MSGQ_DEFINE(bench_q, sizeof(struct record), QUEUE_LEN, 4);
+
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, 1024);
+static uint32_t counts[CONFIG_MP_NUM_CPUS];
+static atomic_t stop;
+
+static void worker(void *arg1, void *arg2, void *arg3)
+{
+	uint32_t id = POINTER_TO_UINT(arg1);
+	struct record in, out = { .src = id };
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!atomic_get(&stop)) {
+		out.seq++;
+		if (k_msgq_put(&bench_q, &out, K_NO_WAIT) == 0 &&
+		    k_msgq_get(&bench_q, &in, K_NO_WAIT) == 0) {
+			counts[id]++;
+		}
+	}
+}
+
+void main(void)
+{
+	/* Below main, so main always gets a CPU back to stop the run */
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	printk("msgq path: %s\n",
+	       IS_ENABLED(CONFIG_MSGQ_LOCKLESS) ? "lockless" : "locked");
+
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		uint32_t tot = 0U;
+
+		k_msgq_purge(&bench_q);
+		atomic_clear(&stop);
+
+		for (int i = 0; i < n; i++) {
+			counts[i] = 0U;
+			k_thread_create(&threads[i], stacks[i],
+					K_THREAD_STACK_SIZEOF(stacks[i]),
+					worker, UINT_TO_POINTER(i), NULL, NULL,
+					prio, 0, K_NO_WAIT);
+		}
+
+		k_sleep(K_MSEC(RUN_MS));
+
+		/* Let workers finish their current operation rather than
+		 * aborting one halfway through a put or get
+		 */
+		atomic_set(&stop, 1);
+		for (int i = 0; i < n; i++) {
+			k_thread_join(&threads[i], K_FOREVER);
+			tot += counts[i];
+		}
+
+		printk("threads %d ops %u (%u per thread)\n",
+		       n, tot, tot / n);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* This is a mutex contention benchmark.  For 1..MP_NUM_CPUS threads
+ * it has every thread take the same mutex around a short critical
+ * section for RUN_MS and reports how many lock/unlock pairs all
+ * threads completed in total.
+ */
+
+#define RUN_MS 1000
+
+/* Iterations of busy work inside and outside the critical section */
+#define CS_LOOPS 16
+#define OUTSIDE_LOOPS 64
+
+K_MUTEX_DEFINE(bench_mutex);
+
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, 1024);
+static uint32_t counts[CONFIG_MP_NUM_CPUS];
+static volatile uint32_t shared;
+static atomic_t stop;
+
+static void busy(int loops)
+{
+	for (volatile int i = 0; i < loops; i++) {
+	}
+}
+
+static void worker(void *arg1, void *arg2, void *arg3)
+{
+	uint32_t id = POINTER_TO_UINT(arg1);
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!atomic_get(&stop)) {
+		k_mutex_lock(&bench_mutex, K_FOREVER);
+		shared++;
+		busy(CS_LOOPS);
+		k_mutex_unlock(&bench_mutex);
+
+		counts[id]++;
+		busy(OUTSIDE_LOOPS);
+	}
+}
+
+void main(void)
+{
+	/* Below main, so main always gets a CPU back to stop the run */
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	printk("mutex adaptive spin: %s\n",
+	       IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "on" : "off");
+
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		uint32_t tot = 0U;
+
+		shared = 0U;
+		atomic_clear(&stop);
+
+		for (int i = 0; i < n; i++) {
+			counts[i] = 0U;
+			k_thread_create(&threads[i], stacks[i],
+					K_THREAD_STACK_SIZEOF(stacks[i]),
+					worker, UINT_TO_POINTER(i), NULL, NULL,
+					prio, 0, K_NO_WAIT);
+		}
+
+		k_sleep(K_MSEC(RUN_MS));
+
+		/* Let workers leave the critical section rather than
+		 * aborting one while it holds the mutex
+		 */
+		atomic_set(&stop, 1);
+		for (int i = 0; i < n; i++) {
+			k_thread_join(&threads[i], K_FOREVER);
+			tot += counts[i];
+		}
+
+		/* Stop without printing "fin" so the harness fails */
+		if (shared != tot) {
+			printk("mutual exclusion broken: %u != %u\n",
+			       shared, tot);
+			return;
+		}
+
+		printk("threads %d ops %u (%u per thread)\n",
+		       n, tot, tot / n);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_ip.h>
+
+#include "net_private.h"
+
+/* This is a microbenchmark of the Internet checksum. Every buffer length
+ * is summed many times with the stack checksum and with a word by word
+ * reference loop, and the average time per buffer is printed for both.
+ * The results are also compared, so a wrong optimization does not go
+ * unnoticed.
+ */
+
+#define N_ROUNDS 2000
+#define N_UPDATES 100000
+#define MAX_LEN 1500
+
+static const size_t lengths[] = { 20, 64, 128, 256, 512, 1024, MAX_LEN };
+
+static uint8_t buf[MAX_LEN + 1] __aligned(4);
+
+/* The byte pair loop the stack used before */
+static uint16_t ref_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	const uint8_t *end = data + len - 1;
+	uint16_t tmp;
+
+	while (data < end) {
+		tmp = (data[0] << 8) + data[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		data += 2;
+	}
+
+	if (data == end) {
+		tmp = data[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+static uint32_t run(uint16_t (*fn)(uint16_t, const uint8_t *, size_t),
+		    const uint8_t *data, size_t len, uint16_t *sum)
+{
+	uint32_t t0, t1;
+
+	t0 = k_cycle_get_32();
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		*sum = fn(*sum, data, len);
+	}
+
+	t1 = k_cycle_get_32();
+
+	return k_cyc_to_ns_floor64(t1 - t0) / N_ROUNDS;
+}
+
+static bool bench_len(size_t len, int align)
+{
+	uint16_t ref_sum = 0U;
+	uint16_t sum = 0U;
+	uint32_t ref_ns, ns;
+
+	ref_ns = run(ref_chksum, buf + align, len, &ref_sum);
+	ns = run(net_calc_chksum_data, buf + align, len, &sum);
+
+	printk("len %4zd align %d %6u ns %6u ns\n", len, align, ref_ns, ns);
+
+	/* 0x0000 and 0xffff are both a zero in one's complement */
+	if (sum % 0xffff != ref_sum % 0xffff) {
+		printk("checksum mismatch 0x%04x 0x%04x\n", sum, ref_sum);
+		return false;
+	}
+
+	return true;
+}
+
+static uint16_t hdr_chksum(struct net_ipv4_hdr *hdr)
+{
+	uint16_t sum;
+
+	hdr->chksum = 0U;
+	sum = ref_chksum(0U, (uint8_t *)hdr, sizeof(*hdr));
+
+	return ~htons(sum);
+}
+
+static bool bench_update(void)
+{
+	struct net_ipv4_hdr hdr = { 0 };
+	uint32_t t0, t1, t2;
+	uint16_t chksum;
+
+	t0 = k_cycle_get_32();
+
+	for (int i = 0; i < N_UPDATES; i++) {
+		hdr.ttl = i;
+		hdr.chksum = hdr_chksum(&hdr);
+	}
+
+	t1 = k_cycle_get_32();
+
+	for (int i = 0; i < N_UPDATES; i++) {
+		uint16_t old_val = UNALIGNED_GET((uint16_t *)&hdr.ttl);
+
+		hdr.ttl = i;
+		hdr.chksum = net_chksum_update_16(
+			hdr.chksum, old_val,
+			UNALIGNED_GET((uint16_t *)&hdr.ttl));
+	}
+
+	t2 = k_cycle_get_32();
+
+	printk("update %6u ns %6u ns\n",
+	       (uint32_t)(k_cyc_to_ns_floor64(t1 - t0) / N_UPDATES),
+	       (uint32_t)(k_cyc_to_ns_floor64(t2 - t1) / N_UPDATES));
+
+	chksum = hdr.chksum;
+	if (chksum % 0xffff != hdr_chksum(&hdr) % 0xffff) {
+		printk("update mismatch\n");
+		return false;
+	}
+
+	return true;
+}
+
+void main(void)
+{
+	for (int i = 0; i < sizeof(buf); i++) {
+		buf[i] = i * 7 + 3;
+	}
+
+	printk("             reference    stack\n");
+
+	for (int i = 0; i < ARRAY_SIZE(lengths); i++) {
+		if (!bench_len(lengths[i], 0) || !bench_len(lengths[i], 1)) {
+			return;
+		}
+	}
+
+	if (!bench_update()) {
+		return;
+	}
+
+	printk("fin\n");
+}
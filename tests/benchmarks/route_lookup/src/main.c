@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+#include <net/dummy.h>
+
+#include "net_private.h"
+#include "route.h"
+
+/* This is a microbenchmark of the IPv4 route lookup. Routing tables of
+ * growing size are filled with random prefixes, and the average time to
+ * find the route of a destination is printed for a linear scan over all
+ * the routes and for the longest prefix match trie of the stack. The
+ * results are also compared, so a broken trie does not go unnoticed.
+ */
+
+#define N_LOOKUPS 2000
+
+static const int table_sizes[] = { 16, 64, 256, CONFIG_NET_MAX_IPV4_ROUTES };
+
+static struct net_route_entry_ipv4 *table[CONFIG_NET_MAX_IPV4_ROUTES];
+static int table_len;
+
+static struct in_addr dst[N_LOOKUPS];
+static struct net_route_entry_ipv4 *linear_found[N_LOOKUPS];
+static struct net_route_entry_ipv4 *lpm_found[N_LOOKUPS];
+
+static struct in_addr gw = { { { 192, 0, 2, 1 } } };
+static struct net_if *iface;
+static uint32_t seed = 2463534242U;
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_iface1_bench, "iface1", net_iface_dev_init, NULL, NULL,
+		NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &net_iface_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+/* The same sequence on every run, so the results can be compared */
+static uint32_t xorshift32(void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	return seed;
+}
+
+static inline uint32_t prefix_mask(uint8_t prefix_len)
+{
+	return prefix_len ? ~0U << (32 - prefix_len) : 0U;
+}
+
+/* What a routing table without the trie has to do */
+static struct net_route_entry_ipv4 *linear_lookup(struct in_addr *addr)
+{
+	struct net_route_entry_ipv4 *route = NULL;
+	uint32_t host = ntohl(addr->s_addr);
+
+	for (int i = 0; i < table_len; i++) {
+		uint32_t mask = prefix_mask(table[i]->prefix_len);
+
+		if ((ntohl(table[i]->addr.s_addr) & mask) != (host & mask)) {
+			continue;
+		}
+
+		if (!route || table[i]->prefix_len > route->prefix_len) {
+			route = table[i];
+		}
+	}
+
+	return route;
+}
+
+static bool in_table(struct net_route_entry_ipv4 *route)
+{
+	for (int i = 0; i < table_len; i++) {
+		if (table[i] == route) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool fill_table(int size)
+{
+	struct net_route_entry_ipv4 *route;
+	struct in_addr addr;
+	uint8_t prefix_len;
+
+	while (table_len < size) {
+		prefix_len = 8 + xorshift32() % 25;
+
+		/* Keep the routes in 10.0.0.0/8, so they overlap */
+		addr.s_addr = htonl((10U << 24) |
+				    (xorshift32() & prefix_mask(prefix_len) &
+				     0x00ffffffU));
+
+		route = net_route_ipv4_add(iface, &addr, prefix_len, &gw);
+		if (!route) {
+			printk("route add failed\n");
+			return false;
+		}
+
+		/* The same prefix was drawn twice */
+		if (in_table(route)) {
+			continue;
+		}
+
+		table[table_len++] = route;
+	}
+
+	return true;
+}
+
+static void fill_dst(void)
+{
+	for (int i = 0; i < N_LOOKUPS; i++) {
+		if (i % 2) {
+			/* Somewhere below one of the routes */
+			struct net_route_entry_ipv4 *route =
+				table[xorshift32() % table_len];
+			uint32_t mask = prefix_mask(route->prefix_len);
+
+			dst[i].s_addr = htonl((ntohl(route->addr.s_addr) &
+					       mask) | (xorshift32() & ~mask));
+		} else {
+			dst[i].s_addr = htonl((10U << 24) |
+					      (xorshift32() & 0x00ffffffU));
+		}
+	}
+}
+
+static bool bench_size(int size)
+{
+	uint32_t t0, t1, t2;
+	uint32_t linear_ns, lpm_ns;
+
+	if (!fill_table(size)) {
+		return false;
+	}
+
+	fill_dst();
+
+	t0 = k_cycle_get_32();
+
+	for (int i = 0; i < N_LOOKUPS; i++) {
+		linear_found[i] = linear_lookup(&dst[i]);
+	}
+
+	t1 = k_cycle_get_32();
+
+	for (int i = 0; i < N_LOOKUPS; i++) {
+		lpm_found[i] = net_route_ipv4_lookup(iface, &dst[i]);
+	}
+
+	t2 = k_cycle_get_32();
+
+	linear_ns = k_cyc_to_ns_floor64(t1 - t0) / N_LOOKUPS;
+	lpm_ns = k_cyc_to_ns_floor64(t2 - t1) / N_LOOKUPS;
+
+	printk("routes %4d %6u ns %6u ns\n", table_len, linear_ns, lpm_ns);
+
+	for (int i = 0; i < N_LOOKUPS; i++) {
+		if (lpm_found[i] != linear_found[i]) {
+			printk("route mismatch for %s\n",
+			       net_sprint_ipv4_addr(&dst[i]));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void main(void)
+{
+	iface = net_if_get_default();
+
+	printk("               linear       trie\n");
+
+	for (int i = 0; i < ARRAY_SIZE(table_sizes); i++) {
+		if (!bench_size(table_sizes[i])) {
+			return;
+		}
+	}
+
+	printk("fin\n");
+}
@@ -27,6 +27,18 @@
  * It then iterates this many times, reporting timestamp latencies
  * between each numbered step and for the whole cycle, and a running
  * average for all cycles run.
+ *
+ * On SMP builds it then measures context switch throughput scaling:
+ * for 1..CONFIG_MP_NUM_CPUS pairs of threads ping-ponging on a pair
+ * of semaphores, it reports how many round trips all pairs together
+ * completed in SMP_RUN_MS.  With a scalable scheduler the total
+ * should grow roughly linearly with the number of pairs.
+ *
+ * With CONFIG_BENCHMARK_WAITQ_WAITERS it also measures how the wait
+ * queue backend scales: the same unpend/ready/switch/pend cycle is
+ * repeated against a wait queue that already holds 1, 2, 4... other
+ * pended threads, all of higher priority than the partner, so the
+ * partner always pends behind them.
  */
 
 #define N_RUNS 1000
@@ -86,6 +98,150 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+#ifdef CONFIG_SMP
+#define SMP_RUN_MS 1000
+
+struct smp_pair {
+	struct k_sem ping;
+	struct k_sem pong;
+	struct k_thread pinger;
+	struct k_thread ponger;
+	uint32_t count;
+};
+
+static struct smp_pair pairs[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(smp_stacks, 2 * CONFIG_MP_NUM_CPUS, 1024);
+
+static void pinger_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct smp_pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_give(&p->ping);
+		k_sem_take(&p->pong, K_FOREVER);
+		p->count++;
+	}
+}
+
+static void ponger_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct smp_pair *p = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&p->ping, K_FOREVER);
+		k_sem_give(&p->pong);
+	}
+}
+
+static void smp_bench(void)
+{
+	/* Below main, so main always gets a CPU back to stop the run */
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		uint32_t tot = 0U;
+
+		for (int i = 0; i < n; i++) {
+			struct smp_pair *p = &pairs[i];
+
+			k_sem_init(&p->ping, 0, 1);
+			k_sem_init(&p->pong, 0, 1);
+			p->count = 0U;
+
+			k_thread_create(&p->ponger, smp_stacks[2 * i],
+					K_THREAD_STACK_SIZEOF(smp_stacks[2 * i]),
+					ponger_fn, p, NULL, NULL,
+					prio, 0, K_NO_WAIT);
+			k_thread_create(&p->pinger, smp_stacks[2 * i + 1],
+					K_THREAD_STACK_SIZEOF(smp_stacks[2 * i + 1]),
+					pinger_fn, p, NULL, NULL,
+					prio, 0, K_NO_WAIT);
+		}
+
+		k_sleep(K_MSEC(SMP_RUN_MS));
+
+		for (int i = 0; i < n; i++) {
+			k_thread_abort(&pairs[i].pinger);
+			k_thread_abort(&pairs[i].ponger);
+			tot += pairs[i].count;
+		}
+
+		printk("smp pairs %d round trips %u (%u per pair)\n",
+		       n, tot, tot / n);
+	}
+}
+#endif /* CONFIG_SMP */
+
+#if CONFIG_BENCHMARK_WAITQ_WAITERS > 0
+#define WAITQ_RUNS 100
+#define WAITQ_STACK_SIZE 512
+
+static struct k_thread waiters[CONFIG_BENCHMARK_WAITQ_WAITERS];
+static K_THREAD_STACK_ARRAY_DEFINE(waiter_stacks,
+				   CONFIG_BENCHMARK_WAITQ_WAITERS,
+				   WAITQ_STACK_SIZE);
+
+static void waiter_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	unsigned int key = irq_lock();
+
+	z_pend_curr_irqlock(key, &waitq, K_FOREVER);
+}
+
+/* Waiters are spread over the priorities between the partner and
+ * K_HIGHEST_THREAD_PRIO, they run (and pend) as soon as they are
+ * created
+ */
+static void waitq_bench(k_tid_t partner, int partner_prio)
+{
+	int n_prios = partner_prio - K_HIGHEST_THREAD_PRIO;
+	int n = 0;
+
+	for (int target = 1; target <= CONFIG_BENCHMARK_WAITQ_WAITERS;
+	     target *= 2) {
+		uint32_t unpend_tot = 0U, pend_tot = 0U;
+
+		for (; n < target; n++) {
+			k_thread_create(&waiters[n], waiter_stacks[n],
+					WAITQ_STACK_SIZE, waiter_fn,
+					NULL, NULL, NULL,
+					K_HIGHEST_THREAD_PRIO + n % n_prios,
+					0, K_NO_WAIT);
+		}
+
+		for (int i = 0; i < WAITQ_RUNS; i++) {
+			stamp(UNPENDING);
+			z_unpend_thread(partner);
+			stamp(UNPENDED_READYING);
+			z_ready_thread(partner);
+			stamp(READIED_YIELDING);
+			k_yield();
+			stamp(YIELDED);
+
+			unpend_tot += stamps[1] - stamps[0];
+			pend_tot += stamps[4] - stamps[3];
+		}
+
+		printk("waiters %3d unpend %4u pend %4u\n", n,
+		       unpend_tot / WAITQ_RUNS, pend_tot / WAITQ_RUNS);
+	}
+
+	for (int i = 0; i < n; i++) {
+		k_thread_abort(&waiters[i]);
+	}
+}
+#endif /* CONFIG_BENCHMARK_WAITQ_WAITERS > 0 */
+
 void main(void)
 {
 	z_waitq_init(&waitq);
@@ -148,5 +304,12 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+#if CONFIG_BENCHMARK_WAITQ_WAITERS > 0
+	waitq_bench(th, partner_prio);
+#endif
+#ifdef CONFIG_SMP
+	smp_bench();
+#endif
 	printk("fin\n");
 }
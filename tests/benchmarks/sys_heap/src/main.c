@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/sys_heap.h>
+#include <sys/heap_listener.h>
+#include <timing/timing.h>
+
+/* This is a sys_heap microbenchmark.  It keeps a pool of live blocks
+ * in the heap and repeatedly frees a random one and allocates a
+ * replacement, timing both operations.  Almost all blocks are small
+ * and drawn from a few fixed sizes, with the occasional larger one
+ * mixed in, which is the workload the size class front end is
+ * designed for.
+ */
+
+#define HEAP_SZ (16 * 1024)
+#define N_RUNS 4000
+#define MAX_LIVE 128
+
+static const size_t small_sizes[] = { 12, 24, 32, 48, 60 };
+static const int live_counts[] = { 16, 64, MAX_LIVE };
+
+static char heap_mem[HEAP_SZ] __aligned(8);
+static struct sys_heap heap;
+static void *live[MAX_LIVE];
+
+static uint32_t sc_hits, sc_misses;
+
+static void on_size_class(uintptr_t heap_id, uint32_t hits, uint32_t misses)
+{
+	ARG_UNUSED(heap_id);
+
+	sc_hits = hits;
+	sc_misses = misses;
+}
+
+static struct heap_listener size_class_listener = {
+	.event = HEAP_SIZE_CLASS,
+	.size_class_cb = on_size_class,
+};
+
+/* Simple LCRNG so every configuration sees the same sequence */
+static uint32_t rand32(void)
+{
+	static uint32_t state = 123456789U;
+
+	state = state * 1103515245U + 12345U;
+	return state >> 8;
+}
+
+static size_t rand_size(void)
+{
+	uint32_t r = rand32();
+
+	if ((r & 31U) == 0U) {
+		return 128 + (r >> 5) % 384;
+	}
+	return small_sizes[(r >> 5) % ARRAY_SIZE(small_sizes)];
+}
+
+static void run(int n_live)
+{
+	uint64_t alloc_tot = 0U, free_tot = 0U;
+	uint32_t fails = 0U;
+	timing_t t0, t1, t2;
+
+	for (int i = 0; i < n_live; i++) {
+		live[i] = sys_heap_alloc(&heap, rand_size());
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		int idx = rand32() % n_live;
+		size_t sz = rand_size();
+
+		t0 = timing_counter_get();
+		sys_heap_free(&heap, live[idx]);
+		t1 = timing_counter_get();
+		live[idx] = sys_heap_alloc(&heap, sz);
+		t2 = timing_counter_get();
+
+		free_tot += timing_cycles_get(&t0, &t1);
+		alloc_tot += timing_cycles_get(&t1, &t2);
+		fails += live[idx] == NULL;
+	}
+
+	for (int i = 0; i < n_live; i++) {
+		sys_heap_free(&heap, live[i]);
+		live[i] = NULL;
+	}
+
+	printk("churn %4d alloc %6u ns free %6u ns (%u failed)\n", n_live,
+	       (uint32_t)timing_cycles_to_ns_avg(alloc_tot, N_RUNS),
+	       (uint32_t)timing_cycles_to_ns_avg(free_tot, N_RUNS), fails);
+}
+
+/* Leaves every other block of a full pool allocated and reports the
+ * biggest block the heap can still produce
+ */
+static void fragmentation(void)
+{
+	size_t lo = 0, hi = HEAP_SZ;
+
+	for (int i = 0; i < MAX_LIVE; i++) {
+		live[i] = sys_heap_alloc(&heap, rand_size());
+	}
+	for (int i = 0; i < MAX_LIVE; i += 2) {
+		sys_heap_free(&heap, live[i]);
+		live[i] = NULL;
+	}
+
+	while (lo < hi) {
+		size_t mid = (lo + hi + 1) / 2;
+		void *p = sys_heap_alloc(&heap, mid);
+
+		if (p != NULL) {
+			sys_heap_free(&heap, p);
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
+	}
+
+	for (int i = 1; i < MAX_LIVE; i += 2) {
+		sys_heap_free(&heap, live[i]);
+		live[i] = NULL;
+	}
+
+	printk("largest free block %6zu bytes\n", lo);
+}
+
+void main(void)
+{
+	sys_heap_init(&heap, heap_mem, sizeof(heap_mem));
+
+	size_class_listener.heap_id = HEAP_ID_FROM_POINTER(&heap);
+	heap_listener_register(&size_class_listener);
+
+	timing_init();
+	timing_start();
+
+	printk("sys_heap size classes: %s\n",
+	       IS_ENABLED(CONFIG_SYS_HEAP_SIZE_CLASSES) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(live_counts); i++) {
+		run(live_counts[i]);
+	}
+
+	fragmentation();
+
+	if (IS_ENABLED(CONFIG_SYS_HEAP_SIZE_CLASSES)) {
+		printk("size class hits %u misses %u (%u%%)\n",
+		       sc_hits, sc_misses,
+		       sc_hits + sc_misses == 0U ? 0U :
+		       100U * sc_hits / (sc_hits + sc_misses));
+	}
+
+	timing_stop();
+	printk("fin\n");
+}
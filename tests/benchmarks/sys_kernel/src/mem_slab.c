@@ -20,6 +20,84 @@ K_MEM_SLAB_DEFINE_STATIC(my_slab,
 /* Array contains pointers to allocated regions. */
 static void *slab_array[MEM_SLAB_BLOCK_CNT];
 
+#if CONFIG_MP_NUM_CPUS > 1
+/* Blocks each thread holds at once in the multi-CPU test */
+#define SMP_SLAB_BATCH 4
+
+K_MEM_SLAB_DEFINE_STATIC(smp_slab,
+		  MEM_SLAB_BLOCK_SIZE,
+		  CONFIG_MP_NUM_CPUS * SMP_SLAB_BATCH * 8,
+		  MEM_SLAB_BLOCK_ALIGN);
+
+static K_THREAD_STACK_ARRAY_DEFINE(smp_stacks, CONFIG_MP_NUM_CPUS, 1024);
+static struct k_thread smp_threads[CONFIG_MP_NUM_CPUS];
+static int smp_loops_done[CONFIG_MP_NUM_CPUS];
+
+/**
+ *
+ * @brief Multi-CPU memslab thread function.
+ *		  Allocates and frees SMP_SLAB_BATCH blocks per loop.
+ *
+ * @param p1  Pointer to the number of loops done.
+ * @param p2  Amount of loops to run.
+ */
+static void mem_slab_smp_thread(void *p1, void *p2, void *p3)
+{
+	int *done = p1;
+	int no_of_loops = POINTER_TO_INT(p2);
+	void *blocks[SMP_SLAB_BATCH];
+	int i;
+
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < no_of_loops; i++) {
+		for (int j = 0; j < SMP_SLAB_BATCH; j++) {
+			if (k_mem_slab_alloc(&smp_slab, &blocks[j],
+					     K_NO_WAIT) != 0) {
+				*done = i;
+				return;
+			}
+		}
+		for (int j = 0; j < SMP_SLAB_BATCH; j++) {
+			k_mem_slab_free(&smp_slab, &blocks[j]);
+		}
+	}
+
+	*done = i;
+}
+
+/**
+ *
+ * @brief Multi-CPU memslab throughput test function.
+ *		  Runs one alloc/free thread per CPU on a shared slab.
+ *
+ * @param no_of_loops  Amount of loops to run.
+ *
+ * @return Number of loops done by the slowest thread.
+ */
+static int mem_slab_smp_test(int no_of_loops)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+	int done = no_of_loops;
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		smp_loops_done[cpu] = 0;
+		k_thread_create(&smp_threads[cpu], smp_stacks[cpu],
+				K_THREAD_STACK_SIZEOF(smp_stacks[cpu]),
+				mem_slab_smp_thread, &smp_loops_done[cpu],
+				INT_TO_POINTER(no_of_loops), NULL,
+				prio, 0, K_NO_WAIT);
+	}
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		k_thread_join(&smp_threads[cpu], K_FOREVER);
+		done = MIN(done, smp_loops_done[cpu]);
+	}
+
+	return done;
+}
+#endif /* CONFIG_MP_NUM_CPUS > 1 */
+
 /**
  *
  * @brief Memslab allocation test function.
@@ -103,5 +181,34 @@ int mem_slab_test(void)
 
 	return_value += check_result(i, t);
 
+#if CONFIG_MP_NUM_CPUS > 1
+	/* Test k_mem_slab_alloc/free contention. */
+	fprintf(output_file, sz_test_case_fmt,
+		"Memslab #3");
+	fprintf(output_file, sz_description,
+		"\n\tk_mem_slab_alloc/k_mem_slab_free on all CPUs");
+	fprintf(output_file, "\n\t%d CPUs, %d blocks per iteration each",
+		CONFIG_MP_NUM_CPUS, SMP_SLAB_BATCH);
+	printf(sz_test_start_fmt);
+
+	t = BENCH_START();
+	i = mem_slab_smp_test(number_of_loops);
+	t = TIME_STAMP_DELTA_GET(t);
+
+	if (k_mem_slab_num_used_get(&smp_slab) != 0) {
+		i = 0;
+	}
+
+	return_value += check_result(i, t);
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	struct k_mem_slab_cache_stats stats;
+
+	k_mem_slab_cache_stats_get(&smp_slab, &stats);
+	fprintf(output_file, "\nCPU cache hits %u misses %u",
+		stats.hits, stats.misses);
+#endif
+#endif /* CONFIG_MP_NUM_CPUS > 1 */
+
 	return return_value;
 }
@@ -164,8 +164,10 @@ void main(void)
 		test_result += mem_slab_test();
 
 		if (test_result) {
-			/* sema/lifo/fifo/stack/mem_slab account for 14 tests in total */
-			if (test_result == 14) {
+			/* sema/lifo/fifo/stack/mem_slab account for
+			 * NUMBER_OF_TESTS tests in total
+			 */
+			if (test_result == NUMBER_OF_TESTS) {
 				fprintf(output_file, sz_module_result_fmt,
 					sz_success);
 			} else {
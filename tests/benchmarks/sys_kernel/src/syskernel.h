@@ -50,6 +50,13 @@ extern uint32_t number_of_loops;
 #define sz_case_end_fmt		"\nEND TEST CASE"
 #define sz_case_timing_fmt	"%u nSec"
 
+/* Memslab #3 only exists on multi-CPU builds */
+#if CONFIG_MP_NUM_CPUS > 1
+#define NUMBER_OF_TESTS 15
+#else
+#define NUMBER_OF_TESTS 14
+#endif
+
 int check_result(int i, uint32_t ticks);
 
 int sema_test(void);
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+#include <net/net_if.h>
+#include <net/net_mgmt.h>
+#include <net/net_stats.h>
+
+/* This is a TCP bulk transfer benchmark.  A sender thread pushes a fixed
+ * amount of data over a loopback connection while the main thread reads
+ * it.  Nearly every segment is either in-order data for the receiver or
+ * a pure ACK for the sender, which is what the header prediction fast
+ * path and delayed ACKs are for.
+ */
+
+#define SERVER_ADDR "192.0.2.1"
+#define SERVER_PORT 4242
+#define TOTAL_LEN (1024 * 1024)
+#define MAX_CHUNK 4096
+
+#define SENDER_STACK_SIZE 2048
+#define SENDER_PRIORITY K_PRIO_PREEMPT(8)
+
+static const int chunk_sizes[] = { 64, 256, 1024, MAX_CHUNK };
+
+static K_THREAD_STACK_DEFINE(sender_stack, SENDER_STACK_SIZE);
+static struct k_thread sender_thread;
+
+static uint8_t send_buf[MAX_CHUNK];
+static uint8_t recv_buf[MAX_CHUNK];
+
+static void sender(void *p1, void *p2, void *p3)
+{
+	int sock = POINTER_TO_INT(p1);
+	int chunk = POINTER_TO_INT(p2);
+	int sent = 0;
+
+	ARG_UNUSED(p3);
+
+	while (sent < TOTAL_LEN) {
+		int ret = send(sock, send_buf, MIN(chunk, TOTAL_LEN - sent), 0);
+
+		if (ret < 0) {
+			printk("send failed (%d)\n", errno);
+			return;
+		}
+
+		sent += ret;
+	}
+}
+
+static uint32_t ipv4_sent(void)
+{
+	struct net_stats_ip ipv4;
+
+	if (net_mgmt(NET_REQUEST_STATS_GET_IPV4, NULL, &ipv4,
+		     sizeof(ipv4)) < 0) {
+		return 0U;
+	}
+
+	return ipv4.sent;
+}
+
+static bool run(int client, int server, int chunk)
+{
+	uint32_t packets;
+	uint32_t t0, t1;
+	uint64_t ns;
+	int received = 0;
+
+	packets = ipv4_sent();
+	t0 = k_cycle_get_32();
+
+	k_thread_create(&sender_thread, sender_stack,
+			K_THREAD_STACK_SIZEOF(sender_stack), sender,
+			INT_TO_POINTER(client), INT_TO_POINTER(chunk), NULL,
+			SENDER_PRIORITY, 0, K_NO_WAIT);
+
+	while (received < TOTAL_LEN) {
+		int ret = recv(server, recv_buf, sizeof(recv_buf), 0);
+
+		if (ret <= 0) {
+			printk("recv failed (%d)\n", ret < 0 ? errno : 0);
+			k_thread_abort(&sender_thread);
+			return false;
+		}
+
+		received += ret;
+	}
+
+	t1 = k_cycle_get_32();
+	packets = ipv4_sent() - packets;
+
+	k_thread_join(&sender_thread, K_FOREVER);
+
+	ns = k_cyc_to_ns_floor64(t1 - t0);
+
+	printk("chunk %4d %8u KiB/s %6u packets\n", chunk,
+	       (uint32_t)((uint64_t)TOTAL_LEN * NSEC_PER_SEC / 1024U /
+			  MAX(ns, 1U)),
+	       packets);
+
+	return true;
+}
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int listener, client, server;
+
+	inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr);
+
+	listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listener < 0 ||
+	    bind(listener, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(listener, 1) < 0) {
+		printk("cannot set up listener (%d)\n", errno);
+		return;
+	}
+
+	client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (client < 0 ||
+	    connect(client, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot connect (%d)\n", errno);
+		return;
+	}
+
+	server = accept(listener, NULL, NULL);
+	if (server < 0) {
+		printk("cannot accept (%d)\n", errno);
+		return;
+	}
+
+	for (int i = 0; i < sizeof(send_buf); i++) {
+		send_buf[i] = i;
+	}
+
+	printk("header prediction %s, delayed ACK %s\n",
+	       IS_ENABLED(CONFIG_NET_TCP_HEADER_PREDICTION) ? "on" : "off",
+	       IS_ENABLED(CONFIG_NET_TCP_DELAYED_ACK) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		if (!run(client, server, chunk_sizes[i])) {
+			break;
+		}
+	}
+
+	close(client);
+	close(server);
+	close(listener);
+	printk("fin\n");
+}
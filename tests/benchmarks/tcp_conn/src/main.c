@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+/* This is a TCP connection lookup benchmark.  It opens a number of
+ * connected socket pairs over the loopback interface and then
+ * bounces single bytes over randomly chosen pairs.  Every segment,
+ * data and ACK alike, has to be matched to its connection, so with a
+ * linear lookup the round trip time grows with the number of open
+ * connections while the hashed lookup should keep it flat.
+ */
+
+#define SERVER_ADDR "192.0.2.1"
+#define SERVER_PORT 4242
+#define N_RUNS 2000
+#define MAX_PAIRS 256
+
+static const int pair_counts[] = { 1, 8, 64, MAX_PAIRS };
+
+static int client[MAX_PAIRS];
+static int server[MAX_PAIRS];
+static int n_open;
+
+/* Simple LCRNG so every configuration sees the same sequence */
+static uint32_t rand32(void)
+{
+	static uint32_t state = 123456789U;
+
+	state = state * 1103515245U + 12345U;
+	return state >> 8;
+}
+
+static int open_pairs(int listener, const struct sockaddr_in *addr,
+		      int n_pairs)
+{
+	while (n_open < n_pairs) {
+		client[n_open] = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+		if (client[n_open] < 0) {
+			return -errno;
+		}
+
+		if (connect(client[n_open], (const struct sockaddr *)addr,
+			    sizeof(*addr)) < 0) {
+			return -errno;
+		}
+
+		server[n_open] = accept(listener, NULL, NULL);
+		if (server[n_open] < 0) {
+			return -errno;
+		}
+
+		n_open++;
+	}
+
+	return 0;
+}
+
+static void run(int n_pairs)
+{
+	uint64_t tot = 0U;
+	uint32_t fails = 0U;
+	char c = 'x';
+
+	for (int i = 0; i < N_RUNS; i++) {
+		int idx = rand32() % n_pairs;
+		uint32_t t0, t1;
+
+		t0 = k_cycle_get_32();
+		if (send(client[idx], &c, 1, 0) != 1 ||
+		    recv(server[idx], &c, 1, 0) != 1) {
+			fails++;
+		}
+		t1 = k_cycle_get_32();
+
+		tot += t1 - t0;
+	}
+
+	printk("conns %4d round trip %6u ns (%u failed)\n", 2 * n_pairs,
+	       (uint32_t)(k_cyc_to_ns_floor64(tot) / N_RUNS), fails);
+}
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int listener;
+	int ret;
+
+	inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr);
+
+	listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (listener < 0 ||
+	    bind(listener, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    listen(listener, 4) < 0) {
+		printk("cannot set up listener (%d)\n", errno);
+		return;
+	}
+
+	printk("tcp connection hash buckets: %d\n",
+	       CONFIG_NET_TCP_CONN_HASH_SIZE);
+
+	for (int i = 0; i < ARRAY_SIZE(pair_counts); i++) {
+		ret = open_pairs(listener, &addr, pair_counts[i]);
+		if (ret < 0) {
+			printk("cannot open %d connections (%d)\n",
+			       2 * pair_counts[i], ret);
+			break;
+		}
+
+		run(pair_counts[i]);
+	}
+
+	for (int i = 0; i < n_open; i++) {
+		close(client[i]);
+		close(server[i]);
+	}
+
+	close(listener);
+	printk("fin\n");
+}
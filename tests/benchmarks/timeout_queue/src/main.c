@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timeout_q.h>
+#include <timing/timing.h>
+
+/* This is a timeout queue microbenchmark.  It fills the kernel
+ * timeout queue with a number of "live" timeouts that will not expire
+ * during the run, then times adding and aborting one more "probe"
+ * timeout behind all of them.  The sorted list backend has to walk
+ * the whole queue to insert the probe, the timing wheel backend
+ * should not care how many timeouts are pending.
+ */
+
+#define N_RUNS 1000
+#define MAX_LIVE 1000
+
+/* Far enough out that nothing fires while we measure */
+#define LIVE_BASE_TICKS 1000000
+
+static struct _timeout live[MAX_LIVE];
+static struct _timeout probe;
+
+static const int live_counts[] = { 10, 100, 1000 };
+
+static void dummy_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void run(int n_live)
+{
+	uint64_t add_tot = 0U, abort_tot = 0U;
+	timing_t t0, t1, t2;
+
+	for (int i = 0; i < n_live; i++) {
+		/* Scatter expiries so the list isn't trivially ordered */
+		k_ticks_t ticks = LIVE_BASE_TICKS + (i * 7919) % (n_live * 64);
+
+		z_init_timeout(&live[i]);
+		z_add_timeout(&live[i], dummy_fn, K_TICKS(ticks));
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		z_init_timeout(&probe);
+
+		t0 = timing_counter_get();
+		z_add_timeout(&probe, dummy_fn,
+			      K_TICKS(2 * LIVE_BASE_TICKS));
+		t1 = timing_counter_get();
+		z_abort_timeout(&probe);
+		t2 = timing_counter_get();
+
+		add_tot += timing_cycles_get(&t0, &t1);
+		abort_tot += timing_cycles_get(&t1, &t2);
+	}
+
+	for (int i = 0; i < n_live; i++) {
+		z_abort_timeout(&live[i]);
+	}
+
+	printk("live %4d add %6u ns abort %6u ns\n", n_live,
+	       (uint32_t)timing_cycles_to_ns_avg(add_tot, N_RUNS),
+	       (uint32_t)timing_cycles_to_ns_avg(abort_tot, N_RUNS));
+}
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("timeout queue backend: %s\n",
+	       IS_ENABLED(CONFIG_TIMEOUT_QUEUE_WHEEL) ? "wheel" : "dlist");
+
+	for (int i = 0; i < ARRAY_SIZE(live_counts); i++) {
+		run(live_counts[i]);
+	}
+
+	timing_stop();
+	printk("fin\n");
+}
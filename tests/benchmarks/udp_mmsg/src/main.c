@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <net/socket.h>
+
+/* This is a UDP throughput benchmark for the batched socket calls.
+ * Datagrams are sent over the loopback interface to a bound socket,
+ * either one call per datagram or one call per batch, and read back
+ * the same way.  The per datagram cost of the network stack is the
+ * same in both cases, so the difference is the per call overhead.
+ */
+
+#define SERVER_ADDR "192.0.2.1"
+#define SERVER_PORT 4242
+#define DGRAM_SIZE 64
+#define N_DGRAMS 4096
+#define MAX_BATCH 32
+
+static const int batch_sizes[] = { 1, 4, 16, MAX_BATCH };
+
+static uint8_t tx_buf[DGRAM_SIZE];
+static uint8_t rx_buf[MAX_BATCH][DGRAM_SIZE];
+static struct iovec tx_iov[MAX_BATCH];
+static struct iovec rx_iov[MAX_BATCH];
+static struct mmsghdr tx_msgs[MAX_BATCH];
+static struct mmsghdr rx_msgs[MAX_BATCH];
+
+static int run_single(int client, int server, struct sockaddr_in *addr,
+		      int batch)
+{
+	for (int i = 0; i < batch; i++) {
+		if (sendto(client, tx_buf, sizeof(tx_buf), 0,
+			   (struct sockaddr *)addr, sizeof(*addr)) < 0) {
+			return -errno;
+		}
+	}
+
+	for (int i = 0; i < batch; i++) {
+		if (recvfrom(server, rx_buf[i], sizeof(rx_buf[i]), 0,
+			     NULL, NULL) < 0) {
+			return -errno;
+		}
+	}
+
+	return 0;
+}
+
+static int run_mmsg(int client, int server, struct sockaddr_in *addr,
+		    int batch)
+{
+	int received = 0;
+	int ret;
+
+	for (int i = 0; i < batch; i++) {
+		tx_msgs[i].msg_hdr.msg_name = addr;
+		tx_msgs[i].msg_hdr.msg_namelen = sizeof(*addr);
+	}
+
+	ret = sendmmsg(client, tx_msgs, batch, 0);
+	if (ret != batch) {
+		return ret < 0 ? -errno : -EIO;
+	}
+
+	/* recvmmsg() returns what is queued once the first one arrives */
+	while (received < batch) {
+		ret = recvmmsg(server, &rx_msgs[received], batch - received,
+			       0);
+		if (ret < 0) {
+			return -errno;
+		}
+
+		received += ret;
+	}
+
+	return 0;
+}
+
+static void run(const char *name, int client, int server,
+		struct sockaddr_in *addr, int batch,
+		int (*fn)(int, int, struct sockaddr_in *, int))
+{
+	uint32_t t0, t1;
+	int ret = 0;
+
+	t0 = k_cycle_get_32();
+
+	for (int i = 0; i < N_DGRAMS / batch && ret == 0; i++) {
+		ret = fn(client, server, addr, batch);
+	}
+
+	t1 = k_cycle_get_32();
+
+	if (ret < 0) {
+		printk("%s batch %d failed (%d)\n", name, batch, ret);
+		return;
+	}
+
+	printk("%-6s batch %2d %6u ns/datagram\n", name, batch,
+	       (uint32_t)(k_cyc_to_ns_floor64(t1 - t0) / N_DGRAMS));
+}
+
+void main(void)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(SERVER_PORT),
+	};
+	int client, server;
+
+	inet_pton(AF_INET, SERVER_ADDR, &addr.sin_addr);
+
+	for (int i = 0; i < MAX_BATCH; i++) {
+		tx_iov[i].iov_base = tx_buf;
+		tx_iov[i].iov_len = sizeof(tx_buf);
+		tx_msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+
+		rx_iov[i].iov_base = rx_buf[i];
+		rx_iov[i].iov_len = sizeof(rx_buf[i]);
+		rx_msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	client = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	server = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (client < 0 || server < 0 ||
+	    bind(server, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot set up sockets (%d)\n", errno);
+		return;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(batch_sizes); i++) {
+		run("single", client, server, &addr, batch_sizes[i],
+		    run_single);
+		run("mmsg", client, server, &addr, batch_sizes[i], run_mmsg);
+	}
+
+	close(client);
+	close(server);
+	printk("fin\n");
+}
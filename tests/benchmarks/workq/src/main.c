@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* This is a work queue throughput benchmark.  For 1..MP_NUM_CPUS
+ * producer threads it has every producer keep submitting its own
+ * work items to one queue for RUN_MS, and reports how many times the
+ * handlers ran in total.
+ */
+
+#define RUN_MS 1000
+#define ITEMS_PER_PRODUCER 4
+#define STACK_SIZE 1024
+
+/* Iterations of busy work done by each handler */
+#define WORK_LOOPS 256
+
+#define N_WORKERS (CONFIG_BENCHMARK_WORKQ_THREADS - 1)
+
+static struct k_work_q queue;
+static K_THREAD_STACK_DEFINE(queue_stack, STACK_SIZE);
+
+#if N_WORKERS > 0
+static struct k_work_q_worker workers[N_WORKERS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, N_WORKERS, STACK_SIZE);
+#endif
+
+static struct k_thread producers[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, CONFIG_MP_NUM_CPUS,
+				   STACK_SIZE);
+static struct k_work items[CONFIG_MP_NUM_CPUS][ITEMS_PER_PRODUCER];
+static atomic_t handled;
+static atomic_t stop;
+
+static void handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	for (volatile int i = 0; i < WORK_LOOPS; i++) {
+	}
+
+	atomic_inc(&handled);
+}
+
+static void producer(void *arg1, void *arg2, void *arg3)
+{
+	struct k_work *mine = items[POINTER_TO_UINT(arg1)];
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (!atomic_get(&stop)) {
+		for (int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+			(void)k_work_submit_to_queue(&queue, &mine[i]);
+		}
+		k_yield();
+	}
+}
+
+void main(void)
+{
+	/* Below main, so main always gets a CPU back to stop the run */
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	k_work_queue_start(&queue, queue_stack, STACK_SIZE, prio, NULL);
+
+#if N_WORKERS > 0
+	for (int i = 0; i < N_WORKERS; i++) {
+		(void)k_work_queue_worker_add(&queue, &workers[i],
+					      worker_stacks[i], STACK_SIZE,
+					      prio, -1);
+	}
+#endif
+
+	printk("work queue threads: %d\n", CONFIG_BENCHMARK_WORKQ_THREADS);
+
+	for (int p = 0; p < CONFIG_MP_NUM_CPUS; p++) {
+		for (int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+			k_work_init(&items[p][i], handler);
+		}
+	}
+
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		uint32_t tot;
+
+		atomic_clear(&handled);
+		atomic_clear(&stop);
+
+		for (int i = 0; i < n; i++) {
+			k_thread_create(&producers[i], producer_stacks[i],
+					K_THREAD_STACK_SIZEOF(producer_stacks[i]),
+					producer, UINT_TO_POINTER(i), NULL, NULL,
+					prio, 0, K_NO_WAIT);
+		}
+
+		k_sleep(K_MSEC(RUN_MS));
+		tot = atomic_get(&handled);
+
+		atomic_set(&stop, 1);
+		for (int i = 0; i < n; i++) {
+			k_thread_join(&producers[i], K_FOREVER);
+		}
+		(void)k_work_queue_drain(&queue, false);
+
+		printk("producers %d items %u (%u per producer)\n",
+		       n, tot, tot / n);
+	}
+
+	printk("fin\n");
+}
@@ -11,6 +11,8 @@
 K_MEM_SLAB_DEFINE(kmslab, BLK_SIZE, BLK_NUM, BLK_ALIGN);
 static char __aligned(BLK_ALIGN) tslab[BLK_SIZE * BLK_NUM];
 static struct k_mem_slab mslab;
+static char __aligned(BLK_ALIGN) max_used_buf[BLK_SIZE * BLK_NUM];
+static struct k_mem_slab max_used_slab;
 
 void tmslab_alloc_free(void *data)
 {
@@ -328,3 +330,56 @@ void test_mslab_pending(void)
 	/* Free memory block */
 	k_mem_slab_free(&kmslab, &b);
 }
+
+/**
+ * @brief Verify the maximum utilization of a memory slab
+ *
+ * @details The test case allocates blocks one at a time and checks
+ * that @see k_mem_slab_max_used_get() follows the number of used
+ * blocks, and keeps the peak when the blocks are freed. With
+ * CONFIG_MEM_SLAB_CPU_CACHE most of these allocations are served
+ * from the cache of the CPU.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_max_used(void)
+{
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	void *block[BLK_NUM];
+	void *b;
+
+	zassert_equal(k_mem_slab_init(&max_used_slab, max_used_buf,
+				      BLK_SIZE, BLK_NUM), 0, NULL);
+
+	for (int i = 0; i < BLK_NUM - 1; i++) {
+		zassert_equal(k_mem_slab_alloc(&max_used_slab, &block[i],
+					       K_NO_WAIT), 0, NULL);
+		zassert_equal(k_mem_slab_max_used_get(&max_used_slab),
+			      i + 1, NULL);
+	}
+
+	for (int i = 0; i < BLK_NUM - 1; i++) {
+		k_mem_slab_free(&max_used_slab, &block[i]);
+	}
+
+	zassert_equal(k_mem_slab_max_used_get(&max_used_slab), BLK_NUM - 1,
+		      NULL);
+
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_equal(k_mem_slab_alloc(&max_used_slab, &block[i],
+					       K_NO_WAIT), 0, NULL);
+	}
+
+	zassert_equal(k_mem_slab_max_used_get(&max_used_slab), BLK_NUM, NULL);
+	zassert_equal(k_mem_slab_alloc(&max_used_slab, &b, K_NO_WAIT),
+		      -ENOMEM, NULL);
+
+	for (int i = 0; i < BLK_NUM; i++) {
+		k_mem_slab_free(&max_used_slab, &block[i]);
+	}
+
+	zassert_equal(k_mem_slab_num_free_get(&max_used_slab), BLK_NUM, NULL);
+#else
+	ztest_test_skip();
+#endif
+}
@@ -9,14 +9,18 @@
 /**TESTPOINT: init via K_MSGQ_DEFINE*/
 K_MSGQ_DEFINE(kmsgq, MSG_SIZE, MSGQ_LEN, 4);
 K_MSGQ_DEFINE(kmsgq_test_alloc, MSG_SIZE, MSGQ_LEN, 4);
+K_MSGQ_DEFINE(kmsgq_tiny, MSG_SIZE, 1, 4);
 struct k_msgq msgq;
 struct k_msgq msgq1;
 K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
 K_THREAD_STACK_DEFINE(tstack1, STACK_SIZE);
 K_THREAD_STACK_DEFINE(tstack2, STACK_SIZE);
+K_THREAD_STACK_ARRAY_DEFINE(mixed_stack, 3, STACK_SIZE);
 struct k_thread tdata;
 struct k_thread tdata1;
 struct k_thread tdata2;
+static struct k_thread mixed_tdata[3];
+static struct k_sem mixed_done;
 static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * MSGQ_LEN];
 static ZTEST_DMEM char __aligned(4) tbuffer1[MSG_SIZE];
 static ZTEST_DMEM uint32_t data[MSGQ_LEN] = { MSG0, MSG1 };
@@ -451,6 +455,71 @@ void test_msgq_full(void)
 	k_thread_abort(tid);
 }
 
+static void mixed_get_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t rx_data;
+
+	if (k_msgq_get(p1, &rx_data, K_FOREVER) == 0) {
+		k_sem_give(p2);
+	}
+}
+
+static void mixed_put_entry(void *p1, void *p2, void *p3)
+{
+	if (k_msgq_put(p1, &data[1], K_FOREVER) == 0) {
+		k_sem_give(p2);
+	}
+}
+
+/**
+ * @brief Test blocked writers and readers sharing a tiny queue
+ *
+ * @details
+ * - Two readers block on an empty one message queue.
+ * - A message is put, readying the first reader, and a writer of
+ *   higher priority than the readers blocks on the now full queue
+ *   before that reader runs.
+ * - Once the first reader takes its message the writer must be woken,
+ *   and its message must reach the second reader.
+ *
+ * @see k_msgq_put(), k_msgq_get()
+ */
+void test_msgq_mixed_waiters(void)
+{
+	int pri = k_thread_priority_get(k_current_get());
+	int i;
+
+	k_msgq_purge(&kmsgq_tiny);
+	k_sem_init(&mixed_done, 0, 3);
+
+	for (i = 0; i < 2; i++) {
+		k_thread_create(&mixed_tdata[i], mixed_stack[i], STACK_SIZE,
+				mixed_get_entry, &kmsgq_tiny, &mixed_done, NULL,
+				pri + 2, 0, K_NO_WAIT);
+	}
+
+	/* let both readers block on the empty queue */
+	k_msleep(TIMEOUT_MS);
+
+	zassert_equal(k_msgq_put(&kmsgq_tiny, &data[0], K_NO_WAIT), 0, NULL);
+
+	/* the writer runs before the readied reader */
+	k_thread_create(&mixed_tdata[2], mixed_stack[2], STACK_SIZE,
+			mixed_put_entry, &kmsgq_tiny, &mixed_done, NULL,
+			pri + 1, 0, K_NO_WAIT);
+
+	for (i = 0; i < 3; i++) {
+		zassert_equal(k_sem_take(&mixed_done, TIMEOUT), 0,
+			      "blocked thread %d never completed", i);
+	}
+
+	zassert_equal(k_msgq_num_used_get(&kmsgq_tiny), 0, NULL);
+
+	for (i = 0; i < 3; i++) {
+		k_thread_abort(&mixed_tdata[i]);
+	}
+}
+
 /**
  * @}
  */
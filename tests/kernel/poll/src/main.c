@@ -49,6 +49,15 @@ dummy_test(test_poll_signal_raise_null);
 dummy_test(test_poll_signal_reset_null);
 #endif /* CONFIG_USERSPACE */
 
+#ifdef CONFIG_POLL_SET
+extern void test_poll_set(void);
+#else
+static void test_poll_set(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 #ifdef CONFIG_64BIT
 #define MAX_SZ	256
 #else
@@ -74,6 +83,7 @@ void test_main(void)
 			 ztest_unit_test(test_poll_multi),
 			 ztest_1cpu_unit_test(test_poll_threadstate),
 			 ztest_1cpu_unit_test(test_detect_is_polling),
+			 ztest_1cpu_unit_test(test_poll_set),
 			 ztest_user_unit_test(test_k_poll_user_num_err),
 			 ztest_user_unit_test(test_k_poll_user_mem_err),
 			 ztest_user_unit_test(test_k_poll_user_type_sem_err),
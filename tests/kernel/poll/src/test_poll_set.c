@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <kernel.h>
+
+#ifdef CONFIG_POLL_SET
+
+#define N_SEMS 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_POLL_SET_DEFINE(test_set, N_SEMS + 1);
+
+static struct k_sem set_sems[N_SEMS];
+static struct k_poll_signal set_signal;
+static struct k_poll_event ready[N_SEMS + 1];
+static struct k_thread set_thread;
+static K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+
+static void raise_signal(void *p1, void *p2, void *p3)
+{
+	k_sleep(K_MSEC(10));
+	k_poll_signal_raise(&set_signal, 0x1234);
+}
+
+/**
+ * @brief Test that a poll set reports only ready objects
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_wait(), k_poll_set_remove()
+ */
+void test_poll_set(void)
+{
+	int rc;
+
+	for (int i = 0; i < N_SEMS; i++) {
+		k_sem_init(&set_sems[i], 0, 2);
+		rc = k_poll_set_add(&test_set, K_POLL_TYPE_SEM_AVAILABLE,
+				    &set_sems[i], i);
+		zassert_equal(rc, 0, NULL);
+	}
+	k_poll_signal_init(&set_signal);
+	zassert_equal(k_poll_set_add(&test_set, K_POLL_TYPE_SIGNAL,
+				     &set_signal, 0xff), 0, NULL);
+
+	/* set is full, and nothing is ready yet */
+	zassert_equal(k_poll_set_add(&test_set, K_POLL_TYPE_SEM_AVAILABLE,
+				     &set_sems[0], 0), -ENOMEM, NULL);
+	zassert_equal(k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/* a ready object is reported with its tag, and keeps being
+	 * reported while it stays available
+	 */
+	k_sem_give(&set_sems[3]);
+	k_sem_give(&set_sems[3]);
+	for (int i = 0; i < 2; i++) {
+		rc = k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready),
+				     K_NO_WAIT);
+		zassert_equal(rc, 1, NULL);
+		zassert_equal(ready[0].obj, &set_sems[3], NULL);
+		zassert_equal(ready[0].tag, 3, NULL);
+		zassert_equal(ready[0].state, K_POLL_STATE_SEM_AVAILABLE, NULL);
+		zassert_equal(k_sem_take(&set_sems[3], K_NO_WAIT), 0, NULL);
+	}
+	zassert_equal(k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/* wait is woken by an object becoming ready */
+	k_thread_create(&set_thread, set_stack, STACK_SIZE, raise_signal,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	rc = k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready),
+			     K_MSEC(1000));
+	zassert_equal(rc, 1, NULL);
+	zassert_equal(ready[0].obj, &set_signal, NULL);
+	zassert_equal(ready[0].tag, 0xff, NULL);
+	zassert_equal(ready[0].state, K_POLL_STATE_SIGNALED, NULL);
+	k_thread_join(&set_thread, K_FOREVER);
+	k_poll_signal_reset(&set_signal);
+
+	/* several ready objects, reported a few at a time */
+	for (int i = 0; i < N_SEMS; i++) {
+		k_sem_give(&set_sems[i]);
+	}
+	rc = k_poll_set_wait(&test_set, ready, 3, K_NO_WAIT);
+	zassert_equal(rc, 3, NULL);
+	for (int i = 0; i < rc; i++) {
+		zassert_equal(k_sem_take(ready[i].sem, K_NO_WAIT), 0, NULL);
+	}
+	rc = k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready), K_NO_WAIT);
+	zassert_equal(rc, N_SEMS - 3, NULL);
+	for (int i = 0; i < rc; i++) {
+		zassert_equal(k_sem_take(ready[i].sem, K_NO_WAIT), 0, NULL);
+	}
+
+	/* removed objects are no longer reported */
+	zassert_equal(k_poll_set_remove(&test_set, &set_sems[5]), 0, NULL);
+	zassert_equal(k_poll_set_remove(&test_set, &set_sems[5]), -ENOENT,
+		      NULL);
+	k_sem_give(&set_sems[5]);
+	zassert_equal(k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+
+	/* timeout */
+	zassert_equal(k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(10)), -EAGAIN, NULL);
+
+	for (int i = 0; i < N_SEMS; i++) {
+		(void)k_poll_set_remove(&test_set, &set_sems[i]);
+	}
+	zassert_equal(k_poll_set_remove(&test_set, &set_signal), 0, NULL);
+
+	/* an edge triggered object is reported once per signal, even if
+	 * it stays available
+	 */
+	k_sem_reset(&set_sems[0]);
+	rc = k_poll_set_add(&test_set,
+			    K_POLL_TYPE_SEM_AVAILABLE | K_POLL_SET_EDGE,
+			    &set_sems[0], 0);
+	zassert_equal(rc, 0, NULL);
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal(ready[0].obj, &set_sems[0], NULL);
+	zassert_equal(k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN, NULL);
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&test_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1, NULL);
+	zassert_equal(k_sem_count_get(&set_sems[0]), 2, NULL);
+	zassert_equal(k_poll_set_remove(&test_set, &set_sems[0]), 0, NULL);
+}
+
+#endif /* CONFIG_POLL_SET */
@@ -114,6 +114,14 @@ static inline int preempt_counter(void)
 	return atomic_get(&preempt_ctr);
 }
 
+static K_THREAD_STACK_DEFINE(pool_stack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(pool_worker_stack, STACK_SIZE);
+static struct k_work_q pool_queue;
+static struct k_work_q_worker pool_worker;
+static atomic_t pool_running;
+static atomic_t pool_overlaps;
+static atomic_t pool_ctr;
+
 static K_THREAD_STACK_DEFINE(invalid_test_stack, STACK_SIZE);
 static struct k_work_q invalid_test_queue;
 
@@ -1551,6 +1559,105 @@ static void test_1cpu_legacy_delayed_cancel(void)
 	zassert_false(k_delayed_work_pending(&lwork), NULL);
 }
 
+/* Counts invocations, and how often a pool handler starts while
+ * another one is still running.
+ */
+static void pool_handler(struct k_work *work)
+{
+	if (atomic_inc(&pool_running) != 0) {
+		atomic_inc(&pool_overlaps);
+	}
+
+	k_sleep(K_MSEC(DELAY_MS));
+
+	atomic_dec(&pool_running);
+	atomic_inc(&pool_ctr);
+}
+
+static void test_pool_start(void)
+{
+	if (!IS_ENABLED(CONFIG_WORKQUEUE_POOL)) {
+		ztest_test_skip();
+		return;
+	}
+
+	int rc;
+
+	k_work_queue_start(&pool_queue, pool_stack, STACK_SIZE,
+			   PREEMPT_PRIORITY, NULL);
+
+	rc = k_work_queue_worker_add(&pool_queue, &pool_worker,
+				     pool_worker_stack, STACK_SIZE,
+				     PREEMPT_PRIORITY, CONFIG_MP_NUM_CPUS);
+	zassert_equal(rc, -EINVAL, NULL);
+
+	rc = k_work_queue_worker_add(&pool_queue, &pool_worker,
+				     pool_worker_stack, STACK_SIZE,
+				     PREEMPT_PRIORITY, -1);
+	zassert_equal(rc, 0, NULL);
+}
+
+/* Two items submitted to a pool run in parallel. */
+static void test_pool_parallel(void)
+{
+	if (!IS_ENABLED(CONFIG_WORKQUEUE_POOL)) {
+		ztest_test_skip();
+		return;
+	}
+
+	atomic_set(&pool_ctr, 0);
+	atomic_set(&pool_overlaps, 0);
+	k_work_init(&work, pool_handler);
+	k_work_init(&work1, pool_handler);
+
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &work), 1, NULL);
+	zassert_equal(k_work_submit_to_queue(&pool_queue, &work1), 1, NULL);
+
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&work), K_WORK_RUNNING, NULL);
+	zassert_equal(k_work_busy_get(&work1), K_WORK_RUNNING, NULL);
+
+	zassert_true(k_work_flush(&work, &work_sync), NULL);
+	zassert_true(k_work_flush(&work1, &work_sync), NULL);
+	zassert_equal(atomic_get(&pool_ctr), 2, NULL);
+	zassert_equal(atomic_get(&pool_overlaps), 1, NULL);
+}
+
+/* An item resubmitted while it runs on one pool thread is not started
+ * by another, and flush waits for the resubmission to complete.
+ */
+static void test_pool_no_reentry(void)
+{
+	if (!IS_ENABLED(CONFIG_WORKQUEUE_POOL)) {
+		ztest_test_skip();
+		return;
+	}
+
+	int rc;
+
+	atomic_set(&pool_ctr, 0);
+	atomic_set(&pool_overlaps, 0);
+	k_work_init(&work, pool_handler);
+
+	rc = k_work_submit_to_queue(&pool_queue, &work);
+	zassert_equal(rc, 1, NULL);
+
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&work), K_WORK_RUNNING, NULL);
+
+	/* The other thread is idle, but must leave this alone. */
+	rc = k_work_submit_to_queue(&pool_queue, &work);
+	zassert_equal(rc, 2, NULL);
+
+	k_sleep(K_TICKS(1));
+	zassert_equal(k_work_busy_get(&work),
+		      K_WORK_RUNNING | K_WORK_QUEUED, NULL);
+
+	zassert_true(k_work_flush(&work, &work_sync), NULL);
+	zassert_equal(k_work_busy_get(&work), 0, NULL);
+	zassert_equal(atomic_get(&pool_ctr), 2, NULL);
+	zassert_equal(atomic_get(&pool_overlaps), 0, NULL);
+}
 
 static void test_nop(void)
 {
@@ -1601,6 +1708,9 @@ void test_main(void)
 			 ztest_1cpu_unit_test(
 				 test_1cpu_legacy_delayed_resubmit),
 			 ztest_1cpu_unit_test(test_1cpu_legacy_delayed_cancel),
+			 ztest_unit_test(test_pool_start),
+			 ztest_unit_test(test_pool_parallel),
+			 ztest_unit_test(test_pool_no_reentry),
 			 ztest_unit_test(test_nop));
 	ztest_run_test_suite(work);
 }
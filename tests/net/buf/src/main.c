@@ -70,6 +70,9 @@ static void var_destroy(struct net_buf *buf);
 NET_BUF_POOL_HEAP_DEFINE(bufs_pool, 10, USER_DATA_HEAP, buf_destroy);
 NET_BUF_POOL_FIXED_DEFINE(fixed_pool, 10, 128, USER_DATA_FIXED, fixed_destroy);
 NET_BUF_POOL_VAR_DEFINE(var_pool, 10, 1024, USER_DATA_VAR, var_destroy);
+NET_BUF_SHARED_HEAP_DEFINE(shared_heap, 2048, 768, 256);
+NET_BUF_POOL_ELASTIC_DEFINE(elastic_pool, 10, 512, shared_heap, USER_DATA_VAR,
+			    NULL);
 
 static void buf_destroy(struct net_buf *buf)
 {
@@ -461,6 +464,52 @@ static void test_net_buf_var_pool(void)
 	zassert_equal(destroy_called, 3, "Incorrect destroy callback count");
 }
 
+static void test_net_buf_elastic_pool(void)
+{
+	struct net_buf *buf1, *buf2, *buf3, *clone;
+
+	/* Fits into the reservation of the pool */
+	buf1 = net_buf_alloc_len(&elastic_pool, 200, K_NO_WAIT);
+	zassert_not_null(buf1, "Failed to get buffer");
+	zassert_equal(net_buf_pool_borrowed(&elastic_pool), 0,
+		      "Borrowed from the shared heap");
+
+	/* Does not fit anymore and is borrowed */
+	buf2 = net_buf_alloc_len(&elastic_pool, 400, K_NO_WAIT);
+	zassert_not_null(buf2, "Failed to borrow buffer");
+	zassert_true(net_buf_pool_borrowed(&elastic_pool) >= 400,
+		     "Not borrowed from the shared heap");
+	zassert_false(net_buf_shared_heap_pressure(&shared_heap),
+		      "Pressure below the high watermark");
+
+	buf3 = net_buf_alloc_len(&elastic_pool, 400, K_NO_WAIT);
+	zassert_not_null(buf3, "Failed to borrow buffer");
+	zassert_true(net_buf_shared_heap_pressure(&shared_heap),
+		     "No pressure above the high watermark");
+
+	/* The borrowed data is only returned with the last reference */
+	clone = net_buf_clone(buf2, K_NO_WAIT);
+	zassert_not_null(clone, "Failed to clone buffer");
+	zassert_equal(clone->data, buf2->data, "Cloned data doesn't match");
+
+	net_buf_unref(buf2);
+	net_buf_unref(clone);
+	zassert_true(net_buf_shared_heap_pressure(&shared_heap),
+		     "Pressure released above the low watermark");
+
+	net_buf_unref(buf3);
+	zassert_false(net_buf_shared_heap_pressure(&shared_heap),
+		      "Pressure not released below the low watermark");
+	zassert_equal(net_buf_pool_borrowed(&elastic_pool), 0,
+		      "Borrowed data not returned");
+	zassert_equal(shared_heap.used, 0, "Shared heap still in use");
+	zassert_equal(shared_heap.borrows, 2, "Wrong number of borrows");
+	zassert_equal(shared_heap.pressure_count, 1,
+		      "Wrong number of pressure periods");
+
+	net_buf_unref(buf1);
+}
+
 static void test_net_buf_byte_order(void)
 {
 	struct net_buf *buf;
@@ -734,6 +783,7 @@ void test_main(void)
 			 ztest_unit_test(test_net_buf_clone),
 			 ztest_unit_test(test_net_buf_fixed_pool),
 			 ztest_unit_test(test_net_buf_var_pool),
+			 ztest_unit_test(test_net_buf_elastic_pool),
 			 ztest_unit_test(test_net_buf_byte_order),
 			 ztest_unit_test(test_net_buf_user_data)
 			 );
@@ -0,0 +1,195 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <linker/sections.h>
+
+#include <ztest.h>
+
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "ipv6.h"
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+#define MY_PORT 4242
+#define PEER_PORT 4343
+
+/* Enough flows to have some in every queue */
+#define FLOW_COUNT 64
+
+#define ALLOC_TIMEOUT K_MSEC(500)
+
+static struct net_if *iface1;
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_iface1_test, "iface1", net_iface_dev_init, NULL, NULL,
+		NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &net_iface_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static void test_setup(void)
+{
+	iface1 = net_if_get_default();
+	zassert_not_null(iface1, "Interface");
+}
+
+/* Build an UDP packet, or an IPv4 fragment with a fragment offset */
+static struct net_pkt *build_pkt(sa_family_t family, uint16_t src_port,
+				 uint16_t frag_offset)
+{
+	struct net_udp_hdr udp_hdr = { 0 };
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, 64, family, IPPROTO_UDP,
+					ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	if (family == AF_INET) {
+		ret = net_ipv4_create(pkt, &my_addr, &peer_addr);
+	} else {
+		ret = net_ipv6_create(pkt, &my_addr6, &peer_addr6);
+	}
+
+	zassert_equal(ret, 0, "Cannot create IP header");
+
+	udp_hdr.src_port = htons(src_port);
+	udp_hdr.dst_port = htons(PEER_PORT);
+
+	ret = net_pkt_write(pkt, &udp_hdr, sizeof(udp_hdr));
+	zassert_equal(ret, 0, "Cannot append UDP header");
+
+	if (frag_offset) {
+		struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+
+		hdr->offset[0] = frag_offset >> 8;
+		hdr->offset[1] = frag_offset;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static uint8_t rx_queue_of(sa_family_t family, uint16_t src_port,
+			   uint16_t frag_offset)
+{
+	struct net_pkt *pkt = build_pkt(family, src_port, frag_offset);
+	struct net_pkt_cursor backup;
+	uint8_t queue;
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	queue = net_rx_flow2queue(pkt);
+
+	zassert_equal(pkt->cursor.buf, backup.buf, "Cursor moved");
+	zassert_equal(pkt->cursor.pos, backup.pos, "Cursor moved");
+	zassert_true(queue < NET_TC_RX_COUNT, "Invalid queue %d", queue);
+
+	zassert_equal(net_tx_flow2queue(pkt), queue,
+		      "RX and TX hash differ");
+
+	net_pkt_unref(pkt);
+
+	return queue;
+}
+
+static void test_flow_same_queue(void)
+{
+	sa_family_t families[] = { AF_INET, AF_INET6 };
+
+	for (int i = 0; i < ARRAY_SIZE(families); i++) {
+		uint8_t queue = rx_queue_of(families[i], MY_PORT, 0);
+
+		for (int j = 0; j < 4; j++) {
+			zassert_equal(rx_queue_of(families[i], MY_PORT, 0),
+				      queue, "Flow changed queue");
+		}
+	}
+}
+
+static void test_flow_spread(void)
+{
+	sa_family_t families[] = { AF_INET, AF_INET6 };
+
+	for (int i = 0; i < ARRAY_SIZE(families); i++) {
+		int count[NET_TC_RX_COUNT] = { 0 };
+
+		for (int j = 0; j < FLOW_COUNT; j++) {
+			count[rx_queue_of(families[i], MY_PORT + j, 0)]++;
+		}
+
+		for (int j = 0; j < NET_TC_RX_COUNT; j++) {
+			zassert_true(count[j] > 0, "Queue %d not used", j);
+		}
+	}
+}
+
+static void test_flow_fragments(void)
+{
+	/* The first fragment has the more fragments flag set, the other ones
+	 * have an offset and no UDP header, all go to the same queue.
+	 */
+	uint8_t queue = rx_queue_of(AF_INET, MY_PORT, 0x2000);
+
+	zassert_equal(rx_queue_of(AF_INET, MY_PORT + 1, 0x2000), queue,
+		      "Fragment changed queue");
+	zassert_equal(rx_queue_of(AF_INET, MY_PORT + 2, 0x0010), queue,
+		      "Fragment changed queue");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_flow_queues_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_flow_same_queue),
+			 ztest_unit_test(test_flow_spread),
+			 ztest_unit_test(test_flow_fragments));
+
+	ztest_run_test_suite(net_flow_queues_test);
+}
@@ -0,0 +1,557 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+#include <linker/sections.h>
+#include <random/rand32.h>
+
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "icmpv4.h"
+#include "udp_internal.h"
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+#define MY_PORT 4242
+#define PEER_PORT 4343
+
+#define IFACE_MTU 127
+
+#define WAIT_TIME K_SECONDS(1)
+
+#define ALLOC_TIMEOUT K_MSEC(500)
+
+struct net_if_test {
+	uint8_t mac_addr[sizeof(struct net_eth_addr)];
+};
+
+enum net_test_type {
+	NO_TEST_TYPE,
+	IPV4_SEND_FRAG,
+	IPV4_REASSEMBLY_TIMEOUT,
+};
+
+static enum net_test_type test_type = NO_TEST_TYPE;
+
+static struct net_if *iface1;
+
+static bool test_failed;
+static struct k_sem wait_data;
+
+static int frag_count;
+static uint16_t frag_id;
+static uint16_t frag_next_offset;
+static uint16_t pkt_data_len;
+
+static uint8_t payload[300];
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static uint8_t *net_iface_get_mac(const struct device *dev)
+{
+	struct net_if_test *data = dev->data;
+
+	if (data->mac_addr[2] == 0x00) {
+		/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+		data->mac_addr[0] = 0x00;
+		data->mac_addr[1] = 0x00;
+		data->mac_addr[2] = 0x5E;
+		data->mac_addr[3] = 0x00;
+		data->mac_addr[4] = 0x53;
+		data->mac_addr[5] = sys_rand32_get();
+	}
+
+	return data->mac_addr;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	uint8_t *mac = net_iface_get_mac(net_if_get_device(iface));
+
+	net_if_set_link_addr(iface, mac, sizeof(struct net_eth_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int verify_fragment(struct net_pkt *pkt)
+{
+	struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+	uint16_t flags = (hdr->offset[0] << 8) | hdr->offset[1];
+	uint16_t id = (hdr->id[0] << 8) | hdr->id[1];
+	uint16_t len = ntohs(hdr->len);
+	uint16_t hdr_len = (hdr->vhl & NET_IPV4_IHL_MASK) * 4U;
+
+	frag_count++;
+
+	NET_DBG("frag %d id 0x%04x flags 0x%04x len %d", frag_count, id,
+		flags, len);
+
+	if (len != net_pkt_get_len(pkt) || len > IFACE_MTU) {
+		NET_DBG("Invalid fragment length %d", len);
+		return -EINVAL;
+	}
+
+	if (net_calc_chksum_ipv4(pkt) != 0U) {
+		NET_DBG("Invalid header checksum");
+		return -EINVAL;
+	}
+
+	if (frag_count == 1) {
+		frag_id = id;
+	} else if (id != frag_id) {
+		NET_DBG("Fragment id 0x%04x, expected 0x%04x", id, frag_id);
+		return -EINVAL;
+	}
+
+	if ((flags & NET_IPV4_FRAGH_OFFSET_MASK) * 8U != frag_next_offset) {
+		NET_DBG("Fragment offset %d, expected %d",
+			(flags & NET_IPV4_FRAGH_OFFSET_MASK) * 8U,
+			frag_next_offset);
+		return -EINVAL;
+	}
+
+	frag_next_offset += len - hdr_len;
+
+	if (flags & NET_IPV4_FRAGH_MF_MASK) {
+		if ((len - hdr_len) % 8U) {
+			NET_DBG("Fragment length is not multiple of 8");
+			return -EINVAL;
+		}
+	} else if (frag_next_offset != sizeof(struct net_udp_hdr) +
+		   pkt_data_len) {
+		NET_DBG("Last fragment ends at %d, expected %zd",
+			frag_next_offset,
+			sizeof(struct net_udp_hdr) + pkt_data_len);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int verify_time_exceeded(struct net_pkt *pkt)
+{
+	struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+	struct net_icmp_hdr *icmp_hdr;
+
+	if (hdr->proto != IPPROTO_ICMP) {
+		return -EINVAL;
+	}
+
+	icmp_hdr = (struct net_icmp_hdr *)((uint8_t *)hdr +
+					   sizeof(struct net_ipv4_hdr));
+
+	if (icmp_hdr->type != NET_ICMPV4_TIME_EXCEEDED ||
+	    icmp_hdr->code != NET_ICMPV4_TIME_EXCEEDED_REASSEMBLY) {
+		NET_DBG("Unexpected ICMPv4 type %d code %d", icmp_hdr->type,
+			icmp_hdr->code);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	int ret = 0;
+
+	if (!pkt->buffer) {
+		NET_DBG("No data to send!");
+		return -ENODATA;
+	}
+
+	switch (test_type) {
+	case IPV4_SEND_FRAG:
+		ret = verify_fragment(pkt);
+		break;
+	case IPV4_REASSEMBLY_TIMEOUT:
+		ret = verify_time_exceeded(pkt);
+		break;
+	default:
+		goto out;
+	}
+
+	if (ret < 0) {
+		test_failed = true;
+	} else {
+		k_sem_give(&wait_data);
+	}
+
+out:
+	net_pkt_unref(pkt);
+
+	return 0;
+}
+
+struct net_if_test net_iface1_data;
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+#define _ETH_L2_LAYER DUMMY_L2
+#define _ETH_L2_CTX_TYPE NET_L2_GET_CTX_TYPE(DUMMY_L2)
+
+NET_DEVICE_INIT_INSTANCE(net_iface1_test,
+			 "iface1",
+			 iface1,
+			 net_iface_dev_init,
+			 NULL,
+			 &net_iface1_data,
+			 NULL,
+			 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+			 &net_iface_api,
+			 _ETH_L2_LAYER,
+			 _ETH_L2_CTX_TYPE,
+			 IFACE_MTU);
+
+static enum net_verdict udp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	uint8_t data;
+	int i;
+
+	NET_DBG("Data %p received", pkt);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_get_len(pkt) != NET_IPV4UDPH_LEN + pkt_data_len ||
+	    net_pkt_skip(pkt, NET_IPV4UDPH_LEN)) {
+		NET_DBG("Invalid reassembled length %zd",
+			net_pkt_get_len(pkt));
+		test_failed = true;
+		goto out;
+	}
+
+	for (i = 0; i < pkt_data_len; i++) {
+		if (net_pkt_read_u8(pkt, &data) || data != payload[i]) {
+			NET_DBG("Invalid data at offset %d", i);
+			test_failed = true;
+			goto out;
+		}
+	}
+
+	k_sem_give(&wait_data);
+
+out:
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static void setup_udp_handler(void)
+{
+	static struct net_conn_handle *handle;
+	struct sockaddr remote_addr = { 0 };
+	struct sockaddr local_addr = { 0 };
+	int ret;
+
+	net_ipaddr_copy(&net_sin(&local_addr)->sin_addr, &my_addr);
+	local_addr.sa_family = AF_INET;
+
+	net_ipaddr_copy(&net_sin(&remote_addr)->sin_addr, &peer_addr);
+	remote_addr.sa_family = AF_INET;
+
+	ret = net_udp_register(AF_INET, &remote_addr, &local_addr,
+			       PEER_PORT, MY_PORT, NULL, udp_data_received,
+			       NULL, &handle);
+	zassert_equal(ret, 0, "Cannot register UDP handler");
+}
+
+static void test_setup(void)
+{
+	struct net_if_addr *ifaddr;
+	int i;
+
+	k_sem_init(&wait_data, 0, UINT_MAX);
+
+	iface1 = net_if_get_by_index(1);
+	zassert_not_null(iface1, "Interface 1");
+
+	ifaddr = net_if_ipv4_addr_add(iface1, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	net_if_up(iface1);
+
+	setup_udp_handler();
+
+	for (i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+
+	pkt_data_len = sizeof(payload);
+}
+
+static struct net_pkt *build_udp_pkt(const struct in_addr *src,
+				     const struct in_addr *dst,
+				     uint8_t flags)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, pkt_data_len, AF_INET,
+					IPPROTO_UDP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	ret = net_ipv4_create_full(pkt, src, dst, 0U, 0U, flags, 0U, 0U);
+	zassert_equal(ret, 0, "Cannot create IPv4 header");
+
+	ret = net_udp_create(pkt, htons(MY_PORT), htons(PEER_PORT));
+	zassert_equal(ret, 0, "Cannot create UDP header");
+
+	ret = net_pkt_write(pkt, payload, pkt_data_len);
+	zassert_equal(ret, 0, "Cannot append data");
+
+	net_pkt_cursor_init(pkt);
+	ret = net_ipv4_finalize(pkt, IPPROTO_UDP);
+	zassert_equal(ret, 0, "Cannot finalize packet");
+
+	return pkt;
+}
+
+static void test_send_ipv4_fragment(void)
+{
+	struct net_pkt *pkt;
+	int expected, i, ret;
+
+	/* Payload per fragment is rounded down to 8 byte units */
+	expected = DIV_ROUND_UP(sizeof(struct net_udp_hdr) + pkt_data_len,
+				(IFACE_MTU - NET_IPV4H_LEN) & ~7);
+
+	test_type = IPV4_SEND_FRAG;
+	test_failed = false;
+	frag_count = 0;
+	frag_next_offset = 0U;
+
+	pkt = build_udp_pkt(&my_addr, &peer_addr, 0U);
+
+	ret = net_send_data(pkt);
+	zassert_equal(ret, 0, "Cannot send test packet (%d)", ret);
+
+	for (i = 0; i < expected; i++) {
+		zassert_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+			      "Timeout while waiting fragment %d", i);
+	}
+
+	zassert_false(test_failed, "Fragment verify failed");
+	zassert_equal(frag_count, expected, "Sent %d fragments, expected %d",
+		      frag_count, expected);
+
+	test_type = NO_TEST_TYPE;
+}
+
+static void test_send_ipv4_dont_fragment(void)
+{
+	struct net_pkt *pkt;
+
+	test_type = IPV4_SEND_FRAG;
+	test_failed = false;
+	frag_count = 0;
+	frag_next_offset = 0U;
+
+	pkt = build_udp_pkt(&my_addr, &peer_addr, NET_IPV4_DF);
+
+	(void)net_send_data(pkt);
+
+	zassert_not_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+			  "Packet with DF set was fragmented");
+	zassert_equal(frag_count, 0, "Packet with DF set was sent");
+
+	test_type = NO_TEST_TYPE;
+}
+
+/* Create a fragment of the UDP packet built from payload[], offset and
+ * len are relative to the start of the UDP header.
+ */
+static struct net_pkt *build_fragment(uint16_t id, uint16_t offset,
+				      uint16_t len, bool more)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_udp_hdr udp_hdr;
+	struct net_ipv4_hdr *hdr;
+	struct net_pkt *pkt;
+	uint16_t udp_len;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, len, AF_INET, 0,
+					ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	ret = net_ipv4_create_full(pkt, &peer_addr, &my_addr, 0U, id,
+				   more ? NET_IPV4_MF : 0U, offset / 8U, 0U);
+	zassert_equal(ret, 0, "Cannot create IPv4 header");
+
+	if (offset == 0U) {
+		udp_len = sizeof(struct net_udp_hdr) + pkt_data_len;
+
+		udp_hdr.src_port = htons(PEER_PORT);
+		udp_hdr.dst_port = htons(MY_PORT);
+		udp_hdr.len = htons(udp_len);
+		udp_hdr.chksum = 0U;
+
+		ret = net_pkt_write(pkt, &udp_hdr, sizeof(udp_hdr));
+		zassert_equal(ret, 0, "Cannot append UDP header");
+
+		len -= sizeof(udp_hdr);
+	} else {
+		offset -= sizeof(udp_hdr);
+	}
+
+	ret = net_pkt_write(pkt, payload + offset, len);
+	zassert_equal(ret, 0, "Cannot append data");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	zassert_not_null(hdr, "IPv4 header");
+
+	hdr->len = htons(net_pkt_get_len(pkt));
+	hdr->proto = IPPROTO_UDP;
+
+	net_pkt_set_data(pkt, &ipv4_access);
+
+	NET_IPV4_HDR(pkt)->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_cursor_init(pkt);
+
+	return pkt;
+}
+
+static enum net_verdict recv_fragment(uint16_t id, uint16_t offset,
+				      uint16_t len, bool more)
+{
+	struct net_pkt *pkt = build_fragment(id, offset, len, more);
+	enum net_verdict verdict;
+
+	verdict = net_ipv4_input(pkt);
+	if (verdict == NET_DROP) {
+		net_pkt_unref(pkt);
+	}
+
+	return verdict;
+}
+
+static void test_recv_ipv4_fragment(void)
+{
+	uint16_t total = sizeof(struct net_udp_hdr) + pkt_data_len;
+
+	test_failed = false;
+
+	zassert_equal(recv_fragment(0x1234, 0U, 160U, true), NET_OK,
+		      "Fragment 1 not accepted");
+	zassert_equal(recv_fragment(0x1234, 160U, total - 160U, false),
+		      NET_OK, "Fragment 2 not accepted");
+
+	zassert_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+		      "Reassembled packet not received");
+	zassert_false(test_failed, "Reassembled packet is corrupted");
+}
+
+static void test_recv_ipv4_fragment_reverse(void)
+{
+	uint16_t total = sizeof(struct net_udp_hdr) + pkt_data_len;
+
+	test_failed = false;
+
+	zassert_equal(recv_fragment(0x1235, 208U, total - 208U, false),
+		      NET_OK, "Fragment 3 not accepted");
+	zassert_equal(recv_fragment(0x1235, 104U, 104U, true), NET_OK,
+		      "Fragment 2 not accepted");
+	zassert_equal(recv_fragment(0x1235, 0U, 104U, true), NET_OK,
+		      "Fragment 1 not accepted");
+
+	zassert_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+		      "Reassembled packet not received");
+	zassert_false(test_failed, "Reassembled packet is corrupted");
+}
+
+static void test_recv_ipv4_fragment_overlap(void)
+{
+	uint16_t total = sizeof(struct net_udp_hdr) + pkt_data_len;
+
+	zassert_equal(recv_fragment(0x1236, 0U, 160U, true), NET_OK,
+		      "Fragment 1 not accepted");
+	zassert_equal(recv_fragment(0x1236, 152U, total - 152U, false),
+		      NET_DROP, "Overlapping fragment accepted");
+
+	zassert_not_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+			  "Overlapping fragments were reassembled");
+
+	/* The whole reassembly is dropped, so the missing part alone
+	 * must not complete it.
+	 */
+	zassert_equal(recv_fragment(0x1236, 160U, total - 160U, false),
+		      NET_OK, "Fragment 2 not accepted");
+	zassert_not_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+			  "Dropped reassembly was completed");
+}
+
+static void test_recv_ipv4_fragment_bad_length(void)
+{
+	/* All but the last fragment must be a multiple of 8 bytes */
+	zassert_equal(recv_fragment(0x1237, 0U, 100U, true), NET_DROP,
+		      "Fragment with bad length accepted");
+}
+
+static void test_recv_ipv4_fragment_timeout(void)
+{
+	test_type = IPV4_REASSEMBLY_TIMEOUT;
+	test_failed = false;
+
+	zassert_equal(recv_fragment(0x1238, 0U, 160U, true), NET_OK,
+		      "Fragment 1 not accepted");
+
+	/* Wait for the earlier reassemblies to time out too */
+	zassert_equal(k_sem_take(&wait_data,
+				 K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT + 1)),
+		      0, "Time exceeded message not sent");
+	zassert_false(test_failed, "Invalid time exceeded message");
+
+	test_type = NO_TEST_TYPE;
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_ipv4_fragment_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_send_ipv4_fragment),
+			 ztest_unit_test(test_send_ipv4_dont_fragment),
+			 ztest_unit_test(test_recv_ipv4_fragment),
+			 ztest_unit_test(test_recv_ipv4_fragment_reverse),
+			 ztest_unit_test(test_recv_ipv4_fragment_overlap),
+			 ztest_unit_test(test_recv_ipv4_fragment_bad_length),
+			 ztest_unit_test(test_recv_ipv4_fragment_timeout)
+			 );
+
+	ztest_run_test_suite(net_ipv4_fragment_test);
+}
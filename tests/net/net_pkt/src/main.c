@@ -1061,6 +1061,120 @@ void test_net_pkt_remove_tail(void)
 	net_pkt_unref(pkt);
 }
 
+#if defined(CONFIG_NET_PKT_LATENCY_TRACE)
+struct trace_lookup {
+	uintptr_t pkt;
+	struct net_pkt_trace_record rec;
+	int found;
+};
+
+static void trace_lookup_cb(const struct net_pkt_trace_record *rec,
+			    void *user_data)
+{
+	struct trace_lookup *lookup = user_data;
+
+	if (rec->pkt == lookup->pkt && !rec->tx) {
+		lookup->rec = *rec;
+		lookup->found++;
+	}
+}
+
+static uint32_t trace_hist_count(bool tx, enum net_pkt_trace_stage stage)
+{
+	uint32_t buckets[NET_PKT_TRACE_HIST_BUCKETS];
+	uint32_t count = 0U;
+	int i;
+
+	net_pkt_trace_hist_get(tx, stage, buckets);
+
+	for (i = 0; i < NET_PKT_TRACE_HIST_BUCKETS; i++) {
+		count += buckets[i];
+	}
+
+	return count;
+}
+
+void test_net_pkt_latency_trace(void)
+{
+	struct trace_lookup lookup = { 0 };
+	uint32_t total_before, transport_before;
+	struct net_pkt *pkt, *clone;
+	uint32_t sum = 0U;
+	int i;
+
+	pkt = net_pkt_rx_alloc_with_buffer(eth_if, 64, AF_UNSPEC, 0,
+					   K_NO_WAIT);
+	zassert_true(pkt != NULL, "Pkt not allocated");
+
+	total_before = trace_hist_count(false, 0);
+	transport_before = trace_hist_count(false,
+					    NET_PKT_TRACE_RX_TRANSPORT);
+
+	/* The transport stage is not passed */
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_DRIVER);
+	k_busy_wait(10);
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_L2);
+	k_busy_wait(10);
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_IP);
+	k_busy_wait(10);
+	net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_SOCKET);
+	k_busy_wait(200);
+
+	clone = net_pkt_clone(pkt, K_NO_WAIT);
+	zassert_true(clone != NULL, "Pkt not cloned");
+	zassert_mem_equal(clone->trace, pkt->trace, sizeof(pkt->trace),
+			  "Trace stages not cloned");
+	net_pkt_unref(clone);
+
+	net_pkt_trace_done(pkt, false);
+
+	for (i = 0; i < NET_PKT_TRACE_STAGES; i++) {
+		zassert_equal(pkt->trace[i], 0U, "Trace stages not reset");
+	}
+
+	lookup.pkt = (uintptr_t)pkt;
+	net_pkt_trace_foreach(trace_lookup_cb, &lookup);
+	zassert_equal(lookup.found, 1, "Record not in the trace ring");
+
+	zassert_equal(lookup.rec.stage_ns[NET_PKT_TRACE_RX_DRIVER], 0U,
+		      "First stage has no latency");
+	zassert_equal(lookup.rec.stage_ns[NET_PKT_TRACE_RX_TRANSPORT], 0U,
+		      "Skipped stage has latency");
+	zassert_true(lookup.rec.stage_ns[NET_PKT_TRACE_RX_APP] >=
+		     100 * NSEC_PER_USEC, "Socket queue wait too short");
+
+	for (i = 0; i < NET_PKT_TRACE_STAGES; i++) {
+		sum += lookup.rec.stage_ns[i];
+	}
+
+	zassert_true(lookup.rec.total_ns >= sum, "Total below stage sum");
+
+	zassert_equal(trace_hist_count(false, 0), total_before + 1,
+		      "Total not in histogram");
+	zassert_equal(trace_hist_count(false, NET_PKT_TRACE_RX_TRANSPORT),
+		      transport_before, "Skipped stage in histogram");
+
+	/* The ring keeps only the latest records */
+	for (i = 0; i < CONFIG_NET_PKT_LATENCY_TRACE_RING_SIZE; i++) {
+		net_pkt_trace_set(pkt, NET_PKT_TRACE_RX_DRIVER);
+		net_pkt_trace_done(pkt, true);
+	}
+
+	lookup.found = 0;
+	zassert_equal(net_pkt_trace_foreach(trace_lookup_cb, &lookup),
+		      CONFIG_NET_PKT_LATENCY_TRACE_RING_SIZE,
+		      "Ring not full");
+	zassert_equal(lookup.found, 0, "Oldest record not overwritten");
+
+	net_pkt_unref(pkt);
+}
+#else
+void test_net_pkt_latency_trace(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_PKT_LATENCY_TRACE */
+
 void test_main(void)
 {
 	eth_if = net_if_get_default();
@@ -1077,7 +1191,8 @@ void test_main(void)
 			 ztest_unit_test(test_net_pkt_headroom),
 			 ztest_unit_test(test_net_pkt_headroom_copy),
 			 ztest_unit_test(test_net_pkt_get_contiguous_len),
-			 ztest_unit_test(test_net_pkt_remove_tail)
+			 ztest_unit_test(test_net_pkt_remove_tail),
+			 ztest_unit_test(test_net_pkt_latency_trace)
 		);
 
 	ztest_run_test_suite(net_pkt_tests);
@@ -544,6 +544,82 @@ static void test_route_preference(void)
 	net_route_del(entry);
 }
 
+static void count_routes(struct net_route_entry *entry, void *user_data)
+{
+	int *count = user_data;
+
+	(*count)++;
+}
+
+static void test_route_longest_prefix(void)
+{
+	struct net_route_entry *prefix_route, *host_route, *found;
+	int count = 0, count_again = 0;
+
+	prefix_route = net_route_add(my_iface,
+				     &generic_addr, 64,
+				     &peer_addr,
+				     NET_IPV6_ND_INFINITE_LIFETIME,
+				     NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(prefix_route, "Prefix route add failed");
+
+	host_route = net_route_add(my_iface,
+				   &dest_addr, 128,
+				   &peer_addr,
+				   NET_IPV6_ND_INFINITE_LIFETIME,
+				   NET_ROUTE_PREFERENCE_LOW);
+	zassert_not_null(host_route, "Host route add failed");
+	zassert_not_equal(host_route, prefix_route,
+			  "Host route replaced prefix route");
+
+	net_route_foreach(count_routes, &count);
+
+	/* Adding the routes again must update them, not add new ones. The
+	 * longest match for the host address is the host route, which must
+	 * not hide the prefix route with the same address.
+	 */
+	found = net_route_add(my_iface,
+			      &dest_addr, 128,
+			      &peer_addr,
+			      NET_IPV6_ND_INFINITE_LIFETIME,
+			      NET_ROUTE_PREFERENCE_LOW);
+	zassert_equal_ptr(found, host_route, "Host route added twice");
+
+	found = net_route_add(my_iface,
+			      &dest_addr, 64,
+			      &peer_addr,
+			      NET_IPV6_ND_INFINITE_LIFETIME,
+			      NET_ROUTE_PREFERENCE_LOW);
+	zassert_equal_ptr(found, prefix_route, "Prefix route added twice");
+
+	net_route_foreach(count_routes, &count_again);
+	zassert_equal(count_again, count, "%d routes, expected %d",
+		      count_again, count);
+
+	found = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(found, host_route, "Host route not found");
+
+	found = net_route_lookup(my_iface, &generic_addr);
+	zassert_equal_ptr(found, prefix_route, "Prefix route not found");
+
+	found = net_route_lookup(my_iface, &ll_addr);
+	zassert_is_null(found, "Route found for unrouted address");
+
+	found = net_route_lookup(peer_iface, &dest_addr);
+	zassert_is_null(found, "Route found for other interface");
+
+	zassert_equal(net_route_del(host_route), 0, "Host route del failed");
+
+	found = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(found, prefix_route,
+			  "Prefix route not found after host route del");
+
+	zassert_equal(net_route_del(prefix_route), 0,
+		      "Prefix route del failed");
+
+	found = net_route_lookup(my_iface, &dest_addr);
+	zassert_is_null(found, "Route found after del");
+}
 
 /*test case main entry*/
 void test_main(void)
@@ -566,6 +642,7 @@ void test_main(void)
 			ztest_unit_test(test_route_add_many),
 			ztest_unit_test(test_route_del_many),
 			ztest_unit_test(test_route_lifetime),
-			ztest_unit_test(test_route_preference));
+			ztest_unit_test(test_route_preference),
+			ztest_unit_test(test_route_longest_prefix));
 	ztest_run_test_suite(test_route);
 }
@@ -0,0 +1,192 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_ROUTE_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <linker/sections.h>
+
+#include <ztest.h>
+
+#include <net/dummy.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+#include "route.h"
+
+static struct in_addr net_10 = { { { 10, 0, 0, 0 } } };
+static struct in_addr net_10_1 = { { { 10, 1, 0, 0 } } };
+static struct in_addr host_10_1 = { { { 10, 1, 2, 3 } } };
+static struct in_addr host_10_2 = { { { 10, 2, 0, 1 } } };
+static struct in_addr host_other = { { { 198, 51, 100, 1 } } };
+static struct in_addr gw_a = { { { 192, 0, 2, 1 } } };
+static struct in_addr gw_b = { { { 192, 0, 2, 2 } } };
+static struct in_addr any_addr = { { { 0, 0, 0, 0 } } };
+
+static struct net_if *iface1;
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_iface1_test, "iface1", net_iface_dev_init, NULL, NULL,
+		NULL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &net_iface_api,
+		DUMMY_L2, NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static void test_setup(void)
+{
+	iface1 = net_if_get_default();
+	zassert_not_null(iface1, "Interface");
+}
+
+static void route_cb(struct net_route_entry_ipv4 *entry, void *user_data)
+{
+	zassert_equal(entry->iface, iface1, "Wrong interface");
+}
+
+static void test_route_longest_prefix(void)
+{
+	struct net_route_entry_ipv4 *wide, *narrow, *found;
+
+	wide = net_route_ipv4_add(iface1, &net_10, 8, &gw_a);
+	zassert_not_null(wide, "Route add failed");
+
+	narrow = net_route_ipv4_add(iface1, &net_10_1, 16, &gw_b);
+	zassert_not_null(narrow, "Route add failed");
+	zassert_not_equal(wide, narrow, "Same route entry");
+
+	found = net_route_ipv4_lookup(iface1, &host_10_1);
+	zassert_equal_ptr(found, narrow, "Longest prefix not found");
+
+	found = net_route_ipv4_lookup(iface1, &host_10_2);
+	zassert_equal_ptr(found, wide, "Shorter prefix not found");
+
+	found = net_route_ipv4_lookup(NULL, &host_10_2);
+	zassert_equal_ptr(found, wide, "Route not found on any interface");
+
+	found = net_route_ipv4_lookup(iface1, &host_other);
+	zassert_is_null(found, "Route found for unrouted address");
+
+	zassert_equal(net_route_ipv4_foreach(route_cb, NULL), 2,
+		      "Wrong number of routes");
+}
+
+static void test_route_nexthop(void)
+{
+	struct net_route_entry_ipv4 *route;
+	struct in_addr nexthop;
+
+	zassert_true(net_route_ipv4_get_nexthop(iface1, &host_10_1, &nexthop),
+		     "No nexthop");
+	zassert_true(net_ipv4_addr_cmp(&nexthop, &gw_b), "Wrong nexthop");
+
+	/* Adding the same prefix again updates the gateway */
+	route = net_route_ipv4_add(iface1, &net_10_1, 16, &gw_a);
+	zassert_equal_ptr(route, net_route_ipv4_lookup(iface1, &host_10_1),
+			  "Route was not updated in place");
+
+	zassert_true(net_route_ipv4_get_nexthop(iface1, &host_10_1, &nexthop),
+		     "No nexthop");
+	zassert_true(net_ipv4_addr_cmp(&nexthop, &gw_a), "Wrong nexthop");
+
+	/* An on-link route has the destination as the nexthop */
+	route = net_route_ipv4_add(iface1, &net_10_1, 16, &any_addr);
+	zassert_not_null(route, "Route add failed");
+
+	zassert_true(net_route_ipv4_get_nexthop(iface1, &host_10_1, &nexthop),
+		     "No nexthop");
+	zassert_true(net_ipv4_addr_cmp(&nexthop, &host_10_1),
+		     "Wrong on-link nexthop");
+
+	zassert_false(net_route_ipv4_get_nexthop(iface1, &host_other,
+						 &nexthop),
+		      "Nexthop for unrouted address");
+}
+
+static void test_route_del(void)
+{
+	struct net_route_entry_ipv4 *wide, *narrow;
+
+	narrow = net_route_ipv4_lookup(iface1, &host_10_1);
+	zassert_not_null(narrow, "Route not found");
+
+	zassert_equal(net_route_ipv4_del(narrow), 0, "Route del failed");
+	zassert_equal(net_route_ipv4_del(narrow), -ENOENT,
+		      "Route del again succeeded");
+
+	wide = net_route_ipv4_lookup(iface1, &host_10_1);
+	zassert_not_null(wide, "Shorter prefix not found after del");
+	zassert_equal(wide->prefix_len, 8, "Wrong route found");
+
+	zassert_equal(net_route_ipv4_del(wide), 0, "Route del failed");
+
+	zassert_is_null(net_route_ipv4_lookup(iface1, &host_10_1),
+			"Route found after del");
+}
+
+static void test_route_table_full(void)
+{
+	struct net_route_entry_ipv4 *routes[CONFIG_NET_MAX_IPV4_ROUTES];
+	struct in_addr addr = { { { 10, 0, 0, 0 } } };
+	int i;
+
+	for (i = 0; i < CONFIG_NET_MAX_IPV4_ROUTES; i++) {
+		addr.s4_addr[1] = i;
+		routes[i] = net_route_ipv4_add(iface1, &addr, 16, &gw_a);
+		zassert_not_null(routes[i], "Route %d add failed", i);
+	}
+
+	addr.s4_addr[1] = i;
+	zassert_is_null(net_route_ipv4_add(iface1, &addr, 16, &gw_a),
+			"Route added to a full table");
+
+	for (i = 0; i < CONFIG_NET_MAX_IPV4_ROUTES; i++) {
+		zassert_equal(net_route_ipv4_del(routes[i]), 0,
+			      "Route %d del failed", i);
+	}
+
+	zassert_equal(net_route_ipv4_foreach(route_cb, NULL), 0,
+		      "Routes left in table");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_route_ipv4_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_route_longest_prefix),
+			 ztest_unit_test(test_route_nexthop),
+			 ztest_unit_test(test_route_del),
+			 ztest_unit_test(test_route_table_full));
+
+	ztest_run_test_suite(net_route_ipv4_test);
+}
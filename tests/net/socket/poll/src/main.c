@@ -175,10 +175,130 @@ void test_poll(void)
 	zassert_equal(res, 0, "close failed");
 }
 
+void test_epoll(void)
+{
+	int res;
+	int epfd;
+	int c_sock;
+	int s_sock;
+	struct sockaddr_in6 c_addr;
+	struct sockaddr_in6 s_addr;
+	struct epoll_event ev;
+	struct epoll_event events[2];
+	ssize_t len;
+	char buf[10];
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &c_sock, &c_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_addr);
+
+	res = bind(s_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "bind failed");
+	res = bind(c_sock, (struct sockaddr *)&c_addr, sizeof(c_addr));
+	zassert_equal(res, 0, "bind failed");
+	res = connect(c_sock, (struct sockaddr *)&s_addr, sizeof(s_addr));
+	zassert_equal(res, 0, "connect failed");
+
+	epfd = epoll_create1(0);
+	zassert_true(epfd >= 0, "epoll_create1 failed");
+
+	/* s_sock is level triggered, c_sock edge triggered */
+	ev.events = EPOLLIN;
+	ev.data.fd = s_sock;
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, s_sock, &ev);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, EEXIST, "");
+
+	ev.events = EPOLLIN | EPOLLET;
+	ev.data.fd = c_sock;
+	res = epoll_ctl(epfd, EPOLL_CTL_ADD, c_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Level triggered: reported until the data is read */
+	len = send(c_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+	zassert_equal(events[0].events, EPOLLIN, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+
+	len = recv(s_sock, BUF_AND_SIZE(buf), 0);
+	zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Edge triggered: reported once per received datagram */
+	for (int i = 0; i < 2; i++) {
+		len = sendto(s_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+			     (struct sockaddr *)&c_addr, sizeof(c_addr));
+		zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid send len");
+
+		res = epoll_wait(epfd, events, ARRAY_SIZE(events), 100);
+		zassert_equal(res, 1, "");
+		zassert_equal(events[0].data.fd, c_sock, "");
+		zassert_equal(events[0].events, EPOLLIN, "");
+
+		res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+		zassert_equal(res, 0, "");
+	}
+
+	for (int i = 0; i < 2; i++) {
+		len = recv(c_sock, BUF_AND_SIZE(buf), 0);
+		zassert_equal(len, STRLEN(TEST_STR_SMALL), "invalid recv len");
+	}
+
+	/* Sockets are always writable */
+	ev.events = EPOLLOUT;
+	ev.data.fd = s_sock;
+	res = epoll_ctl(epfd, EPOLL_CTL_MOD, s_sock, &ev);
+	zassert_equal(res, 0, "epoll_ctl failed");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 1, "");
+	zassert_equal(events[0].data.fd, s_sock, "");
+	zassert_equal(events[0].events, EPOLLOUT, "");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, 0, "epoll_ctl failed");
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, s_sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = epoll_wait(epfd, events, ARRAY_SIZE(events), 0);
+	zassert_equal(res, 0, "");
+
+	/* Closed sockets are removed from the epoll instance */
+	res = close(c_sock);
+	zassert_equal(res, 0, "close failed");
+
+	res = epoll_ctl(epfd, EPOLL_CTL_DEL, c_sock, NULL);
+	zassert_equal(res, -1, "");
+	zassert_equal(errno, ENOENT, "");
+
+	res = close(epfd);
+	zassert_equal(res, 0, "close failed");
+
+	res = close(s_sock);
+	zassert_equal(res, 0, "close failed");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(socket_poll,
-			 ztest_unit_test(test_poll));
+			 ztest_unit_test(test_poll),
+			 ztest_unit_test(test_epoll));
 
 	ztest_run_test_suite(socket_poll);
 }
@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #include <ztest_assert.h>
 #include <fcntl.h>
 #include <net/socket.h>
+#include <net/net_pkt.h>
 
 #include "../../socket_helpers.h"
 
@@ -1041,6 +1042,130 @@ void test_socket_permission(void)
 #endif /* CONFIG_USERSPACE */
 }
 
+#define ZC_DATA_LEN 300
+
+static uint8_t zc_data[ZC_DATA_LEN];
+
+static struct net_buf *zc_alloc_frags(const uint8_t *data, size_t len)
+{
+	struct net_buf *frags = NULL;
+
+	while (len > 0) {
+		struct net_buf *frag;
+		size_t copy;
+
+		frag = net_pkt_get_reserve_tx_data(K_MSEC(100));
+		zassert_not_null(frag, "Cannot allocate buffer");
+
+		copy = MIN(len, net_buf_tailroom(frag));
+		net_buf_add_mem(frag, data, copy);
+
+		frags = net_buf_frag_add(frags, frag);
+		data += copy;
+		len -= copy;
+	}
+
+	return frags;
+}
+
+/* Send zc_data without copying on c_sock and receive it on new_sock the
+ * same way. TCP may split the data into several segments.
+ */
+static void test_zero_copy(int c_sock, int new_sock)
+{
+	uint8_t rx_buf[ZC_DATA_LEN];
+	struct net_buf *frags;
+	size_t recved = 0;
+	ssize_t rv;
+	int i;
+
+	for (i = 0; i < sizeof(zc_data); i++) {
+		zc_data[i] = (uint8_t)i;
+	}
+
+	frags = zc_alloc_frags(zc_data, sizeof(zc_data));
+
+	rv = zsock_sendto_zc(c_sock, frags, 0, NULL, 0);
+	zassert_equal(rv, sizeof(zc_data), "sendto_zc failed (%d)", errno);
+
+	while (recved < sizeof(zc_data)) {
+		rv = zsock_recvfrom_zc(new_sock, &frags, 0, NULL, NULL);
+		zassert_true(rv > 0, "recvfrom_zc failed (%d)", errno);
+		zassert_not_null(frags, "No buffers received");
+		zassert_equal(net_buf_frags_len(frags), rv,
+			      "Headers were not stripped");
+		zassert_true(recved + rv <= sizeof(zc_data), "Too much data");
+
+		net_buf_linearize(rx_buf + recved, sizeof(rx_buf) - recved,
+				  frags, 0, rv);
+		recved += rv;
+
+		zsock_recv_zc_release(frags);
+	}
+
+	zassert_mem_equal(rx_buf, zc_data, sizeof(zc_data), "wrong data");
+}
+
+void test_v4_zero_copy(void)
+{
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	test_zero_copy(c_sock, new_sock);
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+void test_v6_zero_copy(void)
+{
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in6 c_saddr;
+	struct sockaddr_in6 s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+
+	prepare_sock_tcp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	test_zero_copy(c_sock, new_sock);
+
+	test_close(c_sock);
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
 void test_main(void)
 {
 #ifdef CONFIG_USERSPACE
@@ -1075,6 +1200,8 @@ void test_main(void)
 		ztest_unit_test(test_v6_so_rcvtimeo),
 		ztest_unit_test(test_v4_msg_waitall),
 		ztest_unit_test(test_v6_msg_waitall),
+		ztest_unit_test(test_v4_zero_copy),
+		ztest_unit_test(test_v6_zero_copy),
 		ztest_user_unit_test(test_socket_permission)
 		);
 
@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #include <net/socket.h>
 #include <net/ethernet.h>
+#include <net/net_pkt.h>
 
 #include "ipv6.h"
 #include "../../socket_helpers.h"
@@ -1212,6 +1213,299 @@ void test_v6_msg_trunc(void)
 		       (struct sockaddr *)&server_addr, sizeof(server_addr));
 }
 
+void test_v4_recvmsg_pktinfo(void)
+{
+	int rv;
+	int one = 1;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr;
+	struct in_pktinfo *info;
+	struct msghdr msg;
+	struct cmsghdr *cmsg;
+	struct iovec io_vector[2];
+	char first[2];
+	union {
+		struct cmsghdr hdr;
+		unsigned char  buf[CMSG_SPACE(sizeof(struct in_pktinfo))];
+	} cmsgbuf;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = setsockopt(server_sock, IPPROTO_IP, IP_PKTINFO, &one, sizeof(one));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	/* Scatter the datagram over two vectors */
+	clear_buf(rx_buf);
+	io_vector[0].iov_base = first;
+	io_vector[0].iov_len = sizeof(first);
+	io_vector[1].iov_base = rx_buf;
+	io_vector[1].iov_len = sizeof(rx_buf);
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_iov = io_vector;
+	msg.msg_iovlen = 2;
+	msg.msg_name = &src_addr;
+	msg.msg_namelen = sizeof(src_addr);
+	msg.msg_control = &cmsgbuf.buf;
+	msg.msg_controllen = sizeof(cmsgbuf.buf);
+
+	rv = recvmsg(server_sock, &msg, 0);
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "recvmsg failed");
+	zassert_mem_equal(first, TEST_STR_SMALL, sizeof(first), "wrong data");
+	zassert_mem_equal(rx_buf, TEST_STR_SMALL + sizeof(first),
+			  STRLEN(TEST_STR_SMALL) - sizeof(first),
+			  "wrong data");
+	zassert_equal(msg.msg_namelen, sizeof(struct sockaddr_in),
+		      "wrong addrlen");
+	zassert_equal(msg.msg_flags, 0, "unexpected flags 0x%x",
+		      msg.msg_flags);
+
+	cmsg = CMSG_FIRSTHDR(&msg);
+	zassert_not_null(cmsg, "no ancillary data");
+	zassert_equal(cmsg->cmsg_level, IPPROTO_IP, "wrong level");
+	zassert_equal(cmsg->cmsg_type, IP_PKTINFO, "wrong type");
+
+	info = (struct in_pktinfo *)CMSG_DATA(cmsg);
+	zassert_equal(info->ipi_addr.s_addr, server_addr.sin_addr.s_addr,
+		      "wrong destination address");
+	zassert_true(info->ipi_ifindex > 0, "no interface index");
+
+	/* Too small buffers truncate the data and the control message */
+	rv = sendto(client_sock, BUF_AND_SIZE(TEST_STR_SMALL), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR_SMALL), "sendto failed");
+
+	msg.msg_iovlen = 1;
+	msg.msg_name = NULL;
+	msg.msg_controllen = sizeof(struct cmsghdr);
+
+	rv = recvmsg(server_sock, &msg, 0);
+	zassert_equal(rv, sizeof(first), "recvmsg failed");
+	zassert_equal(msg.msg_flags, ZSOCK_MSG_TRUNC | ZSOCK_MSG_CTRUNC,
+		      "unexpected flags 0x%x", msg.msg_flags);
+	zassert_equal(msg.msg_controllen, 0, "control data returned");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+#define MMSG_COUNT 4
+
+void test_v4_sendmmsg_recvmmsg(void)
+{
+	int rv;
+	int i;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct mmsghdr msgs[MMSG_COUNT];
+	struct iovec tx_iov[MMSG_COUNT];
+	struct iovec rx_iov[MMSG_COUNT];
+	char bufs[MMSG_COUNT][sizeof(TEST_STR_SMALL)];
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		tx_iov[i].iov_base = TEST_STR_SMALL;
+		tx_iov[i].iov_len = STRLEN(TEST_STR_SMALL) - i;
+		msgs[i].msg_hdr.msg_iov = &tx_iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &server_addr;
+		msgs[i].msg_hdr.msg_namelen = sizeof(server_addr);
+	}
+
+	rv = sendmmsg(client_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL) - i,
+			      "wrong sent length");
+	}
+
+	/* Give the datagrams time to be queued to the server */
+	k_msleep(100);
+
+	memset(msgs, 0, sizeof(msgs));
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		rx_iov[i].iov_base = bufs[i];
+		rx_iov[i].iov_len = sizeof(bufs[i]);
+		msgs[i].msg_hdr.msg_iov = &rx_iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(msgs[i].msg_len, STRLEN(TEST_STR_SMALL) - i,
+			      "wrong received length");
+		zassert_mem_equal(bufs[i], TEST_STR_SMALL, msgs[i].msg_len,
+				  "wrong data");
+	}
+
+	/* Nothing queued anymore */
+	rv = recvmmsg(server_sock, msgs, MMSG_COUNT, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg should have failed");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+static struct net_buf *zc_alloc_frags(const char *data, size_t len)
+{
+	struct net_buf *frags = NULL;
+
+	while (len > 0) {
+		struct net_buf *frag;
+		size_t copy;
+
+		frag = net_pkt_get_reserve_tx_data(K_MSEC(100));
+		zassert_not_null(frag, "Cannot allocate buffer");
+
+		copy = MIN(len, net_buf_tailroom(frag));
+		net_buf_add_mem(frag, data, copy);
+
+		frags = net_buf_frag_add(frags, frag);
+		data += copy;
+		len -= copy;
+	}
+
+	return frags;
+}
+
+void test_v4_zero_copy(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct sockaddr_in src_addr;
+	socklen_t addrlen = sizeof(src_addr);
+	struct net_buf *frags;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	frags = zc_alloc_frags(TEST_STR2, STRLEN(TEST_STR2));
+
+	rv = zsock_sendto_zc(client_sock, frags, 0,
+			     (struct sockaddr *)&server_addr,
+			     sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto_zc failed (%d)", errno);
+
+	frags = NULL;
+	rv = zsock_recvfrom_zc(server_sock, &frags, ZSOCK_MSG_PEEK, NULL, NULL);
+	zassert_equal(rv, -1, "MSG_PEEK should not be supported");
+	zassert_equal(errno, EINVAL, "incorrect errno value");
+
+	rv = zsock_recvfrom_zc(server_sock, &frags, 0,
+			       (struct sockaddr *)&src_addr, &addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recvfrom_zc failed (%d)", errno);
+	zassert_not_null(frags, "No buffers received");
+	zassert_equal(net_buf_frags_len(frags), STRLEN(TEST_STR2),
+		      "Headers were not stripped");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+	zassert_equal(src_addr.sin_family, AF_INET, "wrong family");
+
+	clear_buf(rx_buf);
+	net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0,
+			  STRLEN(TEST_STR2));
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2), "wrong data");
+
+	zsock_recv_zc_release(frags);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v6_zero_copy(void)
+{
+	int rv;
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+	struct sockaddr_in6 src_addr;
+	socklen_t addrlen = sizeof(src_addr);
+	struct net_buf *frags;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, ANY_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	frags = zc_alloc_frags(TEST_STR2, STRLEN(TEST_STR2));
+
+	rv = zsock_sendto_zc(client_sock, frags, 0,
+			     (struct sockaddr *)&server_addr,
+			     sizeof(server_addr));
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto_zc failed (%d)", errno);
+
+	rv = zsock_recvfrom_zc(server_sock, &frags, 0,
+			       (struct sockaddr *)&src_addr, &addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recvfrom_zc failed (%d)", errno);
+	zassert_not_null(frags, "No buffers received");
+	zassert_equal(net_buf_frags_len(frags), STRLEN(TEST_STR2),
+		      "Headers were not stripped");
+	zassert_equal(addrlen, sizeof(struct sockaddr_in6), "wrong addrlen");
+	zassert_equal(src_addr.sin6_family, AF_INET6, "wrong family");
+
+	clear_buf(rx_buf);
+	net_buf_linearize(rx_buf, sizeof(rx_buf), frags, 0,
+			  STRLEN(TEST_STR2));
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2), "wrong data");
+
+	zsock_recv_zc_release(frags);
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -1242,7 +1536,11 @@ void test_main(void)
 			 ztest_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_user_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_unit_test(test_v4_msg_trunc),
-			 ztest_unit_test(test_v6_msg_trunc)
+			 ztest_unit_test(test_v6_msg_trunc),
+			 ztest_unit_test(test_v4_recvmsg_pktinfo),
+			 ztest_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_unit_test(test_v4_zero_copy),
+			 ztest_unit_test(test_v6_zero_copy)
 		);
 
 	ztest_run_test_suite(socket_udp);
@@ -125,6 +125,13 @@ static void handle_syn_resend(void);
 static void handle_client_fin_wait_2_test(sa_family_t af, struct tcphdr *th);
 static void handle_client_closing_test(sa_family_t af, struct tcphdr *th);
 static void handle_server_recv_out_of_order(struct net_pkt *pkt);
+static void handle_client_fast_retransmit_test(sa_family_t af,
+					       struct tcphdr *th);
+static void handle_server_options_test(struct net_pkt *pkt,
+				       struct tcphdr *th);
+static void handle_client_sack_test(struct net_pkt *pkt, struct tcphdr *th);
+static void handle_server_gro_test(struct tcphdr *th);
+static void handle_server_delayed_ack_test(struct tcphdr *th);
 
 static void verify_flags(struct tcphdr *th, uint8_t flags,
 			 const char *fun, int line)
@@ -213,6 +220,24 @@ static uint8_t tcp_options[20] = {
 	0x01, /* NOP */
 	0x03, 0x03, 0x07 /* Win scale*/ };
 
+/* Window scale offered in tcp_options */
+#define PEER_WSCALE 7
+
+/* Window advertised by the peer */
+static uint16_t peer_win = NET_IPV6_MTU;
+
+/* Options the peer sends in segments other than its SYN */
+static uint8_t peer_options[4 + NET_TCP_MAX_SACK_BLOCKS *
+			   NET_TCP_SACK_BLOCK_SIZE];
+static size_t peer_options_len;
+
+/* Test cases where the peer offers tcp_options in its SYN */
+static bool peer_syn_options(void)
+{
+	return test_case_no == 4U || test_case_no == 11U ||
+	       test_case_no == 12U;
+}
+
 static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      uint16_t src_port,
 					      uint16_t dst_port,
@@ -221,13 +246,20 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 					      size_t len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	const uint8_t *opts = NULL;
 	struct net_pkt *pkt;
 	struct tcphdr *th;
 	uint8_t opts_len = 0;
 	int ret = -EINVAL;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		opts_len = sizeof(tcp_options);
+	if (flags & SYN) {
+		if (peer_syn_options()) {
+			opts = tcp_options;
+			opts_len = sizeof(tcp_options);
+		}
+	} else if (!(flags & RST)) {
+		opts = peer_options;
+		opts_len = peer_options_len;
 	}
 
 	/* Allocate buffer */
@@ -262,14 +294,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 	th->th_sport = src_port;
 	th->th_dport = dst_port;
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
-		th->th_off = 10U;
-	} else {
-		th->th_off = 5U;
-	}
-
+	th->th_off = 5U + opts_len / 4U;
 	th->th_flags = flags;
-	th->th_win = NET_IPV6_MTU;
+	th->th_win = htons(peer_win);
 	th->th_seq = htonl(seq);
 
 	if (ACK & flags) {
@@ -281,9 +308,9 @@ static struct net_pkt *tester_prepare_tcp_pkt(sa_family_t af,
 		goto fail;
 	}
 
-	if ((test_case_no == 4U) && (flags & SYN)) {
+	if (opts_len) {
 		/* Add TCP Options */
-		ret = net_pkt_write(pkt, tcp_options, opts_len);
+		ret = net_pkt_write(pkt, opts, opts_len);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -420,6 +447,21 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 	case 9:
 		handle_server_recv_out_of_order(pkt);
 		break;
+	case 10:
+		handle_client_fast_retransmit_test(net_pkt_family(pkt), &th);
+		break;
+	case 11:
+		handle_server_options_test(pkt, &th);
+		break;
+	case 12:
+		handle_client_sack_test(pkt, &th);
+		break;
+	case 13:
+		handle_server_gro_test(&th);
+		break;
+	case 14:
+		handle_server_delayed_ack_test(&th);
+		break;
 	default:
 		zassert_true(false, "Undefined test case");
 	}
@@ -696,6 +738,12 @@ static void test_server_timeout(struct k_work *work)
 		handle_server_test(AF_INET, NULL);
 	} else if (test_case_no == 5) {
 		handle_server_test(AF_INET6, NULL);
+	} else if (test_case_no == 11) {
+		handle_server_options_test(NULL, NULL);
+	} else if (test_case_no == 13) {
+		handle_server_gro_test(NULL);
+	} else if (test_case_no == 14) {
+		handle_server_delayed_ack_test(NULL);
 	} else {
 		zassert_true(false, "Invalid test case");
 	}
@@ -713,6 +761,8 @@ static void test_tcp_recv_cb(struct net_context *context,
 	}
 }
 
+static struct net_context *accepted_ctx;
+
 static void test_tcp_accept_cb(struct net_context *ctx,
 			       struct sockaddr *addr,
 			       socklen_t addrlen,
@@ -725,6 +775,7 @@ static void test_tcp_accept_cb(struct net_context *ctx,
 
 	/* set callback on newly created context */
 	ctx->recv_cb = test_tcp_recv_cb;
+	accepted_ctx = ctx;
 
 	test_sem_give();
 }
@@ -743,6 +794,9 @@ static void test_tcp_accept_cb(struct net_context *ctx,
 static void test_server_ipv4(void)
 {
 	struct net_context *ctx;
+#if defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+	struct tcp *conn;
+#endif
 	int ret;
 
 	t_state = T_SYN;
@@ -778,6 +832,14 @@ static void test_server_ipv4(void)
 	 */
 	test_sem_take(K_MSEC(100), __LINE__);
 
+#if defined(CONFIG_NET_BUF_ELASTIC_DATA_SIZE)
+	/* The window offered in the SYN ACK is not scaled */
+	conn = accepted_ctx->tcp;
+	zassert_equal(conn->recv_win_edge - conn->ack,
+		      MIN(conn->recv_win, UINT16_MAX),
+		      "Window edge %u, ACK %u", conn->recv_win_edge, conn->ack);
+#endif
+
 	/* Trigger the peer to send DATA  */
 	k_work_reschedule(&test_server, K_NO_WAIT);
 
@@ -1208,159 +1270,1299 @@ static void test_client_closing_ipv6(void)
 	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
 }
 
-static struct net_context *create_server_socket(uint32_t my_seq,
-						uint32_t my_ack)
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+static void handle_client_fast_retransmit_test(sa_family_t af,
+					       struct tcphdr *th)
 {
-	struct net_context *ctx;
+	struct net_pkt *reply;
 	int ret;
 
-	t_state = T_SYN;
-	test_case_no = 5;
-	seq = my_seq;
-	ack = my_ack;
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_syn_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		/* connection is success */
+		t_state = T_DATA;
+		test_sem_give();
+		return;
+	case T_DATA:
+		/* Pretend the segment was lost, the peer keeps on
+		 * acknowledging the previous data.
+		 */
+		test_verify_flags(th, PSH | ACK);
+		zassert_equal(ntohl(th->th_seq), ack, "Unexpected seq");
+		seq++;
+		t_state = T_DATA_ACK;
 
-	ret = net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &ctx);
-	if (ret < 0) {
-		zassert_true(false, "Failed to get net_context");
+		for (int i = 0; i < 3; i++) {
+			reply = prepare_ack_packet(af, htons(MY_PORT),
+						   th->th_sport);
+			ret = net_recv_data(iface, reply);
+			if (ret < 0) {
+				goto fail;
+			}
+		}
+
+		return;
+	case T_DATA_ACK:
+		/* Third duplicate ACK triggers the retransmission */
+		test_verify_flags(th, PSH | ACK);
+		zassert_equal(ntohl(th->th_seq), ack, "Not a retransmission");
+		ack = ack + 1U;
+		reply = prepare_ack_packet(af, htons(MY_PORT), th->th_sport);
+		t_state = T_FIN;
+		test_sem_give();
+		break;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ntohl(th->th_seq) + 1U;
+		t_state = T_FIN_ACK;
+		reply = prepare_fin_ack_packet(af, htons(MY_PORT),
+					       th->th_sport);
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
 	}
 
-	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_v6_s,
-			       sizeof(struct sockaddr_in6));
+	ret = net_recv_data(iface, reply);
 	if (ret < 0) {
-		zassert_true(false, "Failed to bind net_context");
+		goto fail;
 	}
 
-	ret = net_context_listen(ctx, 1);
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+/* Test case scenario IPv4
+ *   send SYN,
+ *   expect SYN ACK,
+ *   send ACK,
+ *   send Data,
+ *   expect three duplicate ACKs,
+ *   resend Data before the retransmission timer expires,
+ *   expect ACK,
+ *   send FIN,
+ *   expect FIN ACK,
+ *   send ACK.
+ *   any failures cause test case to fail.
+ */
+static void test_client_fast_retransmit(void)
+{
+	struct net_context *ctx;
+	uint8_t data = 0x41; /* "A" */
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 10;
+	seq = ack = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
 	if (ret < 0) {
-		zassert_true(false, "Failed to listen on net_context");
+		zassert_true(false, "Failed to get net_context");
 	}
 
-	/* Trigger the peer to send SYN  */
-	k_work_reschedule(&test_server, K_NO_WAIT);
+	net_context_ref(ctx);
 
-	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
 	if (ret < 0) {
-		zassert_true(false, "Failed to set accept on net_context");
+		zassert_true(false, "Failed to connect to peer");
 	}
 
-	/* test_tcp_accept_cb will release the semaphone after succesfull
-	 * connection.
+	/* Peer will release the semaphone after it receives
+	 * proper ACK to SYN | ACK
 	 */
 	test_sem_take(K_MSEC(100), __LINE__);
 
-	return ctx;
-}
-
-static void check_rst_fail(uint32_t seq_value)
-{
-	struct net_pkt *reply;
-	int rsterr_before, rsterr_after;
-	int ret;
-
-	rsterr_before = GET_STAT(iface, tcp.rsterr);
-
-	/* Invalid seq in the RST packet */
-	seq = seq_value;
+	ret = net_context_send(ctx, &data, 1, NULL, K_NO_WAIT, NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to send data to peer");
+	}
 
-	reply = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	/* Peer will release the semaphone after it receives the resent
+	 * data, which must happen well before the initial RTO.
+	 */
+	test_sem_take(K_MSEC(CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT / 2),
+		      __LINE__);
 
-	ret = net_recv_data(iface, reply);
-	zassert_true(ret == 0, "recv data failed (%d)", ret);
+	net_context_put(ctx);
 
-	/* Let the receiving thread run */
-	k_msleep(50);
+	/* Peer will release the semaphone after it receives
+	 * proper ACK to FIN | ACK
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
 
-	rsterr_after = GET_STAT(iface, tcp.rsterr);
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+#else
+static void handle_client_fast_retransmit_test(sa_family_t af,
+					       struct tcphdr *th)
+{
+	ARG_UNUSED(af);
+	ARG_UNUSED(th);
+}
 
-	zassert_equal(rsterr_before + 1, rsterr_after,
-		      "RST packet not skipped (before %d, after %d)",
-		      rsterr_before, rsterr_after);
+static void test_client_fast_retransmit(void)
+{
+	ztest_test_skip();
 }
+#endif /* CONFIG_NET_TCP_CONGESTION_CONTROL */
 
-static void check_rst_succeed(struct net_context *ctx,
-			      uint32_t seq_value)
+#if defined(CONFIG_NET_TCP_SACK)
+/* Copy the options of the TCP segment to opts, returns their length */
+static int read_tcp_options(struct net_pkt *pkt, struct tcphdr *th,
+			    uint8_t *opts)
 {
-	struct net_pkt *reply;
-	int rsterr_before, rsterr_after;
+	int len = (th->th_off - 5) * 4;
 	int ret;
 
-	/* Make sure that various other corner cases work */
-	if (ctx == NULL) {
-		ctx = create_server_socket(0, 0);
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			   net_pkt_ip_opts_len(pkt) + sizeof(struct tcphdr));
+	if (ret < 0) {
+		return -EINVAL;
 	}
 
-	/* Another valid seq in the RST packet */
-	seq = ack + seq_value;
+	ret = net_pkt_read(pkt, opts, len);
+	if (ret < 0) {
+		return -EINVAL;
+	}
 
-	reply = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+	net_pkt_cursor_init(pkt);
 
-	rsterr_before = GET_STAT(iface, tcp.rsterr);
+	return len;
+}
 
-	ret = net_recv_data(iface, reply);
-	zassert_true(ret == 0, "recv data failed (%d)", ret);
+/* Returns the option of the given kind from an option list, or NULL */
+static const uint8_t *find_tcp_option(const uint8_t *opts, int len,
+				      uint8_t kind)
+{
+	int i = 0;
 
-	/* Let the receiving thread run */
-	k_msleep(50);
+	while (i < len && opts[i] != NET_TCP_END_OPT) {
+		if (opts[i] == NET_TCP_NOP_OPT) {
+			i++;
+			continue;
+		}
 
-	rsterr_after = GET_STAT(iface, tcp.rsterr);
+		if (i + 1 >= len || opts[i + 1] < 2) {
+			break;
+		}
 
-	zassert_equal(rsterr_before, rsterr_after,
-		      "RST packet skipped (before %d, after %d)",
-		      rsterr_before, rsterr_after);
+		if (opts[i] == kind) {
+			return &opts[i];
+		}
 
-	net_tcp_put(ctx);
+		i += opts[i + 1];
+	}
+
+	return NULL;
 }
 
-static void test_client_invalid_rst(void)
+/* What the last segment sent to the peer acknowledged */
+static struct {
+	uint32_t ack;
+	uint16_t win;
+	int sack_count;
+	struct tcp_sack_block sack[NET_TCP_MAX_SACK_BLOCKS];
+} last_ack;
+
+static void save_last_ack(struct net_pkt *pkt, struct tcphdr *th)
 {
-	struct net_context *ctx;
-	struct tcp *conn;
-	uint16_t wnd;
+	uint8_t opts[40];
+	const uint8_t *sack;
+	int len;
 
-	ctx = create_server_socket(0, 0);
+	len = read_tcp_options(pkt, th, opts);
+	zassert_true(len >= 0, "Cannot read TCP options");
 
-	conn = ctx->tcp;
-	wnd = conn->recv_win;
+	last_ack.ack = ntohl(th->th_ack);
+	last_ack.win = ntohs(th->th_win);
+	last_ack.sack_count = 0;
 
-	/* Failure cases, the RST packets should be dropped */
-	check_rst_fail(ack - 1);
-	check_rst_fail(ack + wnd);
+	sack = find_tcp_option(opts, len, NET_TCP_SACK_OPT);
+	if (sack == NULL) {
+		return;
+	}
 
-	/* Then send a valid seq in the RST packet */
-	check_rst_succeed(ctx, wnd - 1);
-	check_rst_succeed(NULL, 0);
-	check_rst_succeed(NULL, 1);
+	last_ack.sack_count = (sack[1] - 2) / NET_TCP_SACK_BLOCK_SIZE;
 
-	net_tcp_put(ctx);
+	for (int i = 0; i < last_ack.sack_count; i++) {
+		const uint8_t *block = sack + 2 + i * NET_TCP_SACK_BLOCK_SIZE;
+
+		last_ack.sack[i].start = sys_get_be32(block);
+		last_ack.sack[i].end = sys_get_be32(block + 4);
+	}
 }
 
-#define MAX_DATA 100
-static uint32_t expected_ack = MAX_DATA + 1 - 15;
-static struct net_context *ooo_ctx;
+static uint8_t syn_ack_wscale;
 
-static void handle_server_recv_out_of_order(struct net_pkt *pkt)
+static void handle_server_options_test(struct net_pkt *pkt,
+				       struct tcphdr *th)
 {
-	struct tcphdr th;
-	int ret;
+	uint8_t opts[40];
+	const uint8_t *opt;
+	struct net_pkt *reply;
+	int len, ret;
 
-	ret = read_tcp_header(pkt, &th);
+	switch (t_state) {
+	case T_SYN:
+		reply = prepare_syn_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT));
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, SYN | ACK);
+
+		len = read_tcp_options(pkt, th, opts);
+		opt = find_tcp_option(opts, len, NET_TCP_WINDOW_SCALE_OPT);
+		zassert_equal(opt != NULL,
+			      IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE),
+			      "Window scale option in SYN-ACK");
+		syn_ack_wscale = opt ? opt[2] : 0U;
+
+		opt = find_tcp_option(opts, len, NET_TCP_SACK_PERM_OPT);
+		zassert_not_null(opt, "No SACK permitted in SYN-ACK");
+
+		seq++;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT));
+		t_state = T_DATA;
+		break;
+	case T_DATA:
+		/* The test checks the ACKs for the data it sends */
+		test_verify_flags(th, ACK);
+		save_last_ack(pkt, th);
+		test_sem_give();
+		return;
+	case T_CLOSING:
+		return;
+	default:
+		zassert_true(false, "%s: unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
 	if (ret < 0) {
 		goto fail;
 	}
 
-	/* Verify that we received all the queued data */
-	zassert_equal(expected_ack, ntohl(th.th_ack),
-		      "Not all pending data received. "
-		      "Expected ACK %u but got %u",
-		      expected_ack, ntohl(th.th_ack));
-
-	test_sem_give();
-
 	return;
-
 fail:
 	zassert_true(false, "%s failed", __func__);
-	net_pkt_unref(pkt);
+}
+
+static void send_data_at(uint32_t data_seq, const uint8_t *data, size_t len)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = data_seq;
+
+	pkt = prepare_data_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT),
+				  data, len);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+}
+
+/* Test case scenario IPv4
+ *   expect SYN with window scale and SACK permitted,
+ *   send SYN ACK with SACK permitted, and window scale if enabled,
+ *   expect ACK,
+ *   check the negotiated options and the windows of both sides,
+ *   send Data after a hole,
+ *   expect ACK with a SACK block for it,
+ *   send more Data after it,
+ *   expect ACK with the SACK block grown,
+ *   send the Data filling the hole,
+ *   expect ACK for all of it without SACK blocks.
+ *   any failures cause test case to fail.
+ */
+static void test_server_wscale_sack_ipv4(void)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t base;
+	int ret;
+
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+		return;
+	}
+
+	t_state = T_SYN;
+	test_case_no = 11;
+	seq = ack = 0;
+	peer_win = 8U;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	conn = accepted_ctx->tcp;
+
+	zassert_true(conn->sack_ok, "SACK not negotiated");
+	zassert_equal(conn->send_wscale,
+		      IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ? PEER_WSCALE : 0,
+		      "Peer window scale %u", conn->send_wscale);
+	zassert_equal(conn->recv_wscale, syn_ack_wscale,
+		      "Window scale %u, offered %u", conn->recv_wscale,
+		      syn_ack_wscale);
+
+	/* The window in the ACK completing the handshake is scaled */
+	zassert_equal(conn->send_win, (uint32_t)peer_win << conn->send_wscale,
+		      "Send window %u", conn->send_win);
+
+	base = seq;
+
+	send_data_at(base + 10U, lorem_ipsum + 10, 10);
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(last_ack.ack, base, "Unexpected ACK");
+	zassert_equal(last_ack.sack_count, 1, "%d SACK blocks",
+		      last_ack.sack_count);
+	zassert_equal(last_ack.sack[0].start, base + 10U, "SACK start");
+	zassert_equal(last_ack.sack[0].end, base + 20U, "SACK end");
+
+	/* Our window is scaled as well, when it is large enough */
+	zassert_equal(last_ack.win, conn->recv_win >> conn->recv_wscale,
+		      "Window %u, expected %u", last_ack.win,
+		      conn->recv_win >> conn->recv_wscale);
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    CONFIG_NET_TCP_MAX_RECV_WINDOW_SIZE > UINT16_MAX) {
+		zassert_true(conn->recv_wscale > 0U, "Window not scaled");
+	}
+
+	send_data_at(base + 20U, lorem_ipsum + 20, 10);
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(last_ack.ack, base, "Unexpected ACK");
+	zassert_equal(last_ack.sack_count, 1, "%d SACK blocks",
+		      last_ack.sack_count);
+	zassert_equal(last_ack.sack[0].start, base + 10U, "SACK start");
+	zassert_equal(last_ack.sack[0].end, base + 30U, "SACK end");
+
+	/* Filling the hole is acknowledged right away */
+	send_data_at(base, lorem_ipsum, 10);
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_equal(last_ack.ack, base + 30U, "Hole not filled");
+	zassert_equal(last_ack.sack_count, 0, "Stale SACK blocks");
+
+	t_state = T_CLOSING;
+	peer_win = NET_IPV6_MTU;
+	seq = base + 30U;
+
+	ret = net_recv_data(iface, prepare_rst_packet(AF_INET, htons(MY_PORT),
+						      htons(PEER_PORT)));
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+#else
+static void handle_server_options_test(struct net_pkt *pkt,
+				       struct tcphdr *th)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(th);
+}
+
+static void test_server_wscale_sack_ipv4(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+#if defined(CONFIG_NET_TCP_SACK) && defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#define SACK_SEG_LEN 10
+#define SACK_SEGS 4
+
+static int sack_rexmits;
+
+/* Make the peer send the given SACK blocks, none to stop */
+static void peer_sack_set(const struct tcp_sack_block *blocks, int count)
+{
+	peer_options_len = 0;
+
+	if (count == 0) {
+		return;
+	}
+
+	peer_options[0] = NET_TCP_NOP_OPT;
+	peer_options[1] = NET_TCP_NOP_OPT;
+	peer_options[2] = NET_TCP_SACK_OPT;
+	peer_options[3] = 2 + count * NET_TCP_SACK_BLOCK_SIZE;
+
+	for (int i = 0; i < count; i++) {
+		sys_put_be32(blocks[i].start,
+			     &peer_options[4 + i * NET_TCP_SACK_BLOCK_SIZE]);
+		sys_put_be32(blocks[i].end,
+			     &peer_options[8 + i * NET_TCP_SACK_BLOCK_SIZE]);
+	}
+
+	peer_options_len = 4 + count * NET_TCP_SACK_BLOCK_SIZE;
+}
+
+static size_t tcp_payload_len(struct net_pkt *pkt, struct tcphdr *th)
+{
+	return net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+		net_pkt_ip_opts_len(pkt) - th->th_off * 4U;
+}
+
+static void handle_client_sack_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	/* Segments 0 and 2 are lost, 1 and 3 arrive */
+	struct tcp_sack_block blocks[] = {
+		{ ack + 1 * SACK_SEG_LEN, ack + 2 * SACK_SEG_LEN },
+		{ ack + 3 * SACK_SEG_LEN, ack + 4 * SACK_SEG_LEN },
+	};
+	uint32_t pos = ntohl(th->th_seq) - ack;
+	size_t len = tcp_payload_len(pkt, th);
+	struct net_pkt *reply;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		test_verify_flags(th, SYN);
+		seq = 0U;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_syn_ack_packet(AF_INET, htons(MY_PORT),
+					       th->th_sport);
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, ACK);
+		seq++;
+		/* The window in the SYN-ACK is not scaled. Update it now,
+		 * so that it does not change under the duplicate ACKs.
+		 */
+		reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+					   th->th_sport);
+		t_state = T_DATA;
+		test_sem_give();
+		break;
+	case T_DATA:
+		test_verify_flags(th, PSH | ACK);
+		zassert_equal(len, SACK_SEG_LEN, "Unexpected length %zu", len);
+
+		switch (pos / SACK_SEG_LEN) {
+		case 0:
+		case 2:
+			return;
+		case 1:
+			peer_sack_set(blocks, 1);
+			break;
+		case 3:
+			/* Second and third duplicate ACK, the third one
+			 * triggers the fast retransmission.
+			 */
+			peer_sack_set(blocks, 2);
+			ret = net_recv_data(iface,
+					    prepare_ack_packet(AF_INET,
+							       htons(MY_PORT),
+							       th->th_sport));
+			if (ret < 0) {
+				goto fail;
+			}
+
+			t_state = T_DATA_ACK;
+			break;
+		default:
+			zassert_true(false, "Unexpected seq %u", pos);
+			return;
+		}
+
+		reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+					   th->th_sport);
+		break;
+	case T_DATA_ACK:
+		test_verify_flags(th, PSH | ACK);
+
+		if (sack_rexmits++ == 0) {
+			/* Only the first hole, not the SACKed data after */
+			zassert_equal(pos, 0, "Resent seq %u", pos);
+			zassert_equal(len, SACK_SEG_LEN, "Resent %zu", len);
+
+			/* Another duplicate ACK lets the next hole go */
+			reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+						   th->th_sport);
+			break;
+		}
+
+		zassert_equal(pos, 2 * SACK_SEG_LEN, "Resent seq %u", pos);
+		zassert_equal(len, SACK_SEG_LEN, "Resent %zu", len);
+
+		peer_sack_set(NULL, 0);
+		ack += SACK_SEGS * SACK_SEG_LEN;
+		reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+					   th->th_sport);
+		t_state = T_FIN;
+		test_sem_give();
+		break;
+	case T_FIN:
+		test_verify_flags(th, FIN | ACK);
+		ack = ntohl(th->th_seq) + 1U;
+		t_state = T_FIN_ACK;
+		reply = prepare_fin_ack_packet(AF_INET, htons(MY_PORT),
+					       th->th_sport);
+		break;
+	case T_FIN_ACK:
+		test_verify_flags(th, ACK);
+		test_sem_give();
+		return;
+	default:
+		zassert_true(false, "%s unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+/* Test case scenario IPv4
+ *   send SYN with SACK permitted,
+ *   expect SYN ACK with SACK permitted,
+ *   send ACK,
+ *   send four Data segments,
+ *   expect duplicate ACKs with SACK blocks for the second and fourth,
+ *   resend only the first segment,
+ *   expect a duplicate ACK,
+ *   resend only the third segment,
+ *   expect ACK for all of them,
+ *   send FIN,
+ *   expect FIN ACK,
+ *   send ACK.
+ *   any failures cause test case to fail.
+ */
+static void test_client_sack_retransmit(void)
+{
+	struct net_context *ctx;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 12;
+	seq = ack = 0;
+	sack_rexmits = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	net_context_ref(ctx);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&peer_addr_s,
+				  sizeof(struct sockaddr_in),
+				  NULL,
+				  K_MSEC(100), NULL);
+	zassert_equal(ret, 0, "Failed to connect to peer");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	zassert_true(((struct tcp *)ctx->tcp)->sack_ok, "SACK not negotiated");
+
+	for (int i = 0; i < SACK_SEGS; i++) {
+		ret = net_context_send(ctx, lorem_ipsum + i * SACK_SEG_LEN,
+				       SACK_SEG_LEN, NULL, K_NO_WAIT, NULL);
+		zassert_true(ret >= 0, "Failed to send data to peer");
+	}
+
+	/* Peer will release the semaphore once both holes were resent,
+	 * which must happen well before the initial RTO.
+	 */
+	test_sem_take(K_MSEC(CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT / 2),
+		      __LINE__);
+
+	net_context_put(ctx);
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Connection is in TIME_WAIT state, context will be released
+	 * after K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY), so wait for it.
+	 */
+	k_sleep(K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+}
+#else
+static void handle_client_sack_test(struct net_pkt *pkt, struct tcphdr *th)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(th);
+}
+
+static void test_client_sack_retransmit(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_TCP_SACK && CONFIG_NET_TCP_CONGESTION_CONTROL */
+
+#if defined(CONFIG_NET_TCP_GRO)
+#define GRO_SEG_LEN 10
+
+static const struct in_addr gro_other_addr = { { { 192, 0, 2, 3 } } };
+static size_t gro_rx_len[4];
+static int gro_rx_count;
+static bool gro_send_trigger;
+
+static void gro_queue_ip(const struct in_addr *dst, enum net_priority prio);
+
+static void handle_server_gro_test(struct tcphdr *th)
+{
+	struct net_pkt *reply;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		reply = prepare_syn_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT));
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, SYN | ACK);
+		seq++;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT));
+		t_state = T_DATA;
+		break;
+	case T_DATA:
+		/* This is the RX thread sending an ICMP error in the middle
+		 * of a burst, receive a packet on another RX queue from it.
+		 */
+		if (gro_send_trigger) {
+			gro_send_trigger = false;
+			gro_queue_ip(&gro_other_addr, NET_PRIORITY_NC);
+		}
+		return;
+	case T_CLOSING:
+		/* The test checks the data passed to the application */
+		return;
+	default:
+		zassert_true(false, "%s: unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+static void test_gro_recv_cb(struct net_context *context,
+			     struct net_pkt *pkt,
+			     union net_ip_header *ip_hdr,
+			     union net_proto_header *proto_hdr,
+			     int status,
+			     void *user_data)
+{
+	if (!pkt) {
+		return;
+	}
+
+	if (gro_rx_count < ARRAY_SIZE(gro_rx_len)) {
+		gro_rx_len[gro_rx_count] = net_pkt_remaining_data(pkt);
+	}
+
+	gro_rx_count++;
+
+	net_pkt_unref(pkt);
+}
+
+/* Queue a segment without letting the RX thread run, so that segments
+ * queued one after another are received in one burst.
+ */
+static void gro_queue_data(uint32_t data_seq, uint8_t flags)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = data_seq;
+
+	pkt = tester_prepare_tcp_pkt(AF_INET, htons(MY_PORT),
+				     htons(PEER_PORT), flags,
+				     (const uint8_t *)lorem_ipsum, GRO_SEG_LEN);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+}
+
+/* TCP packet without ports, to an address that is not ours it is
+ * dropped by IPv4, to ours it gets an ICMP port unreachable error.
+ */
+static void gro_queue_ip(const struct in_addr *dst, enum net_priority prio)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct tcphdr),
+					AF_INET, IPPROTO_TCP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	net_pkt_set_priority(pkt, prio);
+
+	ret = net_ipv4_create(pkt, &peer_addr, dst);
+	zassert_equal(ret, 0, "Cannot create IPv4 header");
+
+	ret = net_pkt_memset(pkt, 0, sizeof(struct tcphdr));
+	zassert_equal(ret, 0, "Cannot write pkt");
+
+	net_pkt_cursor_init(pkt);
+
+	ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	zassert_equal(ret, 0, "Cannot finalize pkt");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+}
+
+static void gro_check(struct tcp *conn, uint32_t expected_ack,
+		      const size_t *lens, int count, int line)
+{
+	int i;
+
+	/* Let the RX thread process the burst */
+	k_msleep(50);
+
+	zassert_equal(gro_rx_count, count, "%d deliveries, expected %d "
+		      "(line %d)", gro_rx_count, count, line);
+
+	for (i = 0; i < count; i++) {
+		zassert_equal(gro_rx_len[i], lens[i],
+			      "Delivery %d of %zu bytes, expected %zu "
+			      "(line %d)", i, gro_rx_len[i], lens[i], line);
+	}
+
+	zassert_equal(conn->ack, expected_ack, "ACK %u, expected %u "
+		      "(line %d)", conn->ack, expected_ack, line);
+
+	gro_rx_count = 0;
+}
+
+/* Test case scenario IPv4
+ *   establish a connection,
+ *   send three in-order segments in one burst,
+ *   expect them to reach the application as one packet,
+ *   send a burst where the second segment has PSH set,
+ *   expect the merge to end at the PSH segment,
+ *   send a burst with a hole after the first segment,
+ *   expect the hole to end the merge,
+ *   send a segment followed by more packets than NET_TCP_GRO_BURST,
+ *   expect the segment to be flushed before the next one arrives,
+ *   send a burst during which another RX queue receives and drains,
+ *   expect that queue to leave the held segment to its own queue.
+ *   any failures cause test case to fail.
+ */
+static void test_server_gro_ipv4(void)
+{
+	const size_t merged[] = { 3 * GRO_SEG_LEN };
+	const size_t pushed[] = { 2 * GRO_SEG_LEN, GRO_SEG_LEN };
+	const size_t hole[] = { GRO_SEG_LEN, 2 * GRO_SEG_LEN };
+	const size_t flushed[] = { GRO_SEG_LEN, GRO_SEG_LEN };
+	const size_t owned[] = { 2 * GRO_SEG_LEN };
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint32_t base;
+	int ret, i;
+
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+		return;
+	}
+
+	t_state = T_SYN;
+	test_case_no = 13;
+	seq = ack = 0;
+	gro_rx_count = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	accepted_ctx->recv_cb = test_gro_recv_cb;
+	conn = accepted_ctx->tcp;
+	base = seq;
+
+	gro_queue_data(base, ACK);
+	gro_queue_data(base + GRO_SEG_LEN, ACK);
+	gro_queue_data(base + 2 * GRO_SEG_LEN, ACK);
+	gro_check(conn, base + 3 * GRO_SEG_LEN, merged, 1, __LINE__);
+	base += 3 * GRO_SEG_LEN;
+
+	gro_queue_data(base, ACK);
+	gro_queue_data(base + GRO_SEG_LEN, PSH | ACK);
+	gro_queue_data(base + 2 * GRO_SEG_LEN, ACK);
+	gro_check(conn, base + 3 * GRO_SEG_LEN, pushed, 2, __LINE__);
+	base += 3 * GRO_SEG_LEN;
+
+	/* The segment after the hole is queued as out-of-order data and
+	 * passed on when the hole is filled.
+	 */
+	gro_queue_data(base, ACK);
+	gro_queue_data(base + 2 * GRO_SEG_LEN, ACK);
+	k_msleep(50);
+	gro_queue_data(base + GRO_SEG_LEN, ACK);
+	gro_check(conn, base + 3 * GRO_SEG_LEN, hole, 2, __LINE__);
+	base += 3 * GRO_SEG_LEN;
+
+	/* The held segment must not wait for the RX queue to drain,
+	 * otherwise it would be merged with the last one.
+	 */
+	gro_queue_data(base, ACK);
+	for (i = 0; i < CONFIG_NET_TCP_GRO_BURST; i++) {
+		gro_queue_ip(&gro_other_addr, NET_PRIORITY_BE);
+	}
+	gro_queue_data(base + GRO_SEG_LEN, ACK);
+	gro_check(conn, base + 2 * GRO_SEG_LEN, flushed, 2, __LINE__);
+	base += 2 * GRO_SEG_LEN;
+
+	/* The ICMP error for the packet to our address is sent from the
+	 * RX thread holding the first segment.  With more than one RX
+	 * queue the packet queued from there is received on another
+	 * one, whose thread preempts this one if it is preemptive and
+	 * drains its queue.  The held segment must stay with its queue
+	 * and be merged with the second one.
+	 */
+	gro_send_trigger = true;
+	gro_queue_data(base, ACK);
+	gro_queue_ip(&my_addr, NET_PRIORITY_BE);
+	gro_queue_data(base + GRO_SEG_LEN, ACK);
+	gro_check(conn, base + 2 * GRO_SEG_LEN, owned, 1, __LINE__);
+	zassert_false(gro_send_trigger, "No ICMP error was sent");
+	base += 2 * GRO_SEG_LEN;
+
+	t_state = T_CLOSING;
+	seq = base;
+
+	ret = net_recv_data(iface, prepare_rst_packet(AF_INET, htons(MY_PORT),
+						      htons(PEER_PORT)));
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+}
+#else
+static void handle_server_gro_test(struct tcphdr *th)
+{
+	ARG_UNUSED(th);
+}
+
+static void test_server_gro_ipv4(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+#define DACK_SEG_LEN 100
+
+static int dack_count;
+static uint32_t dack_last;
+
+static void handle_server_delayed_ack_test(struct tcphdr *th)
+{
+	struct net_pkt *reply;
+	int ret;
+
+	switch (t_state) {
+	case T_SYN:
+		reply = prepare_syn_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT));
+		t_state = T_SYN_ACK;
+		break;
+	case T_SYN_ACK:
+		test_verify_flags(th, SYN | ACK);
+		seq++;
+		ack = ntohl(th->th_seq) + 1U;
+		reply = prepare_ack_packet(AF_INET, htons(MY_PORT),
+					   htons(PEER_PORT));
+		t_state = T_DATA;
+		break;
+	case T_DATA:
+		/* The test counts the ACKs for the data it sends */
+		test_verify_flags(th, ACK);
+		dack_last = ntohl(th->th_ack);
+		dack_count++;
+		return;
+	case T_CLOSING:
+		return;
+	default:
+		zassert_true(false, "%s: unexpected state", __func__);
+		return;
+	}
+
+	ret = net_recv_data(iface, reply);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return;
+fail:
+	zassert_true(false, "%s failed", __func__);
+}
+
+static void dack_send(uint32_t data_seq)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	seq = data_seq;
+
+	pkt = prepare_data_packet(AF_INET, htons(MY_PORT), htons(PEER_PORT),
+				  (const uint8_t *)lorem_ipsum, DACK_SEG_LEN);
+	zassert_not_null(pkt, "Cannot create pkt");
+
+	ret = net_recv_data(iface, pkt);
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+}
+
+static void dack_check(int count, uint32_t expected_ack, int line)
+{
+	zassert_equal(dack_count, count, "%d ACKs, expected %d (line %d)",
+		      dack_count, count, line);
+
+	if (count) {
+		zassert_equal(dack_last, expected_ack,
+			      "ACK %u, expected %u (line %d)", dack_last,
+			      expected_ack, line);
+	}
+
+	dack_count = 0;
+}
+
+/* Test case scenario IPv4
+ *   establish a connection where the MSS we announce is DACK_SEG_LEN
+ *   and the peer announces none, so it takes a larger one for itself,
+ *   send a full sized segment,
+ *   expect no ACK before the delayed ACK timeout,
+ *   send a second one,
+ *   expect one ACK for both right away,
+ *   send a single segment,
+ *   expect its ACK only after the delayed ACK timeout,
+ *   send a segment after a hole,
+ *   expect a duplicate ACK right away,
+ *   send the segment filling the hole,
+ *   expect an ACK for all of it right away.
+ *   any failures cause test case to fail.
+ */
+static void test_server_delayed_ack_ipv4(void)
+{
+	struct net_context *ctx;
+	uint16_t mtu;
+	uint32_t base;
+	int ret;
+
+	if (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT == 0) {
+		ztest_test_skip();
+		return;
+	}
+
+	/* The MSS we announce is derived from the MTU */
+	mtu = net_if_get_mtu(iface);
+	net_if_set_mtu(iface, DACK_SEG_LEN + NET_IPV4TCPH_LEN);
+
+	t_state = T_SYN;
+	test_case_no = 14;
+	seq = ack = 0;
+	dack_count = 0;
+
+	ret = net_context_get(AF_INET, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Failed to get net_context");
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_s,
+			       sizeof(struct sockaddr_in));
+	zassert_equal(ret, 0, "Failed to bind net_context");
+
+	ret = net_context_listen(ctx, 1);
+	zassert_equal(ret, 0, "Failed to listen on net_context");
+
+	/* Trigger the peer to send SYN */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	zassert_equal(ret, 0, "Failed to set accept on net_context");
+
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	/* Full sized is what we receive, not what the peer may */
+	zassert_true(conn_mss((struct tcp *)accepted_ctx->tcp) >
+		     DACK_SEG_LEN, "Peer MSS not larger than ours");
+
+	base = seq;
+
+	/* Every second full sized segment is acknowledged right away */
+	dack_send(base);
+	k_msleep(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT / 4);
+	dack_check(0, 0, __LINE__);
+
+	dack_send(base + DACK_SEG_LEN);
+	k_msleep(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT / 4);
+	dack_check(1, base + 2 * DACK_SEG_LEN, __LINE__);
+	base += 2 * DACK_SEG_LEN;
+
+	/* A single segment waits for the timeout */
+	dack_send(base);
+	k_msleep(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT / 4);
+	dack_check(0, 0, __LINE__);
+
+	k_msleep(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT + 20);
+	dack_check(1, base + DACK_SEG_LEN, __LINE__);
+	base += DACK_SEG_LEN;
+
+	/* Out-of-order data and the data filling the hole are both
+	 * acknowledged right away.
+	 */
+	dack_send(base + DACK_SEG_LEN);
+	k_msleep(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT / 4);
+	dack_check(1, base, __LINE__);
+
+	dack_send(base);
+	k_msleep(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT / 4);
+	dack_check(1, base + 2 * DACK_SEG_LEN, __LINE__);
+	base += 2 * DACK_SEG_LEN;
+
+	t_state = T_CLOSING;
+	seq = base;
+
+	ret = net_recv_data(iface, prepare_rst_packet(AF_INET, htons(MY_PORT),
+						      htons(PEER_PORT)));
+	zassert_equal(ret, 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	net_context_put(ctx);
+	net_if_set_mtu(iface, mtu);
+}
+#else
+static void handle_server_delayed_ack_test(struct tcphdr *th)
+{
+	ARG_UNUSED(th);
+}
+
+static void test_server_delayed_ack_ipv4(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_TCP_DELAYED_ACK */
+
+static struct net_context *create_server_socket(uint32_t my_seq,
+						uint32_t my_ack)
+{
+	struct net_context *ctx;
+	int ret;
+
+	t_state = T_SYN;
+	test_case_no = 5;
+	seq = my_seq;
+	ack = my_ack;
+
+	ret = net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	if (ret < 0) {
+		zassert_true(false, "Failed to get net_context");
+	}
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&my_addr_v6_s,
+			       sizeof(struct sockaddr_in6));
+	if (ret < 0) {
+		zassert_true(false, "Failed to bind net_context");
+	}
+
+	ret = net_context_listen(ctx, 1);
+	if (ret < 0) {
+		zassert_true(false, "Failed to listen on net_context");
+	}
+
+	/* Trigger the peer to send SYN  */
+	k_work_reschedule(&test_server, K_NO_WAIT);
+
+	ret = net_context_accept(ctx, test_tcp_accept_cb, K_FOREVER, NULL);
+	if (ret < 0) {
+		zassert_true(false, "Failed to set accept on net_context");
+	}
+
+	/* test_tcp_accept_cb will release the semaphone after succesfull
+	 * connection.
+	 */
+	test_sem_take(K_MSEC(100), __LINE__);
+
+	return ctx;
+}
+
+static void check_rst_fail(uint32_t seq_value)
+{
+	struct net_pkt *reply;
+	int rsterr_before, rsterr_after;
+	int ret;
+
+	rsterr_before = GET_STAT(iface, tcp.rsterr);
+
+	/* Invalid seq in the RST packet */
+	seq = seq_value;
+
+	reply = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	ret = net_recv_data(iface, reply);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	rsterr_after = GET_STAT(iface, tcp.rsterr);
+
+	zassert_equal(rsterr_before + 1, rsterr_after,
+		      "RST packet not skipped (before %d, after %d)",
+		      rsterr_before, rsterr_after);
+}
+
+static void check_rst_succeed(struct net_context *ctx,
+			      uint32_t seq_value)
+{
+	struct net_pkt *reply;
+	int rsterr_before, rsterr_after;
+	int ret;
+
+	/* Make sure that various other corner cases work */
+	if (ctx == NULL) {
+		ctx = create_server_socket(0, 0);
+	}
+
+	/* Another valid seq in the RST packet */
+	seq = ack + seq_value;
+
+	reply = prepare_rst_packet(AF_INET6, htons(MY_PORT), htons(PEER_PORT));
+
+	rsterr_before = GET_STAT(iface, tcp.rsterr);
+
+	ret = net_recv_data(iface, reply);
+	zassert_true(ret == 0, "recv data failed (%d)", ret);
+
+	/* Let the receiving thread run */
+	k_msleep(50);
+
+	rsterr_after = GET_STAT(iface, tcp.rsterr);
+
+	zassert_equal(rsterr_before, rsterr_after,
+		      "RST packet skipped (before %d, after %d)",
+		      rsterr_before, rsterr_after);
+
+	net_tcp_put(ctx);
+}
+
+static void test_client_invalid_rst(void)
+{
+	struct net_context *ctx;
+	struct tcp *conn;
+	uint16_t wnd;
+
+	ctx = create_server_socket(0, 0);
+
+	conn = ctx->tcp;
+	/* The peer does not offer window scaling in this test */
+	wnd = MIN(conn->recv_win, UINT16_MAX);
+
+	/* Failure cases, the RST packets should be dropped */
+	check_rst_fail(ack - 1);
+	check_rst_fail(ack + wnd);
+
+	/* Then send a valid seq in the RST packet */
+	check_rst_succeed(ctx, wnd - 1);
+	check_rst_succeed(NULL, 0);
+	check_rst_succeed(NULL, 1);
+
+	net_tcp_put(ctx);
+}
+
+#define MAX_DATA 100
+static uint32_t expected_ack = MAX_DATA + 1 - 15;
+static struct net_context *ooo_ctx;
+
+static void handle_server_recv_out_of_order(struct net_pkt *pkt)
+{
+	struct tcphdr th;
+	int ret;
+
+	ret = read_tcp_header(pkt, &th);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	/* Verify that we received all the queued data */
+	zassert_equal(expected_ack, ntohl(th.th_ack),
+		      "Not all pending data received. "
+		      "Expected ACK %u but got %u",
+		      expected_ack, ntohl(th.th_ack));
+
+	test_sem_give();
+
+	return;
+
+fail:
+	zassert_true(false, "%s failed", __func__);
+	net_pkt_unref(pkt);
 }
 
 static void test_server_recv_out_of_order_data(void)
@@ -1484,22 +2686,41 @@ static void test_server_timeout_out_of_order_data(void)
 	net_tcp_put(ooo_ctx);
 }
 
+#if defined(CONFIG_NET_TCP_DELAYED_ACK)
+/* The other test cases expect an ACK for every data segment */
+static void skip_with_delayed_ack(void)
+{
+	ztest_test_skip();
+}
+
+#define tcp_unit_test(fn) \
+	ztest_unit_test_setup_teardown(fn, skip_with_delayed_ack, \
+				       unit_test_noop)
+#else
+#define tcp_unit_test(fn) ztest_unit_test(fn)
+#endif
+
 /** Test case main entry */
 void test_main(void)
 {
 	ztest_test_suite(test_tcp_fn,
 			 ztest_unit_test(test_presetup),
-			 ztest_unit_test(test_client_ipv4),
-			 ztest_unit_test(test_client_ipv6),
-			 ztest_unit_test(test_server_ipv4),
-			 ztest_unit_test(test_server_with_options_ipv4),
-			 ztest_unit_test(test_server_ipv6),
-			 ztest_unit_test(test_client_syn_resend),
-			 ztest_unit_test(test_client_fin_wait_2_ipv4),
-			 ztest_unit_test(test_client_closing_ipv6),
-			 ztest_unit_test(test_client_invalid_rst),
-			 ztest_unit_test(test_server_recv_out_of_order_data),
-			 ztest_unit_test(test_server_timeout_out_of_order_data)
+			 tcp_unit_test(test_client_ipv4),
+			 tcp_unit_test(test_client_ipv6),
+			 tcp_unit_test(test_server_ipv4),
+			 tcp_unit_test(test_server_with_options_ipv4),
+			 tcp_unit_test(test_server_ipv6),
+			 tcp_unit_test(test_client_syn_resend),
+			 tcp_unit_test(test_client_fin_wait_2_ipv4),
+			 tcp_unit_test(test_client_closing_ipv6),
+			 tcp_unit_test(test_client_fast_retransmit),
+			 tcp_unit_test(test_server_wscale_sack_ipv4),
+			 tcp_unit_test(test_client_sack_retransmit),
+			 tcp_unit_test(test_server_gro_ipv4),
+			 ztest_unit_test(test_server_delayed_ack_ipv4),
+			 tcp_unit_test(test_client_invalid_rst),
+			 tcp_unit_test(test_server_recv_out_of_order_data),
+			 tcp_unit_test(test_server_timeout_out_of_order_data)
 			 );
 
 	ztest_run_test_suite(test_tcp_fn);
@@ -0,0 +1,366 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+#include <linker/sections.h>
+#include <random/rand32.h>
+
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+#define MY_PORT 4242
+#define PEER_PORT 4343
+
+/* Smaller than the packets, so IPv4 would fragment them without GSO */
+#define IFACE_MTU 576
+
+#define TEST_MSS 400
+#define TEST_SEQ 0xfffffe00U
+#define TEST_ACK 0x12345678U
+
+#define WAIT_TIME K_SECONDS(1)
+
+#define ALLOC_TIMEOUT K_MSEC(500)
+
+struct net_if_test {
+	uint8_t mac_addr[sizeof(struct net_eth_addr)];
+};
+
+static struct net_if *iface1;
+
+static bool test_started;
+static bool test_failed;
+static struct k_sem wait_data;
+
+static int seg_count;
+static uint16_t seg_next_offset;
+
+static uint8_t payload[1500];
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static uint8_t *net_iface_get_mac(const struct device *dev)
+{
+	struct net_if_test *data = dev->data;
+
+	if (data->mac_addr[2] == 0x00) {
+		/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+		data->mac_addr[0] = 0x00;
+		data->mac_addr[1] = 0x00;
+		data->mac_addr[2] = 0x5E;
+		data->mac_addr[3] = 0x00;
+		data->mac_addr[4] = 0x53;
+		data->mac_addr[5] = sys_rand32_get();
+	}
+
+	return data->mac_addr;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	uint8_t *mac = net_iface_get_mac(net_if_get_device(iface));
+
+	net_if_set_link_addr(iface, mac, sizeof(struct net_eth_addr),
+			     NET_LINK_ETHERNET);
+}
+
+static int verify_ip_header(struct net_pkt *pkt)
+{
+	if (net_pkt_family(pkt) == AF_INET) {
+		struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+
+		if (ntohs(hdr->len) != net_pkt_get_len(pkt)) {
+			NET_DBG("Invalid IPv4 length %d", ntohs(hdr->len));
+			return -EINVAL;
+		}
+
+		if (net_calc_chksum_ipv4(pkt) != 0U) {
+			NET_DBG("Invalid IPv4 header checksum");
+			return -EINVAL;
+		}
+	} else {
+		struct net_ipv6_hdr *hdr = NET_IPV6_HDR(pkt);
+
+		if (ntohs(hdr->len) != net_pkt_get_len(pkt) - NET_IPV6H_LEN) {
+			NET_DBG("Invalid IPv6 length %d", ntohs(hdr->len));
+			return -EINVAL;
+		}
+	}
+
+	if (net_pkt_get_len(pkt) > IFACE_MTU &&
+	    net_pkt_family(pkt) == AF_INET) {
+		NET_DBG("Segment does not fit the MTU");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int verify_segment(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	uint8_t data[TEST_MSS];
+	struct net_tcp_hdr *tcp_hdr;
+	size_t len;
+	bool last;
+
+	seg_count++;
+
+	if (verify_ip_header(pkt) < 0) {
+		return -EINVAL;
+	}
+
+	if (net_calc_chksum_tcp(pkt) != 0U) {
+		NET_DBG("Invalid TCP checksum");
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			 net_pkt_ip_opts_len(pkt))) {
+		return -EINVAL;
+	}
+
+	tcp_hdr = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!tcp_hdr) {
+		return -EINVAL;
+	}
+
+	net_pkt_acknowledge_data(pkt, &tcp_access);
+
+	len = net_pkt_remaining_data(pkt);
+	last = seg_next_offset + len == sizeof(payload);
+
+	NET_DBG("segment %d seq 0x%08x flags 0x%02x len %zd", seg_count,
+		sys_get_be32(tcp_hdr->seq), tcp_hdr->flags, len);
+
+	if (len > TEST_MSS || len == 0) {
+		NET_DBG("Invalid segment length %zd", len);
+		return -EINVAL;
+	}
+
+	if (sys_get_be32(tcp_hdr->seq) != TEST_SEQ + seg_next_offset ||
+	    sys_get_be32(tcp_hdr->ack) != TEST_ACK) {
+		NET_DBG("Invalid seq or ack");
+		return -EINVAL;
+	}
+
+	/* Only the last segment carries PSH and FIN */
+	if (tcp_hdr->flags != (last ? (ACK | PSH | FIN) : ACK)) {
+		NET_DBG("Invalid flags 0x%02x", tcp_hdr->flags);
+		return -EINVAL;
+	}
+
+	if (net_pkt_read(pkt, data, len) ||
+	    memcmp(data, payload + seg_next_offset, len)) {
+		NET_DBG("Invalid data at offset %d", seg_next_offset);
+		return -EINVAL;
+	}
+
+	seg_next_offset += len;
+
+	return 0;
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	if (!pkt->buffer) {
+		NET_DBG("No data to send!");
+		return -ENODATA;
+	}
+
+	if (!test_started) {
+		return 0;
+	}
+
+	if (verify_segment(pkt) < 0) {
+		test_failed = true;
+	} else {
+		k_sem_give(&wait_data);
+	}
+
+	return 0;
+}
+
+struct net_if_test net_iface1_data;
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+#define _ETH_L2_LAYER DUMMY_L2
+#define _ETH_L2_CTX_TYPE NET_L2_GET_CTX_TYPE(DUMMY_L2)
+
+NET_DEVICE_INIT_INSTANCE(net_iface1_test,
+			 "iface1",
+			 iface1,
+			 net_iface_dev_init,
+			 NULL,
+			 &net_iface1_data,
+			 NULL,
+			 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+			 &net_iface_api,
+			 _ETH_L2_LAYER,
+			 _ETH_L2_CTX_TYPE,
+			 IFACE_MTU);
+
+static void test_setup(void)
+{
+	struct net_if_addr *ifaddr;
+	int i;
+
+	k_sem_init(&wait_data, 0, UINT_MAX);
+
+	iface1 = net_if_get_by_index(1);
+	zassert_not_null(iface1, "Interface 1");
+
+	ifaddr = net_if_ipv4_addr_add(iface1, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	ifaddr = net_if_ipv6_addr_add(iface1, &my_addr6, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv6 address");
+
+	net_if_up(iface1);
+
+	for (i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+}
+
+/* Build one large TCP packet like tcp_send_data() does when GSO is on */
+static struct net_pkt *build_tcp_pkt(sa_family_t family)
+{
+	struct net_tcp_hdr tcp_hdr = { 0 };
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, sizeof(payload), family,
+					IPPROTO_TCP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "packet");
+
+	if (family == AF_INET) {
+		ret = net_ipv4_create(pkt, &my_addr, &peer_addr);
+	} else {
+		ret = net_ipv6_create(pkt, &my_addr6, &peer_addr6);
+	}
+
+	zassert_equal(ret, 0, "Cannot create IP header");
+
+	tcp_hdr.src_port = htons(MY_PORT);
+	tcp_hdr.dst_port = htons(PEER_PORT);
+	sys_put_be32(TEST_SEQ, tcp_hdr.seq);
+	sys_put_be32(TEST_ACK, tcp_hdr.ack);
+	tcp_hdr.offset = 5U << 4;
+	tcp_hdr.flags = ACK | PSH | FIN;
+	sys_put_be16(1000U, tcp_hdr.wnd);
+
+	ret = net_pkt_write(pkt, &tcp_hdr, sizeof(tcp_hdr));
+	zassert_equal(ret, 0, "Cannot append TCP header");
+
+	ret = net_pkt_write(pkt, payload, sizeof(payload));
+	zassert_equal(ret, 0, "Cannot append data");
+
+	net_pkt_set_gso_size(pkt, TEST_MSS);
+
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET) {
+		ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	} else {
+		ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+
+	zassert_equal(ret, 0, "Cannot finalize packet");
+
+	return pkt;
+}
+
+static void send_and_verify(sa_family_t family)
+{
+	int expected = DIV_ROUND_UP(sizeof(payload), TEST_MSS);
+	struct net_pkt *pkt;
+	int i, ret;
+
+	test_failed = false;
+	seg_count = 0;
+	seg_next_offset = 0U;
+
+	pkt = build_tcp_pkt(family);
+
+	test_started = true;
+
+	ret = net_send_data(pkt);
+	zassert_equal(ret, 0, "Cannot send test packet (%d)", ret);
+
+	for (i = 0; i < expected; i++) {
+		zassert_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+			      "Timeout while waiting segment %d", i);
+	}
+
+	test_started = false;
+
+	zassert_false(test_failed, "Segment verify failed");
+	zassert_equal(seg_count, expected, "Sent %d segments, expected %d",
+		      seg_count, expected);
+	zassert_equal(seg_next_offset, sizeof(payload),
+		      "Sent %d bytes, expected %zd", seg_next_offset,
+		      sizeof(payload));
+}
+
+static void test_gso_ipv4(void)
+{
+	send_and_verify(AF_INET);
+}
+
+static void test_gso_ipv6(void)
+{
+	send_and_verify(AF_INET6);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_tcp_gso_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_gso_ipv4),
+			 ztest_unit_test(test_gso_ipv6));
+
+	ztest_run_test_suite(net_tcp_gso_test);
+}
@@ -646,6 +646,23 @@ void test_udp(void)
 	TEST_IPV6_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 	TEST_IPV6_LONG_OK(ud, &in6addr_peer, &in6addr_my, 12345, 42421);
 
+	/* Handlers whose ports share a hash bucket must not be mixed up */
+	{
+		struct ud *ud_a, *ud_b;
+
+		ud_a = REGISTER(AF_INET, &any_addr4, &any_addr4, 1234, 5000);
+		ud_b = REGISTER(AF_INET, &any_addr4, &any_addr4, 1234,
+				5000 + CONFIG_NET_CONN_HASH_SIZE);
+		TEST_IPV4_OK(ud_a, &in4addr_peer, &in4addr_my, 1234, 5000);
+		TEST_IPV4_OK(ud_b, &in4addr_peer, &in4addr_my, 1234,
+			     5000 + CONFIG_NET_CONN_HASH_SIZE);
+		TEST_IPV4_OK(ud_a, &in4addr_peer, &in4addr_my, 1234, 5000);
+		UNREGISTER(ud_b);
+		TEST_IPV4_OK(ud, &in4addr_peer, &in4addr_my, 12345,
+			     5000 + CONFIG_NET_CONN_HASH_SIZE);
+		UNREGISTER(ud_a);
+	}
+
 	/* Remote addr same as local addr, these two will never match */
 	REGISTER(AF_INET6, &my_addr6, NULL, 1234, 4242);
 	REGISTER(AF_INET, &my_addr4, NULL, 1234, 4242);
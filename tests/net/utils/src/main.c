@@ -848,11 +848,130 @@ void test_addr_parse(void)
 #endif
 }
 
+/* Straightforward one's complement sum of 16-bit big endian words */
+static uint16_t ref_chksum(const uint8_t *data, size_t len)
+{
+	uint32_t sum = 0U;
+	size_t i;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		sum += (data[i] << 8) + data[i + 1];
+	}
+
+	if (i < len) {
+		sum += data[i] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+/* 0x0000 and 0xffff are both a zero in one's complement */
+static bool chksum_equal(uint16_t a, uint16_t b)
+{
+	return a == b || (a % 0xffff) == (b % 0xffff);
+}
+
+static uint8_t chksum_buf[512 + 8] __aligned(8);
+
+void test_chksum_data(void)
+{
+	size_t offset, len;
+	int i;
+
+	for (i = 0; i < sizeof(chksum_buf); i++) {
+		chksum_buf[i] = i * 7 + 3;
+	}
+
+	/* Every alignment and the lengths around the unrolled loop */
+	for (offset = 0; offset < 8; offset++) {
+		for (len = 0; len <= 512; len++) {
+			uint16_t ref = ref_chksum(chksum_buf + offset, len);
+			uint16_t sum = net_calc_chksum_data(
+				0U, chksum_buf + offset, len);
+
+			zassert_true(chksum_equal(sum, ref),
+				     "offset %zd len %zd sum 0x%04x ref 0x%04x",
+				     offset, len, sum, ref);
+		}
+	}
+
+	/* Carries of an all ones buffer */
+	memset(chksum_buf, 0xff, sizeof(chksum_buf));
+
+	zassert_true(chksum_equal(net_calc_chksum_data(0U, chksum_buf, 512),
+				  ref_chksum(chksum_buf, 512)),
+		     "all ones");
+
+	/* A sum carried over from a previous part of the data */
+	for (i = 0; i < sizeof(chksum_buf); i++) {
+		chksum_buf[i] = i;
+	}
+
+	zassert_true(chksum_equal(
+			     net_calc_chksum_data(
+				     net_calc_chksum_data(0U, chksum_buf, 100),
+				     chksum_buf + 100, 412),
+			     ref_chksum(chksum_buf, 512)),
+		     "split sum");
+}
+
+void test_chksum_update(void)
+{
+	uint8_t hdr[40];
+	uint16_t chksum, old16, new16;
+	uint32_t old32, new32;
+	uint8_t old_addr[16];
+	int i;
+
+	for (i = 0; i < sizeof(hdr); i++) {
+		hdr[i] = i * 13 + 1;
+	}
+
+	chksum = htons(~ref_chksum(hdr, sizeof(hdr)));
+
+	/* Like a TTL or a port rewrite */
+	old16 = UNALIGNED_GET((uint16_t *)&hdr[8]);
+	new16 = htons(0x4000);
+	UNALIGNED_PUT(new16, (uint16_t *)&hdr[8]);
+
+	chksum = net_chksum_update_16(chksum, old16, new16);
+	zassert_true(chksum_equal(chksum, htons(~ref_chksum(hdr,
+							      sizeof(hdr)))),
+		     "16-bit update");
+
+	/* Like a sequence number or an IPv4 address rewrite */
+	old32 = UNALIGNED_GET((uint32_t *)&hdr[12]);
+	new32 = htonl(0xc0000201);
+	UNALIGNED_PUT(new32, (uint32_t *)&hdr[12]);
+
+	chksum = net_chksum_update_32(chksum, old32, new32);
+	zassert_true(chksum_equal(chksum, htons(~ref_chksum(hdr,
+							      sizeof(hdr)))),
+		     "32-bit update");
+
+	/* Like an IPv6 address in the pseudo header */
+	memcpy(old_addr, &hdr[24], sizeof(old_addr));
+	memset(&hdr[24], 0, sizeof(old_addr));
+	hdr[39] = 1U;
+
+	chksum = net_chksum_update(chksum, old_addr, &hdr[24],
+				   sizeof(old_addr));
+	zassert_true(chksum_equal(chksum, htons(~ref_chksum(hdr,
+							      sizeof(hdr)))),
+		     "address update");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum_data),
+			 ztest_unit_test(test_chksum_update));
 
 	ztest_run_test_suite(test_utils_fn);
 }